@@ -4,12 +4,29 @@
 #include "Charts/XVBarChart.h"
 
 #include "Charts/XVChartAxis.h"
+#include "Components/InstancedStaticMeshComponent.h"
 #include "Components/TextRenderComponent.h"
+#include "Engine/StaticMesh.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetTextLibrary.h"
 #include "Rendering/XRVisBoxGeometryGenerator.h"
 #include "Rendering/XRVisGeometryTypes.h"
+#include "Async/ParallelFor.h"
 
+namespace XVBarChartPrivate
+{
+	/* 第一遍确定的一个柱体，第二遍并行生成几何后填入调整后的高度 */
+	struct FBarBuildItem
+	{
+		int32 LODIndex;
+		int32 IndexOfY;
+		int32 IndexOfX;
+		/* 在该级LOD中的序号 */
+		int32 BarIndex;
+		float RawHeight;
+		float AdjustedHeight;
+	};
+}
 
 // Sets default values
 AXVBarChart::AXVBarChart()
@@ -44,6 +61,7 @@ AXVBarChart::AXVBarChart()
 	Colors.Add((FColor::FromHex("#a50026")));
 	
 	XVChartUtils::LoadResourceFromPath(TEXT("Material'/XRVis/Materials/M_BaseVertexColor.M_BaseVertexColor'"), BaseMaterial);
+	XVChartUtils::LoadResourceFromPath(TEXT("StaticMesh'/Engine/BasicShapes/Cube.Cube'"), InstanceMesh);
 	
 	// 初始化统计轴线相关数组
 	StatisticalLineMeshes.Empty();
@@ -77,7 +95,18 @@ void AXVBarChart::BeginPlay()
 	
 	// Z轴自动调整已移至GenerateAllMeshInfo方法中，确保只在数据加载完成后才进行调整
 
-	if (bAutoLoadData && bEnableGPU)
+	// 异步加载时在数据就绪后绘制
+	if (bAutoLoadData && bEnableGPU && !IsLoadingData())
+	{
+		DrawWithGPU();
+	}
+}
+
+void AXVBarChart::OnDataLoadFinished(bool bSuccess)
+{
+	Super::OnDataLoadFinished(bSuccess);
+
+	if (bSuccess && bEnableGPU)
 	{
 		DrawWithGPU();
 	}
@@ -88,6 +117,12 @@ void AXVBarChart::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
+	// 增量更新的柱体每帧统一重建一次
+	if (bHasDirtyCells)
+	{
+		FlushDirtyCells();
+	}
+
 	if(bEnableGPU)
 	{
 		return;
@@ -170,48 +205,60 @@ void AXVBarChart::SetValue(const FString& InValue)
 {
 	if (InValue.IsEmpty())
 		return;
-	XYZs.Empty();
-	HeightValues.Empty();
 	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(InValue);
 
 	TArray<TSharedPtr<FJsonValue>> Value3DJsonValueArray;
-	TotalCountOfValue = 0;
+	FXVChartGridData GridData;
 	if (FJsonSerializer::Deserialize(Reader, Value3DJsonValueArray))
 	{
-		for (const TSharedPtr<FJsonValue>& Value3DJsonValue : Value3DJsonValueArray)
-		{
-			TArray<TSharedPtr<FJsonValue>> Values = Value3DJsonValue->AsArray();
-
-			if (Values.Num() != 3)
-				return;
-			int Y = Values[0]->AsNumber();
-			int X = Values[1]->AsNumber();
-			float V = Values[2]->AsNumber();
-			HeightValues.Add(V);
-			MaxX = FMath::Max(MaxX, X);
-			MinX = FMath::Min(MinX, X);
-			MaxY = FMath::Max(MaxY, Y);
-			MinY = FMath::Min(MinY, Y);
-			MaxZ = FMath::Max(MaxZ, V);
-			MinZ = FMath::Min(MinZ, V);
-
-			if (XYZs.Contains(Y))
-			{
-				XYZs[Y].Add(X, V);
-			}
-			else
-			{
-				TMap<int, float> M;
-				M.Add(X, V);
-				XYZs.Add(Y, M);
-			}
+		if (!ParseGridFromJsonArray(Value3DJsonValueArray, GridData))
+			return;
+	}
+
+	SetValueFromGrid(GridData);
+}
 
-			ColCounts = FMath::Max(ColCounts, XYZs[Y].Num());
-			TotalCountOfValue++;
+void AXVBarChart::SetValueFromGrid(const FXVChartGridData& GridData)
+{
+	Super::SetValueFromGrid(GridData);
+
+	if (GridData.XLabels.Num() > 0)
+	{
+		XTextArrs = GridData.XLabels;
+	}
+	if (GridData.YLabels.Num() > 0)
+	{
+		YTextArrs = GridData.YLabels;
+	}
+
+	HeightValues = GridData.Values;
+	ValueGrid.Build(GridData);
+	// 单元格与柱体的对应关系在生成网格时重建
+	LODSectionIndices.Reset();
+
+	// 网格的行列索引从0开始
+	MinX = 0;
+	MinY = 0;
+	MaxX = ValueGrid.GetNumCols() - 1;
+	MaxY = ValueGrid.GetNumRows() - 1;
+	MinZ = ValueGrid.GetMinValue();
+	MaxZ = ValueGrid.GetMaxValue();
+	RowCounts = ValueGrid.GetNumRows();
+	ColCounts = ValueGrid.GetNumCols();
+	TotalCountOfValue = ValueGrid.Num();
+
+	// 记录每个单元格在HeightValues中的位置，供增量更新使用
+	HeightValueIndices.Init(INDEX_NONE, RowCounts * ColCounts);
+	for (int32 i = 0; i < GridData.Num(); ++i)
+	{
+		if (ValueGrid.Contains(GridData.YIndices[i], GridData.XIndices[i]))
+		{
+			HeightValueIndices[ValueGrid.GetCellIndex(GridData.YIndices[i], GridData.XIndices[i])] = i;
 		}
 	}
+	DirtyCells.Init(false, RowCounts * ColCounts);
+	bHasDirtyCells = false;
 
-	RowCounts = XYZs.Num();
 	DynamicMaterialInstances.Empty();
 	DynamicMaterialInstances.SetNum(TotalCountOfValue + 1);
 	SectionSelectStates.Init(false, TotalCountOfValue);
@@ -233,73 +280,158 @@ void AXVBarChart::GenerateAllMeshInfo()
 	}
 	
 	PrepareMeshSections();
-	// 创建对应柱体
-	size_t ActualSectionInfoCount = 0;
-	for (size_t LODIndex = 0; LODIndex < GenerateLODCount; ++LODIndex)
+	ValuePyramid.Build(ValueGrid, GenerateLODCount);
+	LODSectionIndices.SetNum(GenerateLODCount);
+
+	// 两种渲染方式互斥，切换时清除另一种方式留下的内容
+	const bool bInstanced = IsInstanced();
+	if (bInstanced)
 	{
-		auto& LODInfo = LODInfos[LODIndex];
-		LODInfo.LODOffset = ActualSectionInfoCount;
-		size_t CurrentIndex = 0;
-		for (size_t IndexOfY = 0; IndexOfY < RowCounts; IndexOfY += LODIndex + 1)
+		ClearAllMeshSections();
+		EnsureInstanceComponents();
+	}
+	else
+	{
+		for (UInstancedStaticMeshComponent* InstanceComponent : InstanceComponents)
 		{
-			for (size_t IndexOfX = 0; IndexOfX < XYZs[IndexOfY].Num(); )
-			{
-				FVector Position(XAxisInterval * IndexOfX, YAxisInterval * IndexOfY, 0);
+			InstanceComponent->ClearInstances();
+		}
+	}
 
-				float MergedHeight = 0;
-				for (size_t StepX = 0; StepX <= LODIndex &&  IndexOfX < XYZs[IndexOfY].Num(); ++StepX,++IndexOfX)
-				{
-					for (size_t StepY = 0; StepY <= LODIndex && IndexOfY  + StepY< RowCounts; ++StepY)
-					{
-						MergedHeight += XYZs[IndexOfY + StepY][IndexOfX];
-					}
-				}
-				
+	// 合并网格段模式下每级LOD只有一个网格段，LOD0的顶点按柱体序号指向状态纹理，较粗LOD的合并柱体不参与交互
+	const bool bMerged = !bInstanced && IsMergingSections();
+	if (bMerged)
+	{
+		InitSectionStates(TotalCountOfValue, BaseMaterial);
+		LODVertexStarts.SetNum(GenerateLODCount);
+	}
+	else
+	{
+		ReleaseSectionStates();
+		LODVertexStarts.Empty();
+	}
+	// 第一遍：确定每级LOD生成的柱体及其原始高度，合并高度从求和面积表读取，开销很小
+	TArray<XVBarChartPrivate::FBarBuildItem> Items;
+	TArray<int32> LODItemStarts;
+	LODItemStarts.SetNum(GenerateLODCount + 1);
+	int32 ActualSectionInfoCount = 0;
+	for (int32 LODIndex = 0; LODIndex < GenerateLODCount; ++LODIndex)
+	{
+		LODItemStarts[LODIndex] = Items.Num();
+		const int32 BlockSize = LODIndex + 1;
+		const int32 NumBlockCols = FMath::DivideAndRoundUp(ColCounts, BlockSize);
+		TArray<int32>& SectionIndices = LODSectionIndices[LODIndex];
+		SectionIndices.Init(INDEX_NONE, FMath::DivideAndRoundUp(RowCounts, BlockSize) * NumBlockCols);
+
+		int32 CurrentIndex = 0;
+		for (int32 IndexOfY = 0; IndexOfY < RowCounts; IndexOfY += BlockSize)
+		{
+			for (int32 IndexOfX = 0; IndexOfX < ColCounts; IndexOfX += BlockSize)
+			{
 				// 获取原始高度
-				float RawHeight = MergedHeight / ((LODIndex + 1) * (LODIndex + 1));
-				
-				// 应用Z轴调整
-				float AdjustedHeight = CalculateAdjustedHeight(RawHeight) + 0.1;
-				
-				// 计算原始高度的百分比(相对于最大值)
-				double Percentage = static_cast<double>(RawHeight) / static_cast<double>(MaxZ);
-				int ColorIndex = FMath::Floor(Percentage * (Colors.Num() - 1));
-
-				size_t CreatedSectionIndex = CurrentIndex + ActualSectionInfoCount;
-
-				// TODO: Implement more styles
-				switch (HistogramChartShape)
+				float RawHeight = 0;
+				if (!ComputeMergedHeight(LODIndex, IndexOfY, IndexOfX, RawHeight))
 				{
-				case EHistogramChartShape::Bar:
-					XVChartUtils::CreateBox(SectionInfos, CreatedSectionIndex, Position, Length * (LODIndex + 1), Width * (LODIndex + 1), AdjustedHeight, AdjustedHeight, Colors[ColorIndex]);
-					break;
-				case EHistogramChartShape::Circle:
-					UE_LOG(LogTemp, Warning, TEXT("Circle shaped not implemented!"));
-					break;
-				case EHistogramChartShape::Round:
-					UE_LOG(LogTemp, Warning, TEXT("Round shaped not implemented!"));
-					break;
-				default:
-					UE_LOG(LogTemp, Error, TEXT("Error HistogramChartShape!"));	
-					break;
+					continue;
 				}
 
-				if (LODIndex == 0)
-				{
-					DynamicMaterialInstances[CurrentIndex] = UMaterialInstanceDynamic::Create(BaseMaterial, this);
-					DynamicMaterialInstances[CurrentIndex]->SetVectorParameterValue("EmissiveColor", EmissiveColor);
-				}
-				ProceduralMeshComponent->SetMaterial(CreatedSectionIndex, DynamicMaterialInstances[CurrentIndex]);
-				SectionsHeight[CurrentIndex] = AdjustedHeight;
-				
-				// 使用原始高度值作为标签文本
-				LabelComponents[CurrentIndex] = XVChartUtils::CreateTextRenderComponent(this, FText::FromString(FString::Printf(TEXT("%.2f"), RawHeight)), FColor::Cyan, false);
-			
+				SectionIndices[IndexOfY / BlockSize * NumBlockCols + IndexOfX / BlockSize] = CurrentIndex;
+				Items.Add({LODIndex, IndexOfY, IndexOfX, CurrentIndex, RawHeight, 0});
 				++CurrentIndex;
 			}
 		}
-		ActualSectionInfoCount += CurrentIndex;
-		LODInfo.LODCount = CurrentIndex;
+
+		auto& LODInfo = LODInfos[LODIndex];
+		LODInfo.LODOffset = bMerged ? LODIndex : ActualSectionInfoCount;
+		LODInfo.LODCount = bMerged ? 1 : CurrentIndex;
+		ActualSectionInfoCount += LODInfo.LODCount;
+	}
+	LODItemStarts[GenerateLODCount] = Items.Num();
+	SectionInfos.SetNum(bInstanced ? 0 : ActualSectionInfoCount);
+
+	// 第二遍：并行生成几何，每个柱体只写入自己的网格段、实例数据或临时网格段
+	TArray<FTransform> InstanceTransforms;
+	TArray<float> InstanceCustomData;
+	TArray<FXVChartSectionInfo> BarSections;
+	if (bInstanced)
+	{
+		InstanceTransforms.SetNum(Items.Num());
+		InstanceCustomData.SetNumUninitialized(Items.Num() * XVBarInstanceData::NumFloats);
+	}
+	else if (bMerged)
+	{
+		BarSections.SetNum(Items.Num());
+	}
+
+	ParallelFor(Items.Num(), [&](int32 ItemIndex)
+	{
+		XVBarChartPrivate::FBarBuildItem& Item = Items[ItemIndex];
+		if (bInstanced)
+		{
+			Item.AdjustedHeight = ComputeBarInstance(Item.LODIndex, Item.IndexOfY, Item.IndexOfX, Item.RawHeight, InstanceTransforms[ItemIndex],
+				MakeArrayView(InstanceCustomData.GetData() + ItemIndex * XVBarInstanceData::NumFloats, XVBarInstanceData::NumFloats));
+		}
+		else if (bMerged)
+		{
+			Item.AdjustedHeight = BuildBarSection(BarSections, ItemIndex, Item.LODIndex, Item.IndexOfY, Item.IndexOfX, Item.RawHeight);
+			AssignSectionId(BarSections[ItemIndex], 0, Item.LODIndex == 0 ? Item.BarIndex : TotalCountOfValue);
+		}
+		else
+		{
+			Item.AdjustedHeight = BuildBarSection(SectionInfos, LODInfos[Item.LODIndex].LODOffset + Item.BarIndex, Item.LODIndex,
+				Item.IndexOfY, Item.IndexOfX, Item.RawHeight);
+		}
+	});
+
+	// 第三遍：在游戏线程上处理实例化组件、材质和标签等UObject
+	for (int32 LODIndex = 0; LODIndex < GenerateLODCount; ++LODIndex)
+	{
+		const int32 ItemStart = LODItemStarts[LODIndex];
+		const int32 NumItems = LODItemStarts[LODIndex + 1] - ItemStart;
+		if (bInstanced)
+		{
+			// 每级LOD的实例一次性添加，自定义数据写完后统一刷新渲染状态
+			UInstancedStaticMeshComponent* InstanceComponent = InstanceComponents[LODIndex];
+			InstanceComponent->ClearInstances();
+			InstanceComponent->AddInstances(TArray<FTransform>(InstanceTransforms.GetData() + ItemStart, NumItems), false);
+			for (int32 InstanceIndex = 0; InstanceIndex < NumItems; ++InstanceIndex)
+			{
+				InstanceComponent->SetCustomData(InstanceIndex, MakeArrayView(InstanceCustomData.GetData() + (ItemStart + InstanceIndex) * XVBarInstanceData::NumFloats, XVBarInstanceData::NumFloats));
+			}
+			InstanceComponent->MarkRenderStateDirty();
+		}
+		else if (bMerged)
+		{
+			XVChartUtils::MergeSectionInfos(MakeArrayView(BarSections.GetData() + ItemStart, NumItems), SectionInfos[LODIndex], &LODVertexStarts[LODIndex]);
+			GetSectionMeshComponent()->SetMaterial(LODIndex, MergedSectionMaterialInstance);
+		}
+	}
+
+	// LOD0的柱体与数据单元格一一对应
+	for (const XVBarChartPrivate::FBarBuildItem& Item : Items)
+	{
+		if (Item.LODIndex != 0)
+		{
+			break;
+		}
+		if (!bInstanced && !bMerged)
+		{
+			DynamicMaterialInstances[Item.BarIndex] = UMaterialInstanceDynamic::Create(BaseMaterial, this);
+			DynamicMaterialInstances[Item.BarIndex]->SetVectorParameterValue("EmissiveColor", EmissiveColor);
+		}
+		SectionsHeight[Item.BarIndex] = Item.AdjustedHeight;
+
+		// 使用原始高度值作为标签文本，标签只对应未合并的柱体
+		LabelComponents[Item.BarIndex] = XVChartUtils::CreateTextRenderComponent(this, FText::FromString(FString::Printf(TEXT("%.2f"), Item.RawHeight)), FColor::Cyan, false);
+	}
+
+	// 逐柱体网格段模式下各级LOD的网格段使用同序号柱体的材质实例
+	if (!bInstanced && !bMerged)
+	{
+		for (const XVBarChartPrivate::FBarBuildItem& Item : Items)
+		{
+			GetSectionMeshComponent()->SetMaterial(LODInfos[Item.LODIndex].LODOffset + Item.BarIndex, DynamicMaterialInstances[Item.BarIndex]);
+		}
 	}
 	
 	// 如果启用了参考值高亮，应用高亮效果
@@ -322,6 +454,459 @@ void AXVBarChart::GenerateAllMeshInfo()
 	}
 }
 
+bool AXVBarChart::ComputeMergedHeight(int32 LODIndex, int32 IndexOfY, int32 IndexOfX, float& OutRawHeight) const
+{
+	// 合并 (LODIndex + 1) x (LODIndex + 1) 个单元格，全部缺失时不生成柱体
+	const int32 BlockSize = LODIndex + 1;
+	const int32 ValidCount = ValuePyramid.GetValidCount(IndexOfY, IndexOfX, BlockSize, BlockSize);
+	if (ValidCount == 0)
+	{
+		return false;
+	}
+
+	switch (LODAggregation)
+	{
+	case EBarChartLODAggregation::Max:
+		OutRawHeight = ValuePyramid.GetMax(IndexOfY, IndexOfX, BlockSize, BlockSize);
+		break;
+	case EBarChartLODAggregation::Sum:
+		OutRawHeight = ValuePyramid.GetSum(IndexOfY, IndexOfX, BlockSize, BlockSize);
+		break;
+	default:
+		OutRawHeight = ValuePyramid.GetSum(IndexOfY, IndexOfX, BlockSize, BlockSize) / ValidCount;
+		break;
+	}
+	return true;
+}
+
+float AXVBarChart::BuildBarSection(TArray<FXVChartSectionInfo>& OutSectionInfos, int32 SectionIndex, int32 LODIndex, int32 IndexOfY, int32 IndexOfX, float RawHeight)
+{
+	FVector Position(XAxisInterval * IndexOfX, YAxisInterval * IndexOfY, 0);
+
+	// 应用Z轴调整
+	float AdjustedHeight = CalculateAdjustedHeight(RawHeight) + 0.1;
+	
+	// TODO: Implement more styles
+	switch (HistogramChartShape)
+	{
+	case EHistogramChartShape::Bar:
+		XVChartUtils::CreateBox(OutSectionInfos, SectionIndex, Position, Length * (LODIndex + 1), Width * (LODIndex + 1), AdjustedHeight, AdjustedHeight, GetBarColor(RawHeight));
+		break;
+	case EHistogramChartShape::Circle:
+		UE_LOG(LogTemp, Warning, TEXT("Circle shaped not implemented!"));
+		break;
+	case EHistogramChartShape::Round:
+		UE_LOG(LogTemp, Warning, TEXT("Round shaped not implemented!"));
+		break;
+	default:
+		UE_LOG(LogTemp, Error, TEXT("Error HistogramChartShape!"));	
+		break;
+	}
+
+	return AdjustedHeight;
+}
+
+FColor AXVBarChart::GetBarColor(float RawHeight) const
+{
+	// 计算原始高度的百分比(相对于最大值)
+	// 按和合并的柱体可能超过最大值，颜色下标需要限制在范围内
+	double Percentage = MaxZ > 0 ? FMath::Clamp(static_cast<double>(RawHeight) / static_cast<double>(MaxZ), 0.0, 1.0) : 0.0;
+	int ColorIndex = FMath::Floor(Percentage * (Colors.Num() - 1));
+	return Colors[ColorIndex];
+}
+
+float AXVBarChart::ComputeBarInstance(int32 LODIndex, int32 IndexOfY, int32 IndexOfX, float RawHeight, FTransform& OutTransform, TArrayView<float> OutCustomData) const
+{
+	// 与BuildBarSection生成的立方体占据相同的范围，网格为以原点为中心、边长100的立方体
+	const float AdjustedHeight = CalculateAdjustedHeight(RawHeight) + 0.1;
+	const FVector Size(Length * (LODIndex + 1), Width * (LODIndex + 1), AdjustedHeight);
+	const FVector Position(XAxisInterval * IndexOfX, YAxisInterval * IndexOfY, 0);
+	OutTransform = FTransform(FQuat::Identity, Position + Size * 0.5, Size / 100.0);
+
+	const FLinearColor Color(GetBarColor(RawHeight));
+	OutCustomData[XVBarInstanceData::Height] = AdjustedHeight;
+	OutCustomData[XVBarInstanceData::Color] = Color.R;
+	OutCustomData[XVBarInstanceData::Color + 1] = Color.G;
+	OutCustomData[XVBarInstanceData::Color + 2] = Color.B;
+	OutCustomData[XVBarInstanceData::EmissiveColor] = EmissiveColor.R;
+	OutCustomData[XVBarInstanceData::EmissiveColor + 1] = EmissiveColor.G;
+	OutCustomData[XVBarInstanceData::EmissiveColor + 2] = EmissiveColor.B;
+	OutCustomData[XVBarInstanceData::EmissiveIntensity] = 0;
+	return AdjustedHeight;
+}
+
+void AXVBarChart::EnsureInstanceComponents()
+{
+	for (int32 LODIndex = GenerateLODCount; LODIndex < InstanceComponents.Num(); ++LODIndex)
+	{
+		InstanceComponents[LODIndex]->DestroyComponent();
+	}
+	InstanceComponents.SetNum(GenerateLODCount);
+
+	for (UInstancedStaticMeshComponent*& InstanceComponent : InstanceComponents)
+	{
+		if (!InstanceComponent)
+		{
+			InstanceComponent = NewObject<UInstancedStaticMeshComponent>(this);
+			InstanceComponent->SetupAttachment(RootComponent);
+			InstanceComponent->SetVisibility(false);
+			InstanceComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+			InstanceComponent->RegisterComponent();
+		}
+		InstanceComponent->SetStaticMesh(InstanceMesh);
+		InstanceComponent->SetMaterial(0, InstancedMaterial ? InstancedMaterial : BaseMaterial);
+		InstanceComponent->SetNumCustomDataFloats(XVBarInstanceData::NumFloats);
+	}
+
+	// 新的组件需要按当前LOD重新设置可见性
+	CurrentLOD = -1;
+}
+
+void AXVBarChart::DrawMeshLOD(int LODLevel)
+{
+	if (!IsInstanced())
+	{
+		Super::DrawMeshLOD(LODLevel);
+		return;
+	}
+
+	check(LODLevel < GenerateLODCount);
+	if (CurrentLOD == LODLevel || !InstanceComponents.IsValidIndex(LODLevel))
+	{
+		return;
+	}
+
+	// 切换LOD只切换组件的可见性，隐藏的组件不参与鼠标射线检测
+	CurrentLOD = LODLevel;
+	for (int32 LODIndex = 0; LODIndex < InstanceComponents.Num(); ++LODIndex)
+	{
+		const bool bVisible = LODIndex == CurrentLOD;
+		InstanceComponents[LODIndex]->SetVisibility(bVisible);
+		InstanceComponents[LODIndex]->SetCollisionEnabled(bVisible ? ECollisionEnabled::QueryOnly : ECollisionEnabled::NoCollision);
+	}
+}
+
+void AXVBarChart::SetBarEmissive(int32 Index, const FLinearColor& Color, float Intensity)
+{
+	if (IsInstanced())
+	{
+		UInstancedStaticMeshComponent* InstanceComponent = InstanceComponents[0];
+		InstanceComponent->SetCustomDataValue(Index, XVBarInstanceData::EmissiveColor, Color.R);
+		InstanceComponent->SetCustomDataValue(Index, XVBarInstanceData::EmissiveColor + 1, Color.G);
+		InstanceComponent->SetCustomDataValue(Index, XVBarInstanceData::EmissiveColor + 2, Color.B);
+		InstanceComponent->SetCustomDataValue(Index, XVBarInstanceData::EmissiveIntensity, Intensity, true);
+		return;
+	}
+	if (HasSectionStates())
+	{
+		SetSectionState(Index, Color, Intensity);
+		return;
+	}
+
+	DynamicMaterialInstances[Index]->SetVectorParameterValue("EmissiveColor", Color);
+	DynamicMaterialInstances[Index]->SetScalarParameterValue("EmissiveIntensity", Intensity);
+	UpdateMeshSection(Index);
+}
+
+void AXVBarChart::SetBarEmissiveIntensity(int32 Index, float Intensity)
+{
+	if (IsInstanced())
+	{
+		InstanceComponents[0]->SetCustomDataValue(Index, XVBarInstanceData::EmissiveIntensity, Intensity, true);
+		return;
+	}
+	if (HasSectionStates())
+	{
+		SetSectionStateIntensity(Index, Intensity);
+		return;
+	}
+
+	DynamicMaterialInstances[Index]->SetScalarParameterValue("EmissiveIntensity", Intensity);
+	UpdateMeshSection(Index);
+}
+
+void AXVBarChart::ResetBarEmissive()
+{
+	// 过程网格和合并网格段模式下由基类恢复
+	if (!IsInstanced() || InstanceComponents.IsEmpty())
+	{
+		return;
+	}
+
+	for (int32 Index = 0; Index < InstanceComponents[0]->GetInstanceCount(); ++Index)
+	{
+		SetBarEmissive(Index, EmissiveColor, 0);
+	}
+}
+
+void AXVBarChart::SetEnableReferenceHighlight(bool bEnable)
+{
+	Super::SetEnableReferenceHighlight(bEnable);
+	if (!bEnable)
+	{
+		ResetBarEmissive();
+	}
+}
+
+void AXVBarChart::SetEnableValueTriggers(bool bEnable)
+{
+	Super::SetEnableValueTriggers(bEnable);
+	if (!bEnable)
+	{
+		ResetBarEmissive();
+	}
+}
+
+void AXVBarChart::UpdateValues(TConstArrayView<FXVCellUpdate> Updates)
+{
+	if (Updates.IsEmpty())
+	{
+		return;
+	}
+
+	// 新增单元格、超出网格范围或超出当前最大值时，网格段的布局和颜色都会改变，需要完整重建；负索引的更新被忽略
+	bool bNeedsRebuild = TotalCountOfValue == 0;
+	for (const FXVCellUpdate& Update : Updates)
+	{
+		if (bNeedsRebuild)
+		{
+			break;
+		}
+		bNeedsRebuild = Update.Row >= 0 && Update.Col >= 0 &&
+			(!ValueGrid.Contains(Update.Row, Update.Col) || !ValueGrid.IsValid(Update.Row, Update.Col) || Update.Value > MaxZ);
+	}
+
+	if (bNeedsRebuild)
+	{
+		// 范围内的单元格先写入网格，导出后每个单元格只有一项
+		for (const FXVCellUpdate& Update : Updates)
+		{
+			if (ValueGrid.Contains(Update.Row, Update.Col))
+			{
+				ValueGrid.SetValue(Update.Row, Update.Col, Update.Value);
+			}
+		}
+		FXVChartGridData GridData;
+		ValueGrid.ToGridData(GridData);
+
+		// 范围外的单元格扩大网格，同一单元格的多次更新只保留最后的值
+		TMap<FIntPoint, int32> AddedCells;
+		for (const FXVCellUpdate& Update : Updates)
+		{
+			if (Update.Row < 0 || Update.Col < 0 || ValueGrid.Contains(Update.Row, Update.Col))
+			{
+				continue;
+			}
+			if (const int32* PointIndex = AddedCells.Find(FIntPoint(Update.Col, Update.Row)))
+			{
+				GridData.Values[*PointIndex] = Update.Value;
+			}
+			else
+			{
+				AddedCells.Add(FIntPoint(Update.Col, Update.Row), GridData.Num());
+				GridData.Add(Update.Row, Update.Col, Update.Value);
+			}
+		}
+		RebuildFromGrid(GridData);
+		return;
+	}
+
+	bool bMaxDecreased = false;
+	for (const FXVCellUpdate& Update : Updates)
+	{
+		if (Update.Row < 0 || Update.Col < 0)
+		{
+			continue;
+		}
+		const float OldValue = ValueGrid.Get(Update.Row, Update.Col);
+		bMaxDecreased |= OldValue >= MaxZ && Update.Value < OldValue;
+		UpdateStatistics(OldValue, Update.Value);
+		ValueGrid.SetValue(Update.Row, Update.Col, Update.Value);
+
+		const int32 CellIndex = ValueGrid.GetCellIndex(Update.Row, Update.Col);
+		DirtyCells[CellIndex] = true;
+		if (HeightValueIndices[CellIndex] != INDEX_NONE)
+		{
+			HeightValues[HeightValueIndices[CellIndex]] = Update.Value;
+		}
+	}
+	bHasDirtyCells = true;
+
+	// 最大值所在的单元格变小后重新统计，最大值确实变小时所有柱体的颜色比例都会改变，需要完整重建
+	if (bMaxDecreased)
+	{
+		ValueGrid.RecomputeRange();
+		if (ValueGrid.GetMaxValue() < MaxZ)
+		{
+			FXVChartGridData GridData;
+			ValueGrid.ToGridData(GridData);
+			RebuildFromGrid(GridData);
+		}
+	}
+}
+
+void AXVBarChart::RebuildFromGrid(const FXVChartGridData& GridData)
+{
+	SetValueFromGrid(GridData);
+
+	if (bEnableGPU)
+	{
+		DrawWithGPU();
+	}
+	else
+	{
+		// 重建后的网格段需要重新绘制
+		CurrentLOD = -1;
+		ConstructMesh(1);
+	}
+}
+
+void AXVBarChart::UpdateCellValues(const TArray<FXVCellUpdate>& Updates)
+{
+	UpdateValues(Updates);
+}
+
+void AXVBarChart::FlushDirtyCells()
+{
+	bHasDirtyCells = false;
+
+	if (bEnableGPU)
+	{
+		DirtyCells.SetRange(0, DirtyCells.Num(), false);
+		DrawWithGPU();
+		return;
+	}
+
+	// 合并柱体的高度从求和面积表读取，先更新修改过的单元格所在的表项
+	ValuePyramid.UpdateCells(ValueGrid, DirtyCells);
+
+	const bool bInstanced = IsInstanced();
+	const bool bMerged = HasSectionStates();
+	TArray<int32> DirtyBlocks;
+	TArray<FXVChartSectionInfo> BarScratch;
+	for (int32 LODIndex = 0; LODIndex < LODSectionIndices.Num(); ++LODIndex)
+	{
+		const int32 BlockSize = LODIndex + 1;
+		const int32 NumBlockCols = FMath::DivideAndRoundUp(ColCounts, BlockSize);
+		const TArray<int32>& SectionIndices = LODSectionIndices[LODIndex];
+
+		// 同一合并块中的多个单元格只重建一次
+		DirtyBlocks.Reset();
+		for (TConstSetBitIterator<> It(DirtyCells); It; ++It)
+		{
+			const int32 Row = It.GetIndex() / ColCounts;
+			const int32 Col = It.GetIndex() % ColCounts;
+			DirtyBlocks.Add(Row / BlockSize * NumBlockCols + Col / BlockSize);
+		}
+		DirtyBlocks.Sort();
+
+		for (int32 i = 0; i < DirtyBlocks.Num(); ++i)
+		{
+			const int32 Block = DirtyBlocks[i];
+			const int32 BarIndex = SectionIndices[Block];
+			if ((i > 0 && Block == DirtyBlocks[i - 1]) || BarIndex == INDEX_NONE)
+			{
+				continue;
+			}
+			const int32 SectionIndex = LODInfos[LODIndex].LODOffset + BarIndex;
+
+			const int32 IndexOfY = Block / NumBlockCols * BlockSize;
+			const int32 IndexOfX = Block % NumBlockCols * BlockSize;
+			float RawHeight = 0;
+			ComputeMergedHeight(LODIndex, IndexOfY, IndexOfX, RawHeight);
+
+			float AdjustedHeight;
+			if (bInstanced)
+			{
+				// 只改写实例的变换、高度和颜色，保留当前的发光状态
+				FTransform Transform;
+				float CustomData[XVBarInstanceData::NumFloats];
+				AdjustedHeight = ComputeBarInstance(LODIndex, IndexOfY, IndexOfX, RawHeight, Transform, MakeArrayView(CustomData));
+				UInstancedStaticMeshComponent* InstanceComponent = InstanceComponents[LODIndex];
+				InstanceComponent->UpdateInstanceTransform(BarIndex, Transform);
+				for (int32 DataIndex = XVBarInstanceData::Height; DataIndex < XVBarInstanceData::EmissiveColor; ++DataIndex)
+				{
+					InstanceComponent->SetCustomDataValue(BarIndex, DataIndex, CustomData[DataIndex]);
+				}
+			}
+			else if (bMerged)
+			{
+				// 柱体的顶点数量不变，单独重建后覆盖合并网格段中对应的顶点和颜色
+				BarScratch.Reset();
+				BarScratch.AddDefaulted();
+				AdjustedHeight = BuildBarSection(BarScratch, 0, LODIndex, IndexOfY, IndexOfX, RawHeight);
+
+				FXVChartSectionInfo& MergedSection = SectionInfos[LODIndex];
+				const FXVChartSectionInfo& BarSection = BarScratch[0];
+				const int32 FirstVertex = LODVertexStarts[LODIndex][BarIndex];
+				for (int32 VertexIndex = 0; VertexIndex < BarSection.Vertices.Num(); ++VertexIndex)
+				{
+					MergedSection.Vertices[FirstVertex + VertexIndex] = BarSection.Vertices[VertexIndex];
+					MergedSection.VertexColors[FirstVertex + VertexIndex] = BarSection.VertexColors[VertexIndex];
+					if (VerticesBackup.IsValidIndex(LODIndex))
+					{
+						VerticesBackup[LODIndex][FirstVertex + VertexIndex] = BarSection.Vertices[VertexIndex];
+					}
+				}
+
+				// 图表网格组件只上传该柱体的顶点范围
+				if (LODIndex == CurrentLOD && IsUsingChartMeshComponent())
+				{
+					UpdateMeshSectionRange(LODIndex, FirstVertex, BarSection.Vertices.Num());
+				}
+			}
+			else
+			{
+				ClearSelectedSection(SectionIndex);
+				AdjustedHeight = BuildBarSection(SectionInfos, SectionIndex, LODIndex, IndexOfY, IndexOfX, RawHeight);
+				if (VerticesBackup.IsValidIndex(SectionIndex))
+				{
+					VerticesBackup[SectionIndex] = SectionInfos[SectionIndex].Vertices;
+				}
+			}
+
+			if (LODIndex == 0)
+			{
+				SectionsHeight[BarIndex] = AdjustedHeight;
+				LabelComponents[BarIndex]->SetText(FText::FromString(FString::Printf(TEXT("%.2f"), RawHeight)));
+
+				if (bEnableReferenceHighlight)
+				{
+					UpdateReferenceHighlight(BarIndex, RawHeight);
+				}
+				if (bEnableValueTriggers)
+				{
+					UpdateValueTrigger(BarIndex, RawHeight);
+				}
+			}
+
+			// 当前显示的LOD直接更新顶点，柱体的顶点数量不变
+			if (LODIndex == CurrentLOD && !bInstanced && !bMerged)
+			{
+				UpdateMeshSection(SectionIndex);
+			}
+		}
+
+		if (bInstanced && DirtyBlocks.Num() > 0)
+		{
+			InstanceComponents[LODIndex]->MarkRenderStateDirty();
+		}
+
+		// 程序化网格组件只能整段更新，合并网格段在该级所有柱体重建后只上传一次
+		if (bMerged && LODIndex == CurrentLOD && DirtyBlocks.Num() > 0 && !IsUsingChartMeshComponent())
+		{
+			UpdateMeshSection(LODIndex);
+		}
+	}
+	DirtyCells.SetRange(0, DirtyCells.Num(), false);
+
+	if (bEnableStatisticalLines)
+	{
+		UpdateStatisticalLineValues();
+		ApplyStatisticalLines();
+	}
+}
+
 void AXVBarChart::DrawWithGPU()
 {
 	Super::DrawWithGPU();
@@ -359,11 +944,34 @@ void AXVBarChart::ConstructMesh(double Rate)
 
 	Rate = FMath::Clamp<double>(Rate, 0.f, 1.f);
 
-	UpdateSectionVerticesOfZ(Rate);
+	if (IsInstanced())
+	{
+		// 柱体都从Z=0开始，入场动画直接缩放实例化组件，不需要逐个修改实例
+		for (UInstancedStaticMeshComponent* InstanceComponent : InstanceComponents)
+		{
+			InstanceComponent->SetRelativeScale3D(FVector(1, 1, FMath::Clamp(Rate, 0.1, 1.0)));
+		}
+	}
+	else
+	{
+		UpdateSectionVerticesOfZ(Rate);
+	}
 
 	UpdateLOD();
 }
 
+int32 AXVBarChart::GetCellBarIndex(int32 Row, int32 Col) const
+{
+	// LOD0的合并块与单元格一一对应，块的序号即为单元格下标
+	if (!ValueGrid.Contains(Row, Col) || !ValueGrid.IsValid(Row, Col) || !LODSectionIndices.IsValidIndex(0))
+	{
+		return INDEX_NONE;
+	}
+	const TArray<int32>& SectionIndices = LODSectionIndices[0];
+	const int32 CellIndex = ValueGrid.GetCellIndex(Row, Col);
+	return SectionIndices.IsValidIndex(CellIndex) ? SectionIndices[CellIndex] : INDEX_NONE;
+}
+
 void AXVBarChart::UpdateOnMouseEnterOrLeft()
 {
 	if (bIsMouseEntered)
@@ -374,23 +982,21 @@ void AXVBarChart::UpdateOnMouseEnterOrLeft()
 		{
 			FVector Result = GetCursorHitRowAndColAndHeight(HitResult);
 
-			int CurrentRow = Result.Y / (YAxisInterval * GetActorScale3D().Y);
-			int CurrentCol = Result.X / (XAxisInterval * GetActorScale3D().X);
-			int CurrentIndex = CurrentRow * ColCounts + CurrentCol;
-			if (CurrentIndex < TotalCountOfValue)
+			const int32 CurrentRow = FMath::FloorToInt32(Result.Y / (YAxisInterval * GetActorScale3D().Y));
+			const int32 CurrentCol = FMath::FloorToInt32(Result.X / (XAxisInterval * GetActorScale3D().X));
+			const int32 CurrentIndex = GetCellBarIndex(CurrentRow, CurrentCol);
+			if (CurrentIndex != INDEX_NONE)
 			{
 				if (HoveredIndex != -1 && HoveredIndex != CurrentIndex)
 				{
-					DynamicMaterialInstances[HoveredIndex]->SetScalarParameterValue("EmissiveIntensity", 0);
-					UpdateMeshSection(HoveredIndex);
+					SetBarEmissiveIntensity(HoveredIndex, 0);
 					LabelComponents[HoveredIndex]->SetVisibility(false);
 					LabelComponents[HoveredIndex]->MarkRenderStateDirty();
 				}
 				if (HoveredIndex != CurrentIndex)
 				{
 					HoveredIndex = CurrentIndex;
-					DynamicMaterialInstances[HoveredIndex]->SetScalarParameterValue("EmissiveIntensity", EmissiveIntensity);
-					UpdateMeshSection(HoveredIndex);
+					SetBarEmissiveIntensity(HoveredIndex, EmissiveIntensity);
 
 					FQuat QuatRotation = FQuat(GetActorRotation());
 					FVector Position(XAxisInterval * CurrentCol, YAxisInterval * CurrentRow, 0);
@@ -413,7 +1019,7 @@ void AXVBarChart::UpdateOnMouseEnterOrLeft()
 	{
 		if (HoveredIndex != -1)
 		{
-			DynamicMaterialInstances[HoveredIndex]->SetScalarParameterValue("EmissiveIntensity", 0);
+			SetBarEmissiveIntensity(HoveredIndex, 0);
 			LabelComponents[HoveredIndex]->SetVisibility(false);
 			LabelComponents[HoveredIndex]->MarkRenderStateDirty();
 			HoveredIndex = -1;
@@ -431,34 +1037,24 @@ void AXVBarChart::ApplyReferenceHighlight()
 
 	// 遍历所有柱子，检查是否符合参考值条件
 	size_t CurrentIndex = 0;
-	for (size_t IndexOfY = 0; IndexOfY < RowCounts; IndexOfY++)
+	ValueGrid.ForEachValid([this, &CurrentIndex](int32 IndexOfY, int32 IndexOfX, float RawValue)
 	{
-		for (size_t IndexOfX = 0; IndexOfX < XYZs[IndexOfY].Num(); IndexOfX++)
-		{
-			// 使用原始高度值进行比较，而不是调整后的高度
-			float RawValue = XYZs[IndexOfY][IndexOfX];
-			
-			// 检查值是否符合参考值条件
-			bool bMatchesReference = CheckAgainstReference(RawValue);
-			
-			if (bMatchesReference)
-			{
-				// 符合条件，应用高亮颜色和发光效果
-				DynamicMaterialInstances[CurrentIndex]->SetVectorParameterValue("EmissiveColor", ReferenceHighlightColor);
-				DynamicMaterialInstances[CurrentIndex]->SetScalarParameterValue("EmissiveIntensity", EmissiveIntensity);
-			}
-			else
-			{
-				// 不符合条件，恢复默认颜色和发光效果
-				DynamicMaterialInstances[CurrentIndex]->SetVectorParameterValue("EmissiveColor", EmissiveColor);
-				DynamicMaterialInstances[CurrentIndex]->SetScalarParameterValue("EmissiveIntensity", 0);
-			}
-			
-			// 更新网格部分
-			UpdateMeshSection(CurrentIndex);
-			
-			CurrentIndex++;
-		}
+		UpdateReferenceHighlight(CurrentIndex++, RawValue);
+	});
+}
+
+void AXVBarChart::UpdateReferenceHighlight(int32 Index, float RawValue)
+{
+	// 使用原始高度值进行比较，而不是调整后的高度
+	if (CheckAgainstReference(RawValue))
+	{
+		// 符合条件，应用高亮颜色和发光效果
+		SetBarEmissive(Index, ReferenceHighlightColor, EmissiveIntensity);
+	}
+	else
+	{
+		// 不符合条件，恢复默认颜色和发光效果
+		SetBarEmissive(Index, EmissiveColor, 0);
 	}
 }
 
@@ -506,13 +1102,7 @@ TArray<float> AXVBarChart::GetAllDataValues() const
 	TArray<float> Values;
 	
 	// 收集所有Z值（高度值）
-	for (const auto& Row : XYZs)
-	{
-		for (const auto& Item : Row.Value)
-		{
-			Values.Add(Item.Value);
-		}
-	}
+	ValueGrid.GetValidValues(Values);
 	
 	return Values;
 }
@@ -641,34 +1231,24 @@ void AXVBarChart::ApplyValueTriggerConditions()
 
 	// 遍历所有柱子，检查是否符合触发条件
 	size_t CurrentIndex = 0;
-	for (size_t IndexOfY = 0; IndexOfY < RowCounts; IndexOfY++)
+	ValueGrid.ForEachValid([this, &CurrentIndex](int32 IndexOfY, int32 IndexOfX, float RawValue)
 	{
-		for (size_t IndexOfX = 0; IndexOfX < XYZs[IndexOfY].Num(); IndexOfX++)
-		{
-			// 获取原始高度值
-			float RawValue = XYZs[IndexOfY][IndexOfX];
-			
-			// 检查值是否满足任何触发条件
-			FLinearColor HighlightColor;
-			bool bMatchesTrigger = CheckValueTriggerConditions(RawValue, HighlightColor);
-			
-			if (bMatchesTrigger)
-			{
-				// 符合条件，应用高亮颜色和发光效果
-				DynamicMaterialInstances[CurrentIndex]->SetVectorParameterValue("EmissiveColor", HighlightColor);
-				DynamicMaterialInstances[CurrentIndex]->SetScalarParameterValue("EmissiveIntensity", EmissiveIntensity);
-			}
-			else
-			{
-				// 不符合条件，恢复默认颜色和发光效果
-				DynamicMaterialInstances[CurrentIndex]->SetVectorParameterValue("EmissiveColor", EmissiveColor);
-				DynamicMaterialInstances[CurrentIndex]->SetScalarParameterValue("EmissiveIntensity", 0);
-			}
-			
-			// 更新网格部分
-			UpdateMeshSection(CurrentIndex);
-			
-			CurrentIndex++;
-		}
+		UpdateValueTrigger(CurrentIndex++, RawValue);
+	});
+}
+
+void AXVBarChart::UpdateValueTrigger(int32 Index, float RawValue)
+{
+	// 检查原始高度值是否满足任何触发条件
+	FLinearColor HighlightColor;
+	if (CheckValueTriggerConditions(RawValue, HighlightColor))
+	{
+		// 符合条件，应用高亮颜色和发光效果
+		SetBarEmissive(Index, HighlightColor, EmissiveIntensity);
+	}
+	else
+	{
+		// 不符合条件，恢复默认颜色和发光效果
+		SetBarEmissive(Index, EmissiveColor, 0);
 	}
 }
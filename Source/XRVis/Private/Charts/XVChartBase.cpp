@@ -3,16 +3,67 @@
 #include "SceneViewExtension.h"
 #include "Misc/FileHelper.h"
 #include "Misc/Paths.h"
+#include "Async/Async.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 #include "Dom/JsonObject.h"
 #include "Dom/JsonValue.h"
-#include "Charts/XVBarChart.h"
-#include "Charts/XVLineChart.h"
+#include "DataProcessing/XVDataConverter.h"
+#include "DataProcessing/XVTimestampParser.h"
+#include "Components/TextRenderComponent.h"
+#include "Engine/Texture2D.h"
+#include "Materials/MaterialInstanceDynamic.h"
 #include "Rendering/XRVisBoxGeometryGenerator.h"
 #include "Rendering/XRVisBoxGeometryRenderer.h"
 #include "Rendering/XRVisSceneViewExtension.h"
 
+/* 状态纹理每行的纹素数 */
+static constexpr int32 SectionStateTextureWidth = 256;
+
+namespace XVChartBasePrivate
+{
+	/* 网格段缺少切线时使用的默认切线，与程序化网格组件一致 */
+	const FVector3f DefaultTangent(1.f, 0.f, 0.f);
+
+	void GetVertexBasis(const FXVChartSectionInfo& SectionInfo, int32 VertexIndex, FVector3f& OutNormal, FVector3f& OutTangent)
+	{
+		OutNormal = SectionInfo.Normals.IsValidIndex(VertexIndex) ? FVector3f(SectionInfo.Normals[VertexIndex]) : FVector3f::UpVector;
+		OutTangent = SectionInfo.Tangents.IsValidIndex(VertexIndex) ? FVector3f(SectionInfo.Tangents[VertexIndex].TangentX) : DefaultTangent;
+	}
+
+	FColor GetVertexColor(const FXVChartSectionInfo& SectionInfo, int32 VertexIndex, bool bSRGBConversion)
+	{
+		return SectionInfo.VertexColors.IsValidIndex(VertexIndex) ? SectionInfo.VertexColors[VertexIndex].ToFColor(bSRGBConversion) : FColor::White;
+	}
+
+	/* 把网格段转换为图表网格组件的紧凑格式，合并网格段的UV1作为第二套UV */
+	TUniquePtr<FXRVisChartMeshSectionData> MakeChartMeshSection(const FXVChartSectionInfo& SectionInfo)
+	{
+		const int32 NumVertices = SectionInfo.Vertices.Num();
+		const int32 NumIndices = SectionInfo.Indices.Num();
+		const bool bHasUV1 = SectionInfo.UV1.Num() > 0;
+		TUniquePtr<FXRVisChartMeshSectionData> Data = MakeUnique<FXRVisChartMeshSectionData>(NumVertices, NumIndices, bHasUV1 ? 2 : 1);
+		for (int32 VertexIndex = 0; VertexIndex < NumVertices; ++VertexIndex)
+		{
+			FVector3f Normal;
+			FVector3f Tangent;
+			GetVertexBasis(SectionInfo, VertexIndex, Normal, Tangent);
+			Data->SetVertex(VertexIndex, FVector3f(SectionInfo.Vertices[VertexIndex]), Normal, Tangent, GetVertexColor(SectionInfo, VertexIndex, false));
+			Data->SetTexCoord(VertexIndex, 0, SectionInfo.UVs.IsValidIndex(VertexIndex) ? FVector2f(SectionInfo.UVs[VertexIndex]) : FVector2f::ZeroVector);
+			if (bHasUV1)
+			{
+				Data->SetTexCoord(VertexIndex, 1, SectionInfo.UV1.IsValidIndex(VertexIndex) ? FVector2f(SectionInfo.UV1[VertexIndex]) : FVector2f::ZeroVector);
+			}
+		}
+		uint32* Indices = Data->GetIndexData();
+		for (int32 Index = 0; Index < NumIndices; ++Index)
+		{
+			Indices[Index] = static_cast<uint32>(SectionInfo.Indices[Index]);
+		}
+		return Data;
+	}
+}
+
 
 // Sets default values
 AXVChartBase::AXVChartBase()
@@ -23,6 +74,10 @@ AXVChartBase::AXVChartBase()
 	ProceduralMeshComponent = CreateDefaultSubobject<UProceduralMeshComponent>(TEXT("Procedural Mesh Component"));
 	ProceduralMeshComponent->SetCastShadow(false);
 	RootComponent = ProceduralMeshComponent;
+
+	ChartMeshComponent = CreateDefaultSubobject<UXRVisChartMeshComponent>(TEXT("Chart Mesh Component"));
+	ChartMeshComponent->SetCastShadow(false);
+	ChartMeshComponent->SetupAttachment(RootComponent);
 	
 	// 确保TimePropertyName与PropertyMapping.TimeProperty保持同步
 	PropertyMapping.TimeProperty = TimePropertyName;
@@ -114,19 +169,24 @@ void AXVChartBase::SetStyle()
 
 void AXVChartBase::ConstructMesh(double Rate)
 {
-	ProceduralMeshComponent->ClearAllMeshSections();
-	ProceduralMeshComponent->ClearCollisionConvexMeshes();
+	ClearAllMeshSections();
 }
 
 void AXVChartBase::PrepareMeshSections()
 {
-	ProceduralMeshComponent->ClearAllMeshSections();
-	ProceduralMeshComponent->ClearCollisionConvexMeshes();
+	ClearAllMeshSections();
 	LODInfos.Empty();
 	LODInfos.SetNum(GenerateLODCount);
+	// 网格段的数量由各图表确定图元后按实际数量分配
 	SectionInfos.Empty();
-	// TODO: Bigger than actually needed
-	SectionInfos.SetNum(GenerateLODCount * TotalCountOfValue + 1);
+	// 图表在运行时可能多次重建，旧的标签组件需要销毁，否则会一直挂在Actor上
+	for (UTextRenderComponent* Label : LabelComponents)
+	{
+		if (IsValid(Label))
+		{
+			Label->DestroyComponent();
+		}
+	}
 	LabelComponents.Empty();
 	LabelComponents.SetNum(TotalCountOfValue);
 	VerticesBackup.Empty();
@@ -146,7 +206,7 @@ void AXVChartBase::DrawMeshLOD(int LODLevel)
 			for (int Index = 0; Index < LODInfos[CurrentLOD].LODCount; ++Index)
 			{
 				int SectionIndex = Index + LODInfos[CurrentLOD].LODOffset;
-				ProceduralMeshComponent->ClearMeshSection(SectionIndex);
+				ClearMeshSection(SectionIndex);
 			}
 		}
 		
@@ -167,6 +227,7 @@ void AXVChartBase::ClearSelectedSection(const int& SectionIndex)
 	SectionInfos[SectionIndex].UVs.Empty();
 	SectionInfos[SectionIndex].Tangents.Empty();
 	SectionInfos[SectionIndex].VertexColors.Empty();
+	SectionInfos[SectionIndex].UV1.Empty();
 }
 
 void AXVChartBase::GenerateLOD()
@@ -196,6 +257,22 @@ void AXVChartBase::UpdateSectionVerticesOfZ(const double& Scale)
 
 void AXVChartBase::DrawMeshSection(int SectionIndex, bool bCreateCollision)
 {
+	const FXVChartSectionInfo& SectionInfo = SectionInfos[SectionIndex];
+	if (IsUsingChartMeshComponent())
+	{
+		ChartMeshComponent->CreateSection(SectionIndex, XVChartBasePrivate::MakeChartMeshSection(SectionInfo), bCreateCollision);
+		return;
+	}
+
+	if (SectionInfo.UV1.Num() > 0)
+	{
+		// 合并网格段的UV1为状态纹理坐标
+		ProceduralMeshComponent->CreateMeshSection_LinearColor(SectionIndex, SectionInfo.Vertices, SectionInfo.Indices, SectionInfo.Normals,
+		                                                       SectionInfo.UVs, SectionInfo.UV1, TArray<FVector2D>(), TArray<FVector2D>(),
+		                                                       SectionInfo.VertexColors, SectionInfo.Tangents, bCreateCollision);
+		return;
+	}
+
 	ProceduralMeshComponent->CreateMeshSection_LinearColor(SectionIndex,
 	                                                       SectionInfos[SectionIndex].Vertices,
 	                                                       SectionInfos[SectionIndex].Indices,
@@ -208,6 +285,21 @@ void AXVChartBase::DrawMeshSection(int SectionIndex, bool bCreateCollision)
 
 void AXVChartBase::UpdateMeshSection(int SectionIndex, bool bSRGBConversion)
 {
+	const FXVChartSectionInfo& SectionInfo = SectionInfos[SectionIndex];
+	if (IsUsingChartMeshComponent())
+	{
+		UpdateMeshSectionRange(SectionIndex, 0, SectionInfo.Vertices.Num(), bSRGBConversion);
+		return;
+	}
+
+	if (SectionInfo.UV1.Num() > 0)
+	{
+		ProceduralMeshComponent->UpdateMeshSection_LinearColor(SectionIndex, SectionInfo.Vertices, SectionInfo.Normals, SectionInfo.UVs,
+		                                                       SectionInfo.UV1, TArray<FVector2D>(), TArray<FVector2D>(),
+		                                                       SectionInfo.VertexColors, SectionInfo.Tangents, bSRGBConversion);
+		return;
+	}
+
 	ProceduralMeshComponent->UpdateMeshSection_LinearColor(
 		SectionIndex,
 		SectionInfos[SectionIndex].Vertices,
@@ -218,6 +310,187 @@ void AXVChartBase::UpdateMeshSection(int SectionIndex, bool bSRGBConversion)
 		bSRGBConversion);
 }
 
+void AXVChartBase::UpdateMeshSectionRange(int SectionIndex, int32 FirstVertex, int32 NumVertices, bool bSRGBConversion)
+{
+	if (!IsUsingChartMeshComponent())
+	{
+		UpdateMeshSection(SectionIndex, bSRGBConversion);
+		return;
+	}
+
+	const FXVChartSectionInfo& SectionInfo = SectionInfos[SectionIndex];
+	check(FirstVertex >= 0 && FirstVertex + NumVertices <= SectionInfo.Vertices.Num());
+	FXRVisChartMeshVertexUpdate Update;
+	Update.Init(FirstVertex, NumVertices);
+	for (int32 Index = 0; Index < NumVertices; ++Index)
+	{
+		const int32 VertexIndex = FirstVertex + Index;
+		FVector3f Normal;
+		FVector3f Tangent;
+		XVChartBasePrivate::GetVertexBasis(SectionInfo, VertexIndex, Normal, Tangent);
+		Update.SetVertex(Index, FVector3f(SectionInfo.Vertices[VertexIndex]), Normal, Tangent,
+		                 XVChartBasePrivate::GetVertexColor(SectionInfo, VertexIndex, bSRGBConversion));
+	}
+	ChartMeshComponent->UpdateSectionVertices(SectionIndex, MoveTemp(Update));
+}
+
+void AXVChartBase::ClearMeshSection(int SectionIndex)
+{
+	ProceduralMeshComponent->ClearMeshSection(SectionIndex);
+	ChartMeshComponent->ClearSection(SectionIndex);
+}
+
+void AXVChartBase::ClearAllMeshSections()
+{
+	ProceduralMeshComponent->ClearAllMeshSections();
+	ProceduralMeshComponent->ClearCollisionConvexMeshes();
+	ChartMeshComponent->ClearAllSections();
+}
+
+UMeshComponent* AXVChartBase::GetSectionMeshComponent() const
+{
+	if (IsUsingChartMeshComponent())
+	{
+		return ChartMeshComponent;
+	}
+	return ProceduralMeshComponent;
+}
+
+void AXVChartBase::InitSectionStates(int32 NumIds, UMaterialInterface* FallbackMaterial)
+{
+	// 多保留一个纹素给不参与交互的顶点
+	const int32 Height = FMath::Max(1, FMath::DivideAndRoundUp(NumIds + 1, SectionStateTextureWidth));
+	SectionStates.Init(FLinearColor(EmissiveColor.R, EmissiveColor.G, EmissiveColor.B, 0), SectionStateTextureWidth * Height);
+	HiddenSectionIds.Init(false, SectionStates.Num());
+
+	if (!SectionStateTexture || SectionStateTextureHeight != Height)
+	{
+		SectionStateTexture = UTexture2D::CreateTransient(SectionStateTextureWidth, Height, PF_FloatRGBA);
+		SectionStateTexture->Filter = TF_Nearest;
+		SectionStateTexture->SRGB = false;
+		SectionStateTexture->UpdateResource();
+		SectionStateTextureHeight = Height;
+	}
+
+	UMaterialInterface* Material = MergedSectionMaterial ? MergedSectionMaterial : FallbackMaterial;
+	if (!MergedSectionMaterialInstance || MergedSectionMaterialInstance->Parent != Material)
+	{
+		MergedSectionMaterialInstance = UMaterialInstanceDynamic::Create(Material, this);
+	}
+	MergedSectionMaterialInstance->SetTextureParameterValue(TEXT("SectionStateTexture"), SectionStateTexture);
+	MergedSectionMaterialInstance->SetVectorParameterValue(TEXT("EmissiveColor"), EmissiveColor);
+
+	// 新纹理的内容在下一次Tick时整体上传
+	DirtyStateRowBegin = 0;
+	DirtyStateRowEnd = Height - 1;
+}
+
+void AXVChartBase::ReleaseSectionStates()
+{
+	SectionStateTexture = nullptr;
+	SectionStateTextureHeight = 0;
+	MergedSectionMaterialInstance = nullptr;
+	SectionStates.Empty();
+	HiddenSectionIds.Empty();
+	DirtyStateRowBegin = MAX_int32;
+	DirtyStateRowEnd = INDEX_NONE;
+}
+
+void AXVChartBase::MarkSectionStateDirty(int32 Id)
+{
+	const int32 Row = Id / SectionStateTextureWidth;
+	DirtyStateRowBegin = FMath::Min(DirtyStateRowBegin, Row);
+	DirtyStateRowEnd = FMath::Max(DirtyStateRowEnd, Row);
+}
+
+void AXVChartBase::SetSectionState(int32 Id, const FLinearColor& Color, float Intensity)
+{
+	if (!SectionStates.IsValidIndex(Id))
+	{
+		return;
+	}
+	SectionStates[Id] = FLinearColor(Color.R, Color.G, Color.B, Intensity);
+	MarkSectionStateDirty(Id);
+}
+
+void AXVChartBase::SetSectionStateIntensity(int32 Id, float Intensity)
+{
+	if (!SectionStates.IsValidIndex(Id))
+	{
+		return;
+	}
+	SectionStates[Id].A = Intensity;
+	MarkSectionStateDirty(Id);
+}
+
+void AXVChartBase::SetSectionStateVisible(int32 Id, bool bVisible)
+{
+	if (!HiddenSectionIds.IsValidIndex(Id) || HiddenSectionIds[Id] == !bVisible)
+	{
+		return;
+	}
+	HiddenSectionIds[Id] = !bVisible;
+	MarkSectionStateDirty(Id);
+}
+
+void AXVChartBase::ResetSectionStates()
+{
+	if (!HasSectionStates())
+	{
+		return;
+	}
+
+	for (FLinearColor& State : SectionStates)
+	{
+		State = FLinearColor(EmissiveColor.R, EmissiveColor.G, EmissiveColor.B, 0);
+	}
+	DirtyStateRowBegin = 0;
+	DirtyStateRowEnd = SectionStateTextureHeight - 1;
+}
+
+void AXVChartBase::FlushSectionStates()
+{
+	if (!SectionStateTexture || DirtyStateRowBegin > DirtyStateRowEnd)
+	{
+		return;
+	}
+
+	// 只上传修改过的行，缓冲区和区域在渲染线程复制完成后释放
+	const int32 NumRows = DirtyStateRowEnd - DirtyStateRowBegin + 1;
+	const int32 FirstId = DirtyStateRowBegin * SectionStateTextureWidth;
+	const int32 NumTexels = NumRows * SectionStateTextureWidth;
+	FFloat16Color* Texels = new FFloat16Color[NumTexels];
+	for (int32 i = 0; i < NumTexels; ++i)
+	{
+		const int32 Id = FirstId + i;
+		Texels[i] = HiddenSectionIds[Id] ? FFloat16Color(FLinearColor(0, 0, 0, -1)) : FFloat16Color(SectionStates[Id]);
+	}
+
+	FUpdateTextureRegion2D* Region = new FUpdateTextureRegion2D(0, DirtyStateRowBegin, 0, 0, SectionStateTextureWidth, NumRows);
+	SectionStateTexture->UpdateTextureRegions(0, 1, Region, SectionStateTextureWidth * sizeof(FFloat16Color), sizeof(FFloat16Color),
+	                                          reinterpret_cast<uint8*>(Texels), [](uint8* SrcData, const FUpdateTextureRegion2D* Regions)
+	                                          {
+		                                          delete[] reinterpret_cast<FFloat16Color*>(SrcData);
+		                                          delete Regions;
+	                                          });
+
+	DirtyStateRowBegin = MAX_int32;
+	DirtyStateRowEnd = INDEX_NONE;
+}
+
+void AXVChartBase::AssignSectionId(FXVChartSectionInfo& Section, int32 FirstVertex, int32 Id) const
+{
+	// 采样纹素中心，材质使用最近点过滤
+	const FVector2D TexelUV((Id % SectionStateTextureWidth + 0.5) / SectionStateTextureWidth,
+	                        (Id / SectionStateTextureWidth + 0.5) / FMath::Max(1, SectionStateTextureHeight));
+	Section.UV1.SetNumZeroed(FirstVertex);
+	Section.UV1.Reserve(Section.Vertices.Num());
+	for (int32 VertexIndex = FirstVertex; VertexIndex < Section.Vertices.Num(); ++VertexIndex)
+	{
+		Section.UV1.Add(TexelUV);
+	}
+}
+
 void AXVChartBase::DrawWithGPU()
 {
 	if (!bEnableGPU)
@@ -241,9 +514,29 @@ void AXVChartBase::BeginPlay()
 	// 如果启用了自动加载数据并且设置了有效的数据路径
 	if (bAutoLoadData && !DataFilePath.IsEmpty())
 	{
-		LoadDataFromFile(DataFilePath);
+		if (bLoadDataAsync)
+		{
+			// 数据就绪后在OnDataLoadFinished中应用依赖数据的效果
+			LoadDataFromFileAsync(DataFilePath);
+		}
+		else
+		{
+			LoadDataFromFile(DataFilePath);
+		}
 	}
 
+	ApplyDataDrivenEffects();
+}
+
+void AXVChartBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	CancelDataLoad();
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AXVChartBase::ApplyDataDrivenEffects()
+{
 	// 如果启用了参考值高亮，应用高亮效果
 	if (bEnableReferenceHighlight)
 	{
@@ -302,6 +595,9 @@ void AXVChartBase::Tick(float DeltaTime)
 	{
 		UpdateTimeline(DeltaTime);
 	}
+
+	// 合并网格段的状态修改每帧统一上传一次
+	FlushSectionStates();
 }
 
 // 数据加载相关方法实现
@@ -320,43 +616,135 @@ bool AXVChartBase::LoadDataFromFile(const FString& FilePath)
 		ChartDataManager = NewObject<UXVDataManager>(this, TEXT("ChartDataManager"));
 	}
 
+	// 同步加载的结果会覆盖仍在进行的异步加载
+	CancelDataLoad();
+
 	// 保存当前文件路径
 	DataFilePath = FilePath;
 
-	// 读取文件内容
-	FString FileContent;
-	if (FFileHelper::LoadFileToString(FileContent, *FilePath))
+	FXVChartGridData GridData;
+	if (LoadGridFromFile(ChartDataManager, FilePath, GetClass()->GetName(), PropertyMapping, bUseDataCache, GridData))
 	{
-		// 判断文件类型
-		FString Extension = FPaths::GetExtension(FilePath);
+		SetValueFromGrid(GridData);
+		return true;
+	}
+
+	return false;
+}
 
-		if (Extension.Equals(TEXT("json"), ESearchCase::IgnoreCase))
+bool AXVChartBase::LoadDataFromFileAsync(const FString& FilePath)
+{
+	if (FilePath.IsEmpty())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("AXVChartBase: 文件路径为空"));
+		return false;
+	}
+
+	// 开始新的加载前取消仍在进行的加载
+	CancelDataLoad();
+
+	DataFilePath = FilePath;
+	const int32 Generation = ++DataLoadGeneration;
+	bIsLoadingData = true;
+
+	TSharedPtr<FThreadSafeBool, ESPMode::ThreadSafe> CancelFlag = MakeShared<FThreadSafeBool, ESPMode::ThreadSafe>(false);
+	DataLoadCancelFlag = CancelFlag;
+
+	// 后台任务使用独立的数据管理器，加入根集防止在读取期间被回收，结束后在游戏线程上移出
+	UXVDataManager* LoadingManager = NewObject<UXVDataManager>(GetTransientPackage());
+	LoadingManager->AddToRoot();
+
+	// 图表状态在游戏线程上复制一份，后台任务不访问图表本身
+	const FString ChartClassName = GetClass()->GetName();
+	const FXVChartPropertyMapping Mapping = PropertyMapping;
+	const bool bUseCache = bUseDataCache;
+	TWeakObjectPtr<AXVChartBase> WeakThis(this);
+
+	// 进度回调在后台线程调用，每变化1%转发一次到游戏线程；读取阶段占总进度的90%
+	LoadingManager->SetReadMonitor([WeakThis, Generation, LastProgress = 0.0f](float Progress) mutable
+	{
+		if (Progress - LastProgress < 0.01f)
 		{
-			// 首先尝试直接解析JSON
-			if (SetValueFromJson(FileContent))
+			return;
+		}
+		LastProgress = Progress;
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Generation, Progress]()
+		{
+			AXVChartBase* Chart = WeakThis.Get();
+			if (Chart && Chart->DataLoadGeneration == Generation)
 			{
-				return true;
+				Chart->OnDataLoadProgress.Broadcast(Progress * 0.9f);
 			}
-		}
+		});
+	}, CancelFlag);
+
+	Async(EAsyncExecution::ThreadPool, [WeakThis, Generation, LoadingManager, CancelFlag, FilePath, ChartClassName, Mapping, bUseCache]()
+	{
+		// 文件读取、解析和类型化数据的生成都在后台线程完成
+		FXVChartGridData GridData;
+		const bool bSuccess = LoadGridFromFile(LoadingManager, FilePath, ChartClassName, Mapping, bUseCache, GridData) && !*CancelFlag;
+
+		// 只有最后的数据交换在游戏线程上进行
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, Generation, LoadingManager, bSuccess, GridData = MoveTemp(GridData)]() mutable
+		{
+			LoadingManager->SetReadMonitor(nullptr, nullptr);
+			LoadingManager->RemoveFromRoot();
+
+			// 图表已被销毁，或者加载已被取消、被新的加载替代
+			AXVChartBase* Chart = WeakThis.Get();
+			if (!Chart || Chart->DataLoadGeneration != Generation)
+			{
+				return;
+			}
+			Chart->FinishDataLoad(LoadingManager, bSuccess, MoveTemp(GridData));
+		});
+	});
+
+	return true;
+}
+
+void AXVChartBase::CancelDataLoad()
+{
+	if (!bIsLoadingData)
+	{
+		return;
 	}
 
-	// 如果直接解析失败，使用之前的数据管理器方法
-	bool bSuccess = LoadDataByFileExtension(FilePath);
+	// 通知后台读取尽快停止，递增代数使其结果被丢弃
+	*DataLoadCancelFlag = true;
+	DataLoadCancelFlag.Reset();
+	++DataLoadGeneration;
+	bIsLoadingData = false;
+}
+
+void AXVChartBase::FinishDataLoad(UXVDataManager* LoadedManager, bool bSuccess, FXVChartGridData&& GridData)
+{
+	bIsLoadingData = false;
+	DataLoadCancelFlag.Reset();
 
 	if (bSuccess)
 	{
-		// 格式化数据
-		FString FormattedData = GetFormattedDataForChart();
-
-		// 设置图表值
-		if (!FormattedData.IsEmpty())
-		{
-			SetValue(FormattedData);
-			return true;
-		}
+		// 交换数据管理器，之后GetDataManager返回新加载的数据
+		ChartDataManager = LoadedManager;
+		SetValueFromGrid(GridData);
+		OnDataLoadProgress.Broadcast(1.0f);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("AXVChartBase: 异步加载 %s 失败 - %s"), *DataFilePath, *LoadedManager->GetLastError());
 	}
 
-	return false;
+	OnDataLoadFinished(bSuccess);
+	OnDataLoadCompleted.Broadcast(bSuccess);
+}
+
+void AXVChartBase::OnDataLoadFinished(bool bSuccess)
+{
+	if (bSuccess)
+	{
+		ApplyDataDrivenEffects();
+	}
 }
 
 bool AXVChartBase::LoadDataFromString(const FString& Content, const FString& FileExtension)
@@ -373,11 +761,14 @@ bool AXVChartBase::LoadDataFromString(const FString& Content, const FString& Fil
 		return false;
 	}
 
-	// 如果是JSON，首先尝试直接解析
+	// 如果是JSON，首先尝试直接解析为图表数据
 	if (FileExtension.Equals(TEXT("json"), ESearchCase::IgnoreCase))
 	{
-		if (SetValueFromJson(Content))
+		FXVChartGridData GridData;
+		if (ChartDataManager->GetJsonReader()->ReadChartGridFromString(Content, PropertyMapping.XProperty, PropertyMapping.YProperty,
+		                                                               PropertyMapping.ZProperty, PropertyMapping.TimeProperty, GridData))
 		{
+			SetValueFromGrid(GridData);
 			return true;
 		}
 	}
@@ -402,13 +793,11 @@ bool AXVChartBase::LoadDataFromString(const FString& Content, const FString& Fil
 
 	if (bSuccess)
 	{
-		// 格式化数据
-		FString FormattedData = GetFormattedDataForChart();
-
-		// 设置图表值
-		if (!FormattedData.IsEmpty())
+		// 直接将数据表转换为类型化数据交给图表
+		FXVChartGridData GridData;
+		if (FormatGridByChartType(GridData) && GridData.Num() > 0)
 		{
-			SetValue(FormattedData);
+			SetValueFromGrid(GridData);
 			return true;
 		}
 	}
@@ -421,6 +810,11 @@ bool AXVChartBase::LoadDataFromString(const FString& Content, const FString& Fil
 }
 
 bool AXVChartBase::LoadDataByFileExtension(const FString& FilePath)
+{
+	return LoadTableByFileExtension(ChartDataManager, FilePath);
+}
+
+bool AXVChartBase::LoadTableByFileExtension(UXVDataManager* DataManager, const FString& FilePath)
 {
 	// 获取文件扩展名
 	FString Extension = FPaths::GetExtension(FilePath);
@@ -428,11 +822,15 @@ bool AXVChartBase::LoadDataByFileExtension(const FString& FilePath)
 	// 根据文件扩展名选择合适的加载方法
 	if (Extension.Equals(TEXT("json"), ESearchCase::IgnoreCase))
 	{
-		return ChartDataManager->LoadFromJsonFile(FilePath);
+		return DataManager->LoadFromJsonFile(FilePath);
 	}
 	else if (Extension.Equals(TEXT("csv"), ESearchCase::IgnoreCase))
 	{
-		return ChartDataManager->LoadFromCsvFile(FilePath);
+		return DataManager->LoadFromCsvFile(FilePath);
+	}
+	else if (Extension.Equals(FXVBinaryDataset::FileExtension, ESearchCase::IgnoreCase))
+	{
+		return DataManager->LoadFromBinaryFile(FilePath);
 	}
 	else
 	{
@@ -441,6 +839,49 @@ bool AXVChartBase::LoadDataByFileExtension(const FString& FilePath)
 	}
 }
 
+bool AXVChartBase::LoadGridFromFile(UXVDataManager* DataManager, const FString& FilePath, const FString& ChartClassName,
+                                    const FXVChartPropertyMapping& Mapping, bool bUseCache, FXVChartGridData& OutGrid)
+{
+	// 需要聚合时总是读取为数据表，JSON的直接读取路径不做分组
+	const bool bIsJson = FPaths::GetExtension(FilePath).Equals(TEXT("json"), ESearchCase::IgnoreCase)
+		&& Mapping.Aggregation == EXVAggregation::None;
+
+	if (bUseCache)
+	{
+		// 数据表由使用同一文件的图表共享，各图表只按自己的属性映射做转换
+		if (!DataManager->LoadFromFileCached(FilePath))
+		{
+			return false;
+		}
+
+		const FXVDataTable& DataTable = DataManager->GetDataTable();
+		if (bIsJson && !ChartClassName.Contains(TEXT("PieChart"))
+			&& UXVDataConverter::ConvertJsonTableToGrid(DataTable, Mapping.XProperty, Mapping.YProperty, Mapping.ZProperty,
+			                                            Mapping.TimeProperty, OutGrid))
+		{
+			return true;
+		}
+		return FormatGridFromTable(ChartClassName, Mapping, DataTable, OutGrid) && OutGrid.Num() > 0;
+	}
+
+	// JSON文件首先尝试流式读取为图表数据，不将整个文件加载为字符串
+	if (bIsJson
+		&& DataManager->GetJsonReader()->ReadChartGridFromFile(FilePath, Mapping.XProperty, Mapping.YProperty, Mapping.ZProperty,
+		                                                       Mapping.TimeProperty, OutGrid))
+	{
+		return true;
+	}
+	if (DataManager->GetJsonReader()->IsReadCancelled())
+	{
+		return false;
+	}
+
+	// 如果直接解析失败，读取为数据表后再转换为类型化数据
+	return LoadTableByFileExtension(DataManager, FilePath)
+		&& FormatGridFromTable(ChartClassName, Mapping, DataManager->GetDataTable(), OutGrid)
+		&& OutGrid.Num() > 0;
+}
+
 FString AXVChartBase::GetFormattedDataForChart()
 {
 	// 格式化数据为图表可用的格式
@@ -503,6 +944,44 @@ FString AXVChartBase::FormatDataByChartType()
 	return TEXT("");
 }
 
+bool AXVChartBase::FormatGridByChartType(FXVChartGridData& OutGrid)
+{
+	return FormatGridFromTable(GetClass()->GetName(), PropertyMapping, ChartDataManager->GetDataTable(), OutGrid);
+}
+
+bool AXVChartBase::FormatGridFromTable(const FString& ChartClassName, const FXVChartPropertyMapping& Mapping, const FXVDataTable& DataTable,
+                                       FXVChartGridData& OutGrid)
+{
+	const bool bIsGridChart = ChartClassName.Contains(TEXT("BarChart")) || ChartClassName.Contains(TEXT("LineChart"));
+	if (bIsGridChart && Mapping.Aggregation != EXVAggregation::None)
+	{
+		// 柱状图/折线图按X/Y分组聚合原始记录
+		return UXVDataConverter::AggregateToGrid(DataTable, Mapping.XProperty, Mapping.YProperty, Mapping.ZProperty, Mapping.Aggregation,
+		                                         Mapping.AggregationPercentile, OutGrid);
+	}
+
+	// 检查图表类型（通过类名判断）
+	if (ChartClassName.Contains(TEXT("BarChart")))
+	{
+		// 柱状图
+		return UXVDataConverter::ConvertToBarChartGrid(DataTable, Mapping.XProperty, Mapping.YProperty, Mapping.ZProperty, OutGrid);
+	}
+	else if (ChartClassName.Contains(TEXT("LineChart")))
+	{
+		// 折线图
+		return UXVDataConverter::ConvertToLineChartGrid(DataTable, Mapping.XProperty, Mapping.YProperty, Mapping.ZProperty, OutGrid);
+	}
+	else if (ChartClassName.Contains(TEXT("PieChart")))
+	{
+		// 饼图
+		return UXVDataConverter::ConvertToPieChartGrid(DataTable, Mapping.CategoryProperty, Mapping.ValueProperty, OutGrid);
+	}
+
+	// 其他未知类型
+	UE_LOG(LogTemp, Warning, TEXT("AXVChartBase: 未知图表类型 %s，无法格式化数据"), *ChartClassName);
+	return false;
+}
+
 bool AXVChartBase::SetValueFromJson(const FString& JsonString)
 {
 	if (JsonString.IsEmpty())
@@ -528,12 +1007,16 @@ bool AXVChartBase::SetValueFromJson(const FString& JsonString)
 		// 检查第一个元素以确定数据格式
 		TSharedPtr<FJsonValue> FirstElement = JsonArray[0];
 
-		// 原始格式 [[x,y,z], ...]
+		// 原始格式 [[y,x,z], ...]
 		if (FirstElement->Type == EJson::Array)
 		{
-			// 使用原始SetValue方法
-			SetValue(JsonString);
-			return true;
+			// 直接使用已解析的DOM，避免再次解析字符串
+			FXVChartGridData GridData;
+			if (ParseGridFromJsonArray(JsonArray, GridData))
+			{
+				SetValueFromGrid(GridData);
+				return true;
+			}
 		}
 		// 对象格式 [{"x": ..., "y": ..., "z": ...}, ...]
 		else if (FirstElement->Type == EJson::Object)
@@ -574,186 +1057,75 @@ void AXVChartBase::SetValueFromNamedData(const TArray<TSharedPtr<FJsonObject>>&
 		return;
 	}
 
-	// 收集所有唯一的X和Y值
-	TSet<FString> UniqueXValues;
-	TSet<FString> UniqueYValues;
-
-	// 遍历所有数据项，提取X和Y值
-	for (const auto& DataItem : NamedData)
-	{
-		// 检查所需的字段是否存在
-		if (DataItem->HasField(PropertyMapping.XProperty) &&
-			DataItem->HasField(PropertyMapping.YProperty) &&
-			DataItem->HasField(PropertyMapping.ZProperty))
-		{
-			// 获取X值
-			FString XValue;
-			if (DataItem->TryGetStringField(PropertyMapping.XProperty, XValue))
-			{
-				UniqueXValues.Add(XValue);
-			}
-			else
-			{
-				double XNumeric = 0;
-				if (DataItem->TryGetNumberField(PropertyMapping.XProperty, XNumeric))
-				{
-					XValue = FString::Printf(TEXT("%g"), XNumeric);
-					UniqueXValues.Add(XValue);
-				}
-			}
-
-			// 获取Y值
-			FString YValue;
-			if (DataItem->TryGetStringField(PropertyMapping.YProperty, YValue))
-			{
-				UniqueYValues.Add(YValue);
-			}
-			else
-			{
-				double YNumeric = 0;
-				if (DataItem->TryGetNumberField(PropertyMapping.YProperty, YNumeric))
-				{
-					YValue = FString::Printf(TEXT("%g"), YNumeric);
-					UniqueYValues.Add(YValue);
-				}
-			}
-		}
-	}
-
-	// 转换为排序数组
-	TArray<FString> SortedXValues = UniqueXValues.Array();
-	TArray<FString> SortedYValues = UniqueYValues.Array();
-
-	// 自定义排序逻辑：如果是纯数字则按照数值排序，否则按照字符串排序
-	auto NumericSort = [](const FString& A, const FString& B) -> bool
-	{
-		// 检查是否都是数字
-		bool bAIsNumeric = true;
-		bool bBIsNumeric = true;
-		double ANumeric = 0.0;
-		double BNumeric = 0.0;
+	// 将命名数据转换为类型化数据，轴标签由转换器一并生成
+	FXVChartGridData GridData;
+	UXVDataConverter::ConvertNamedDataToGrid(NamedData, PropertyMapping.XProperty, PropertyMapping.YProperty,
+	                                         PropertyMapping.ZProperty, PropertyMapping.TimeProperty, GridData);
 
-		// 尝试将字符串转换为数字
-		if (A.IsNumeric() && B.IsNumeric())
-		{
-			ANumeric = FCString::Atod(*A);
-			BNumeric = FCString::Atod(*B);
-			// 按数值排序
-			return ANumeric < BNumeric;
-		}
-		// 否则使用默认的字符串排序
-		return A < B;
-	};
-
-	// 使用自定义排序逻辑
-	SortedXValues.Sort(NumericSort);
-	SortedYValues.Sort(NumericSort);
+	SetValueFromGrid(GridData);
+}
 
-	// 创建映射字典
-	TMap<FString, int32> XValueToIndex;
-	TMap<FString, int32> YValueToIndex;
+void AXVChartBase::SetValueFromGrid(const FXVChartGridData& GridData)
+{
+	InvalidateStatistics();
 
-	for (int32 i = 0; i < SortedXValues.Num(); i++)
+	// 存储轴标签，子类在此基础上填充各自的数据结构
+	if (GridData.XLabels.Num() > 0)
 	{
-		XValueToIndex.Add(SortedXValues[i], i);
+		XAxisLabels = GridData.XLabels;
 	}
-
-	for (int32 i = 0; i < SortedYValues.Num(); i++)
+	if (GridData.YLabels.Num() > 0)
 	{
-		YValueToIndex.Add(SortedYValues[i], i);
+		YAxisLabels = GridData.YLabels;
 	}
+}
 
-	// 存储轴标签
-	XAxisLabels = SortedXValues;
-	YAxisLabels = SortedYValues;
+bool AXVChartBase::ParseGridFromJsonArray(const TArray<TSharedPtr<FJsonValue>>& JsonArray, FXVChartGridData& OutGrid)
+{
+	OutGrid.Reset();
+	OutGrid.Reserve(JsonArray.Num(), true);
 
-	// 设置图表轴标签（根据图表类型）
-	FString ClassName = GetClass()->GetName();
-	if (ClassName.Contains(TEXT("BarChart")))
-	{
-		AXVBarChart* BarChart = Cast<AXVBarChart>(this);
-		if (BarChart)
-		{
-			BarChart->XTextArrs = SortedXValues;
-			BarChart->YTextArrs = SortedYValues;
-		}
-	}
-	else if (ClassName.Contains(TEXT("LineChart")))
+	FXVTimestampParser TimeParser;
+	bool bHasTime = false;
+	for (const TSharedPtr<FJsonValue>& Value3DJsonValue : JsonArray)
 	{
-		AXVLineChart* LineChart = Cast<AXVLineChart>(this);
-		if (LineChart)
+		const TArray<TSharedPtr<FJsonValue>>* Values = nullptr;
+		if (!Value3DJsonValue->TryGetArray(Values) || Values->Num() < 3)
 		{
-			LineChart->XText = SortedXValues;
-			LineChart->YText = SortedYValues;
+			UE_LOG(LogTemp, Warning, TEXT("AXVChartBase: 数据项格式错误，应为[y,x,z]或[y,x,z,time]"));
+			OutGrid.Reset();
+			return false;
 		}
-	}
 
-	// 将命名数据转换为图表所需的格式
-	TArray<TSharedPtr<FJsonValue>> ChartData;
-
-	for (const auto& DataItem : NamedData)
-	{
-		if (DataItem->HasField(PropertyMapping.XProperty) &&
-			DataItem->HasField(PropertyMapping.YProperty) &&
-			DataItem->HasField(PropertyMapping.ZProperty))
+		// 第四个值作为时间值，没有时使用索引作为默认时间
+		double Time = OutGrid.Num();
+		if (Values->Num() > 3)
 		{
-			// 获取X值和索引
-			FString XValue;
-			int32 XIndex = 0;
-
-			if (DataItem->TryGetStringField(PropertyMapping.XProperty, XValue))
-			{
-				XIndex = XValueToIndex.FindRef(XValue);
-			}
-			else
+			// 字符串形式的时间戳转换为Unix秒
+			FString TimeString;
+			int64 TimeTicks = 0;
+			if ((*Values)[3]->TryGetString(TimeString) && !TimeString.IsNumeric() && TimeParser.Parse(TimeString, TimeTicks))
 			{
-				double XNumeric = 0;
-				if (DataItem->TryGetNumberField(PropertyMapping.XProperty, XNumeric))
-				{
-					XValue = FString::Printf(TEXT("%g"), XNumeric);
-					XIndex = XValueToIndex.FindRef(XValue);
-				}
-			}
-
-			// 获取Y值和索引
-			FString YValue;
-			int32 YIndex = 0;
-
-			if (DataItem->TryGetStringField(PropertyMapping.YProperty, YValue))
-			{
-				YIndex = YValueToIndex.FindRef(YValue);
+				Time = FXVDataColumn::TimestampToUnixSeconds(TimeTicks);
 			}
 			else
 			{
-				double YNumeric = 0;
-				if (DataItem->TryGetNumberField(PropertyMapping.YProperty, YNumeric))
-				{
-					YValue = FString::Printf(TEXT("%g"), YNumeric);
-					YIndex = YValueToIndex.FindRef(YValue);
-				}
+				Time = (*Values)[3]->AsNumber();
 			}
-
-			// 获取Z值
-			double ZValue = 0;
-			DataItem->TryGetNumberField(PropertyMapping.ZProperty, ZValue);
-
-			// 创建图表数据项 [YIndex, XIndex, ZValue]
-			TArray<TSharedPtr<FJsonValue>> InnerArray;
-			InnerArray.Add(MakeShareable(new FJsonValueNumber(YIndex)));
-			InnerArray.Add(MakeShareable(new FJsonValueNumber(XIndex)));
-			InnerArray.Add(MakeShareable(new FJsonValueNumber(ZValue)));
-
-			ChartData.Add(MakeShareable(new FJsonValueArray(InnerArray)));
+			bHasTime = true;
 		}
-	}
 
-	// 将转换后的数据序列化为JSON字符串
-	FString FormattedData;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&FormattedData);
-	FJsonSerializer::Serialize(ChartData, Writer);
+		const int32 Y = (*Values)[0]->AsNumber();
+		const int32 X = (*Values)[1]->AsNumber();
+		const float V = (*Values)[2]->AsNumber();
+		OutGrid.Add(Y, X, V, Time);
+	}
 
-	// 使用原始SetValue方法处理
-	SetValue(FormattedData);
+	if (!bHasTime)
+	{
+		OutGrid.Times.Reset();
+	}
+	return true;
 }
 
 void AXVChartBase::GeneratePieSectionInfo(const FVector& CenterPosition, const size_t& SectionIndex,
@@ -767,6 +1139,11 @@ void AXVChartBase::GeneratePieSectionInfo(const FVector& CenterPosition, const s
 		return;
 	}
 
+	// 左右两个端面各两个三角形，每个角度步进的内外侧面、顶面和底面共八个三角形
+	const int32 NumSteps = static_cast<int32>((EndAngle - StartAngle + Step - 1) / Step);
+	const int32 NumVertices = (4 + NumSteps * 8) * FXVMeshBuilder::NumTriangleVertices;
+	FXVMeshBuilder Builder(SectionInfos[SectionIndex], NumVertices, NumVertices);
+
 	size_t CurrentAngle = StartAngle;
 
 	FXVPlaneInfo CurrentPlaneInfo;
@@ -775,9 +1152,7 @@ void AXVChartBase::GeneratePieSectionInfo(const FVector& CenterPosition, const s
 	// 单独处理一下左面
 	FVector LeftFaceNormal = (CurrentPlaneInfo.NearBottomVertexPosition - CurrentPlaneInfo.FarTopVertexPosition) ^ (
 		CurrentPlaneInfo.NearBottomVertexPosition - CurrentPlaneInfo.NearTopVertexPosition);
-	XVChartUtils::AddBaseTriangle(
-		SectionInfos,
-		SectionIndex,
+	Builder.AddTriangle(
 		CurrentPlaneInfo.NearBottomVertexPosition, CurrentPlaneInfo.NearTopVertexPosition,
 		CurrentPlaneInfo.FarTopVertexPosition,
 		LeftFaceNormal, LeftFaceNormal, LeftFaceNormal,
@@ -786,8 +1161,7 @@ void AXVChartBase::GeneratePieSectionInfo(const FVector& CenterPosition, const s
 		FVector2D(CurrentPlaneInfo.RadiansAngle * NearDis, Height),
 		FProcMeshTangent(0, 1, 0),
 		SectionColor);
-	XVChartUtils::AddBaseTriangle(
-		SectionInfos, SectionIndex,
+	Builder.AddTriangle(
 		CurrentPlaneInfo.NearBottomVertexPosition, CurrentPlaneInfo.FarTopVertexPosition,
 		CurrentPlaneInfo.FarBottomVertexPosition,
 		LeftFaceNormal, LeftFaceNormal, LeftFaceNormal,
@@ -808,8 +1182,7 @@ void AXVChartBase::GeneratePieSectionInfo(const FVector& CenterPosition, const s
 		XVChartUtils::CalcAnglePlaneInfo(CenterPosition, CurrentAngle, NearDis, FarDis, Height, NextPlaneInfo);
 
 		// near front face
-		XVChartUtils::AddBaseTriangle(
-			SectionInfos, SectionIndex,
+		Builder.AddTriangle(
 			NextPlaneInfo.NearBottomVertexPosition, NextPlaneInfo.NearTopVertexPosition,
 			CurrentPlaneInfo.NearTopVertexPosition,
 			-NextPlaneInfo.NearBottomNormal, -CurrentPlaneInfo.NearTopNormal, -NextPlaneInfo.NearTopNormal,
@@ -818,8 +1191,7 @@ void AXVChartBase::GeneratePieSectionInfo(const FVector& CenterPosition, const s
 			FVector2D(NextPlaneInfo.RadiansAngle * NearDis, Height),
 			FProcMeshTangent(0, 0, 1),
 			SectionColor);
-		XVChartUtils::AddBaseTriangle(
-			SectionInfos, SectionIndex,
+		Builder.AddTriangle(
 			CurrentPlaneInfo.NearTopVertexPosition, CurrentPlaneInfo.NearBottomVertexPosition,
 			NextPlaneInfo.NearBottomVertexPosition,
 			-NextPlaneInfo.NearBottomNormal, -CurrentPlaneInfo.NearBottomNormal, -CurrentPlaneInfo.NearTopNormal,
@@ -830,8 +1202,7 @@ void AXVChartBase::GeneratePieSectionInfo(const FVector& CenterPosition, const s
 			SectionColor);
 
 		// far back face
-		XVChartUtils::AddBaseTriangle(
-			SectionInfos, SectionIndex,
+		Builder.AddTriangle(
 			CurrentPlaneInfo.FarBottomVertexPosition, CurrentPlaneInfo.FarTopVertexPosition,
 			NextPlaneInfo.FarTopVertexPosition,
 			CurrentPlaneInfo.FarBottomNormal, NextPlaneInfo.FarBottomNormal, CurrentPlaneInfo.FarTopNormal,
@@ -840,8 +1211,7 @@ void AXVChartBase::GeneratePieSectionInfo(const FVector& CenterPosition, const s
 			FVector2D(CurrentPlaneInfo.RadiansAngle * FarDis, Height),
 			FProcMeshTangent(0, 0, 1),
 			SectionColor);
-		XVChartUtils::AddBaseTriangle(
-			SectionInfos, SectionIndex,
+		Builder.AddTriangle(
 			CurrentPlaneInfo.FarBottomVertexPosition, NextPlaneInfo.FarTopVertexPosition,
 			NextPlaneInfo.FarBottomVertexPosition,
 			NextPlaneInfo.FarBottomNormal, NextPlaneInfo.FarTopNormal, CurrentPlaneInfo.FarTopNormal,
@@ -852,8 +1222,7 @@ void AXVChartBase::GeneratePieSectionInfo(const FVector& CenterPosition, const s
 			SectionColor);
 
 		// Top Face
-		XVChartUtils::AddBaseTriangle(
-			SectionInfos, SectionIndex,
+		Builder.AddTriangle(
 			CurrentPlaneInfo.NearTopVertexPosition, NextPlaneInfo.NearTopVertexPosition,
 			CurrentPlaneInfo.FarTopVertexPosition,
 			FVector(0, Height, 0), FVector(0, Height, 0), FVector(0, Height, 0),
@@ -862,8 +1231,7 @@ void AXVChartBase::GeneratePieSectionInfo(const FVector& CenterPosition, const s
 			FVector2D(NextPlaneInfo.RadiansAngle * NearDis, Height),
 			FProcMeshTangent(1, 0, 0),
 			SectionColor);
-		XVChartUtils::AddBaseTriangle(
-			SectionInfos, SectionIndex,
+		Builder.AddTriangle(
 			NextPlaneInfo.NearTopVertexPosition, NextPlaneInfo.FarTopVertexPosition,
 			CurrentPlaneInfo.FarTopVertexPosition,
 			FVector(0, Height, 0), FVector(0, Height, 0), FVector(0, Height, 0),
@@ -874,8 +1242,7 @@ void AXVChartBase::GeneratePieSectionInfo(const FVector& CenterPosition, const s
 			SectionColor);
 
 		// Bottom Face
-		XVChartUtils::AddBaseTriangle(
-			SectionInfos, SectionIndex,
+		Builder.AddTriangle(
 			CurrentPlaneInfo.NearBottomVertexPosition, NextPlaneInfo.FarBottomVertexPosition,
 			NextPlaneInfo.NearBottomVertexPosition,
 			FVector(0, -Height, 0), FVector(0, -Height, 0), FVector(0, -Height, 0),
@@ -884,8 +1251,7 @@ void AXVChartBase::GeneratePieSectionInfo(const FVector& CenterPosition, const s
 			FVector2D(NextPlaneInfo.RadiansAngle * FarDis, 0),
 			FProcMeshTangent(1, 0, 0),
 			SectionColor);
-		XVChartUtils::AddBaseTriangle(
-			SectionInfos, SectionIndex,
+		Builder.AddTriangle(
 			CurrentPlaneInfo.NearBottomVertexPosition, CurrentPlaneInfo.FarBottomVertexPosition,
 			NextPlaneInfo.FarBottomVertexPosition,
 			FVector(0, -Height, 0), FVector(0, -Height, 0), FVector(0, -Height, 0),
@@ -901,8 +1267,7 @@ void AXVChartBase::GeneratePieSectionInfo(const FVector& CenterPosition, const s
 	// 特殊处理右边
 	FVector RightFaceNormal = (CurrentPlaneInfo.NearBottomVertexPosition - CurrentPlaneInfo.NearTopVertexPosition) ^ (
 		CurrentPlaneInfo.NearBottomVertexPosition - CurrentPlaneInfo.FarTopVertexPosition);
-	XVChartUtils::AddBaseTriangle(
-		SectionInfos, SectionIndex,
+	Builder.AddTriangle(
 		CurrentPlaneInfo.NearBottomVertexPosition, CurrentPlaneInfo.FarTopVertexPosition,
 		CurrentPlaneInfo.NearTopVertexPosition,
 		RightFaceNormal, RightFaceNormal, RightFaceNormal,
@@ -911,8 +1276,7 @@ void AXVChartBase::GeneratePieSectionInfo(const FVector& CenterPosition, const s
 		FVector2D(CurrentPlaneInfo.RadiansAngle * FarDis, Height),
 		FProcMeshTangent(0, 1, 0),
 		SectionColor);
-	XVChartUtils::AddBaseTriangle(
-		SectionInfos, SectionIndex,
+	Builder.AddTriangle(
 		CurrentPlaneInfo.NearBottomVertexPosition, CurrentPlaneInfo.FarBottomVertexPosition,
 		CurrentPlaneInfo.FarTopVertexPosition,
 		RightFaceNormal, RightFaceNormal, RightFaceNormal,
@@ -1044,6 +1408,7 @@ void AXVChartBase::SetEnableReferenceHighlight(bool bEnable)
 	else
 	{
 		// 禁用高亮时，恢复所有区域的默认颜色
+		ResetSectionStates();
 		for (int32 i = 0; i < DynamicMaterialInstances.Num(); i++)
 		{
 			if (DynamicMaterialInstances[i])
@@ -1144,66 +1509,40 @@ void AXVChartBase::RemoveStatisticalLine(int32 Index)
 
 float AXVChartBase::CalculateMean() const
 {
-	TArray<float> Values = GetAllDataValues();
-	if (Values.Num() == 0)
-	{
-		return 0.0f;
-	}
-
-	float Sum = 0.0f;
-	for (float Value : Values)
-	{
-		Sum += Value;
-	}
-
-	return Sum / Values.Num();
+	return GetStatistics().GetMean();
 }
 
 float AXVChartBase::CalculateMedian() const
 {
-	TArray<float> Values = GetAllDataValues();
-	if (Values.Num() == 0)
-	{
-		return 0.0f;
-	}
+	return GetStatistics().GetMedian();
+}
 
-	// 排序数组
-	Values.Sort();
+float AXVChartBase::CalculateMax() const
+{
+	return GetStatistics().GetMax();
+}
 
-	// 计算中位数
-	if (Values.Num() % 2 == 0)
-	{
-		// 偶数个元素，取中间两个值的平均
-		int32 MiddleIndex = Values.Num() / 2;
-		return (Values[MiddleIndex - 1] + Values[MiddleIndex]) / 2.0f;
-	}
-	else
-	{
-		// 奇数个元素，直接返回中间值
-		return Values[Values.Num() / 2];
-	}
+float AXVChartBase::CalculateMin() const
+{
+	return GetStatistics().GetMin();
 }
 
-float AXVChartBase::CalculateMax() const
+const FXVStatisticsCache& AXVChartBase::GetStatistics() const
 {
-	TArray<float> Values = GetAllDataValues();
-	if (Values.Num() == 0)
+	if (!bStatisticsValid)
 	{
-		return 0.0f;
+		StatisticsCache.Build(GetAllDataValues());
+		bStatisticsValid = true;
 	}
-
-	return FMath::Max(Values);
+	return StatisticsCache;
 }
 
-float AXVChartBase::CalculateMin() const
+void AXVChartBase::UpdateStatistics(float OldValue, float NewValue)
 {
-	TArray<float> Values = GetAllDataValues();
-	if (Values.Num() == 0)
+	if (bStatisticsValid)
 	{
-		return 0.0f;
+		StatisticsCache.Replace(OldValue, NewValue);
 	}
-
-	return FMath::Min(Values);
 }
 
 TArray<float> AXVChartBase::GetAllDataValues() const
@@ -1240,16 +1579,16 @@ void AXVChartBase::AutoAdjustZAxis(float MarginPercent)
 	ZAxisMarginPercent = FMath::Clamp(MarginPercent, 0.0f, 0.5f);
 	bAutoAdjustZAxis = true;
 
-	// 获取所有数据值
-	TArray<float> Values = GetAllDataValues();
-	if (Values.Num() == 0)
+	// 从统计缓存读取数据范围
+	const FXVStatisticsCache& Statistics = GetStatistics();
+	if (Statistics.IsEmpty())
 	{
 		return;
 	}
 
 	// 计算数据范围
-	float MinVal = FMath::Min(Values);
-	float MaxVal = FMath::Max(Values);
+	float MinVal = Statistics.GetMin();
+	float MaxVal = Statistics.GetMax();
 
 	// 如果最小值和最大值几乎相等，则进行特殊处理
 	if (FMath::IsNearlyEqual(MinVal, MaxVal, 0.001f))
@@ -1459,6 +1798,7 @@ void AXVChartBase::SetEnableValueTriggers(bool bEnable)
 	else
 	{
 		// 禁用触发条件时，恢复所有区域的默认颜色
+		ResetSectionStates();
 		for (int32 i = 0; i < DynamicMaterialInstances.Num(); i++)
 		{
 			if (DynamicMaterialInstances[i])
@@ -3,6 +3,7 @@
 #include "ProceduralMeshComponent.h"
 #include "Components/TextRenderComponent.h"
 #include "Kismet/KismetTextLibrary.h"
+#include "Async/ParallelFor.h"
 
 
 XVChartUtils::XVChartUtils()
@@ -13,81 +14,95 @@ XVChartUtils::~XVChartUtils()
 {
 }
 
-void XVChartUtils::AddBaseTriangle(TArray<FXVChartSectionInfo>& SectionInfos, 
-                                 const size_t SectionIndex, const FVector& InFirstPoint, const FVector& InSecondPoint,
-                                 const FVector& InThirdPoint,
-                                 const FVector& InFirstNormal, const FVector& InSecondNormal,
-                                 const FVector& InThirdNormal,
-                                 const FVector2D& InFirstUV, const FVector2D& InSecondUV, const FVector2D& InThirdUV,
-                                 const FProcMeshTangent& Tangent, const FColor& TriangleColor)
+namespace XVChartUtilsPrivate
 {
-	int FirstIndex = SectionInfos[SectionIndex].Vertices.Emplace(InFirstPoint);
-	int SecondIndex = SectionInfos[SectionIndex].Vertices.Emplace(InSecondPoint);
-	int ThirdIndex = SectionInfos[SectionIndex].Vertices.Emplace(InThirdPoint);
-	// 逆时针顺序
-	SectionInfos[SectionIndex].Indices.Emplace(FirstIndex);
-	SectionInfos[SectionIndex].Indices.Emplace(SecondIndex);
-	SectionInfos[SectionIndex].Indices.Emplace(ThirdIndex);
-	
-	SectionInfos[SectionIndex].Normals.Emplace(InFirstNormal);
-	SectionInfos[SectionIndex].Normals.Emplace(InSecondNormal);
-	SectionInfos[SectionIndex].Normals.Emplace(InThirdNormal);
+	/* 按确切数量扩展数组，返回新增部分的起始地址 */
+	template <typename T>
+	T* GrowExact(TArray<T>& Array, int32 Count)
+	{
+		const int32 Start = Array.Num();
+		Array.Reserve(Start + Count);
+		Array.AddUninitialized(Count);
+		return Array.GetData() + Start;
+	}
+}
 
-	SectionInfos[SectionIndex].UVs.Emplace(InFirstUV.ClampAxes(0., 1.));
-	SectionInfos[SectionIndex].UVs.Emplace(InSecondUV.ClampAxes(0., 1.));
-	SectionInfos[SectionIndex].UVs.Emplace(InThirdUV.ClampAxes(0., 1.));
+void FXVMeshBuilder::GetSphereCounts(int32 NumSphereSlices, int32 NumSphereStacks, int32& OutNumVertices, int32& OutNumIndices)
+{
+	const int32 ActualSlices = FMath::Max(3, NumSphereSlices);
+	const int32 ActualStacks = FMath::Max(2, NumSphereStacks);
+	OutNumVertices = (ActualStacks + 1) * (ActualSlices + 1);
+	OutNumIndices = ActualStacks * ActualSlices * 6;
+}
 
-	SectionInfos[SectionIndex].Tangents.Emplace(Tangent);
-	SectionInfos[SectionIndex].Tangents.Emplace(Tangent);
-	SectionInfos[SectionIndex].Tangents.Emplace(Tangent);
+FXVMeshBuilder::FXVMeshBuilder(FXVChartSectionInfo& InSection, int32 InNumVertices, int32 InNumIndices)
+	: Section(InSection)
+	, FirstVertex(InSection.Vertices.Num())
+	, NumVertices(InNumVertices)
+	, NumIndices(InNumIndices)
+{
+	using namespace XVChartUtilsPrivate;
+	Vertices = GrowExact(Section.Vertices, NumVertices);
+	Normals = GrowExact(Section.Normals, NumVertices);
+	UVs = GrowExact(Section.UVs, NumVertices);
+	Tangents = GrowExact(Section.Tangents, NumVertices);
+	VertexColors = GrowExact(Section.VertexColors, NumVertices);
+	Indices = GrowExact(Section.Indices, NumIndices);
+}
 
-	FLinearColor LinearColor = FLinearColor::FromSRGBColor(TriangleColor);
-	SectionInfos[SectionIndex].VertexColors.Emplace(LinearColor);
-	SectionInfos[SectionIndex].VertexColors.Emplace(LinearColor);
-	SectionInfos[SectionIndex].VertexColors.Emplace(LinearColor);
+FXVMeshBuilder::~FXVMeshBuilder()
+{
+	checkf(NumWrittenVertices == NumVertices && NumWrittenIndices == NumIndices,
+	       TEXT("Mesh builder reserved %d vertices and %d indices but wrote %d and %d"),
+	       NumVertices, NumIndices, NumWrittenVertices, NumWrittenIndices);
 }
 
-void XVChartUtils::AddBaseQuad(TArray<FXVChartSectionInfo>& SectionInfos, 
-                             const size_t SectionIndex, const FVector& InFirstPoint, const FVector& InSecondPoint,
-                             const FVector& InThirdPoint,
-                             const FVector& InFouthPoint, const FVector& InQuadNormal, const FVector2D& InFirstUV,
-                             const FVector2D& InSecondUV,
-                             const FVector2D& InThirdUV, const FVector2D& InFouthUV, const FProcMeshTangent& Tangent,
-                             const FColor& TriangleColor)
+int32 FXVMeshBuilder::WriteVertex(const FVector& Position, const FVector& Normal, const FVector2D& UV, const FProcMeshTangent& Tangent,
+                                  const FLinearColor& Color)
 {
-	AddBaseTriangle(SectionInfos, SectionIndex,
-		InFirstPoint, InSecondPoint, InThirdPoint,
-		InQuadNormal,InQuadNormal, InQuadNormal,
-		InFirstUV, InSecondUV, InThirdUV,
-		Tangent,
-		TriangleColor);
-	AddBaseTriangle(SectionInfos, SectionIndex,
-		InThirdPoint, InFouthPoint, InFirstPoint,
-		InQuadNormal,InQuadNormal, InQuadNormal,
-		InThirdUV, InFouthUV, InFirstUV,
-		Tangent,
-		TriangleColor);
+	check(NumWrittenVertices < NumVertices);
+	Vertices[NumWrittenVertices] = Position;
+	Normals[NumWrittenVertices] = Normal;
+	UVs[NumWrittenVertices] = UV;
+	Tangents[NumWrittenVertices] = Tangent;
+	VertexColors[NumWrittenVertices] = Color;
+	return FirstVertex + NumWrittenVertices++;
 }
 
-void XVChartUtils::CalcAnglePlaneInfo(const FVector& CenterPosition, const size_t& Angle, const float& PlaneNearDis,
-                                    const float& PlaneFarDis, const float& Height,
-                                    FXVPlaneInfo& OutPlaneInfo)
+void FXVMeshBuilder::WriteIndex(int32 Index)
 {
-	float CurrentRadians = FMath::DegreesToRadians(Angle);
-	OutPlaneInfo.RadiansAngle = CurrentRadians;
-	OutPlaneInfo.NearTopNormal = FVector(FMath::Cos(CurrentRadians), FMath::Sin(CurrentRadians), 0);
-	OutPlaneInfo.NearBottomNormal = OutPlaneInfo.NearTopNormal;
-	OutPlaneInfo.FarTopNormal = OutPlaneInfo.NearTopNormal;
-	OutPlaneInfo.FarBottomNormal = OutPlaneInfo.FarTopNormal;
-	OutPlaneInfo.NearBottomVertexPosition = CenterPosition + OutPlaneInfo.NearBottomNormal * PlaneNearDis;
-	OutPlaneInfo.NearTopVertexPosition = OutPlaneInfo.NearBottomVertexPosition + FVector(0, 0, Height);
-	OutPlaneInfo.FarBottomVertexPosition = CenterPosition + OutPlaneInfo.FarBottomNormal * PlaneFarDis;
-	OutPlaneInfo.FarTopVertexPosition = OutPlaneInfo.FarBottomVertexPosition + FVector(0, 0, Height);
+	check(NumWrittenIndices < NumIndices);
+	Indices[NumWrittenIndices++] = Index;
 }
 
-void XVChartUtils::CreateBox(TArray<FXVChartSectionInfo>& SectionInfos,
-						  const int& SectionIndex, const FVector& InPosition,
-						  const float& InLength, const float& InWidth, const float& InHeight, const float& InNextHeight,const FColor& InColor)
+void FXVMeshBuilder::AddTriangle(const FVector& InFirstPoint, const FVector& InSecondPoint, const FVector& InThirdPoint,
+                                 const FVector& InFirstNormal, const FVector& InSecondNormal, const FVector& InThirdNormal,
+                                 const FVector2D& InFirstUV, const FVector2D& InSecondUV, const FVector2D& InThirdUV,
+                                 const FProcMeshTangent& Tangent, const FColor& TriangleColor)
+{
+	const FLinearColor LinearColor = FLinearColor::FromSRGBColor(TriangleColor);
+	// 逆时针顺序
+	WriteIndex(WriteVertex(InFirstPoint, InFirstNormal, InFirstUV.ClampAxes(0., 1.), Tangent, LinearColor));
+	WriteIndex(WriteVertex(InSecondPoint, InSecondNormal, InSecondUV.ClampAxes(0., 1.), Tangent, LinearColor));
+	WriteIndex(WriteVertex(InThirdPoint, InThirdNormal, InThirdUV.ClampAxes(0., 1.), Tangent, LinearColor));
+}
+
+void FXVMeshBuilder::AddQuad(const FVector& InFirstPoint, const FVector& InSecondPoint, const FVector& InThirdPoint, const FVector& InFouthPoint,
+                             const FVector& InQuadNormal,
+                             const FVector2D& InFirstUV, const FVector2D& InSecondUV, const FVector2D& InThirdUV, const FVector2D& InFouthUV,
+                             const FProcMeshTangent& Tangent, const FColor& TriangleColor)
+{
+	AddTriangle(InFirstPoint, InSecondPoint, InThirdPoint,
+	            InQuadNormal, InQuadNormal, InQuadNormal,
+	            InFirstUV, InSecondUV, InThirdUV,
+	            Tangent, TriangleColor);
+	AddTriangle(InThirdPoint, InFouthPoint, InFirstPoint,
+	            InQuadNormal, InQuadNormal, InQuadNormal,
+	            InThirdUV, InFouthUV, InFirstUV,
+	            Tangent, TriangleColor);
+}
+
+void FXVMeshBuilder::AddBox(const FVector& InPosition, float InLength, float InWidth, float InHeight, float InNextHeight, const FColor& InColor)
 {
 	FVector Position0 = FVector(0, InWidth, 0) + InPosition;
 	FVector Position1 = FVector(InLength, InWidth, 0) + InPosition;
@@ -103,36 +118,37 @@ void XVChartUtils::CreateBox(TArray<FXVChartSectionInfo>& SectionInfos,
 	FVector LeftNormal(-1, 0, 0);
 
 	// front
-	AddBaseQuad(SectionInfos, SectionIndex, Position4, Position0, Position1, Position5, FrontNormal,
-	            {0, 0}, {0, 1}, {1, 1}, {1, 0}, FProcMeshTangent(1, 0, 0), InColor);
+	AddQuad(Position4, Position0, Position1, Position5, FrontNormal,
+	        {0, 0}, {0, 1}, {1, 1}, {1, 0}, FProcMeshTangent(1, 0, 0), InColor);
 	// back
-	AddBaseQuad(SectionInfos, SectionIndex, Position6, Position2, Position3, Position7, -FrontNormal,
-	            {0, 0}, {0, 1}, {1, 1}, {1, 0}, FProcMeshTangent(1, 0, 0), InColor);
+	AddQuad(Position6, Position2, Position3, Position7, -FrontNormal,
+	        {0, 0}, {0, 1}, {1, 1}, {1, 0}, FProcMeshTangent(1, 0, 0), InColor);
 	// left
-	AddBaseQuad(SectionInfos,SectionIndex, Position7, Position3, Position0, Position4, LeftNormal,
-	            {0, 0}, {0, 1}, {1, 1}, {1, 0}, FProcMeshTangent(0, 0, 1), InColor);
+	AddQuad(Position7, Position3, Position0, Position4, LeftNormal,
+	        {0, 0}, {0, 1}, {1, 1}, {1, 0}, FProcMeshTangent(0, 0, 1), InColor);
 	// right
-	AddBaseQuad(SectionInfos, SectionIndex, Position5, Position1, Position2, Position6, -LeftNormal,
-	            {0, 0}, {0, 1}, {1, 1}, {1, 0}, FProcMeshTangent(0, 0, 1), InColor);
+	AddQuad(Position5, Position1, Position2, Position6, -LeftNormal,
+	        {0, 0}, {0, 1}, {1, 1}, {1, 0}, FProcMeshTangent(0, 0, 1), InColor);
 	// up
-	AddBaseQuad(SectionInfos,  SectionIndex, Position7, Position4, Position5, Position6, UpNormal, {0, 0},
-	            {0, 1}, {1, 1}, {1, 0}, FProcMeshTangent(0, 1, 0), InColor);
+	AddQuad(Position7, Position4, Position5, Position6, UpNormal,
+	        {0, 0}, {0, 1}, {1, 1}, {1, 0}, FProcMeshTangent(0, 1, 0), InColor);
 	// down
-	AddBaseQuad(SectionInfos, SectionIndex, Position3, Position0, Position1, Position2, -UpNormal, {0, 0},
-				{0, 1}, {1, 1}, {1, 0}, FProcMeshTangent(0, 1, 0), InColor);
+	AddQuad(Position3, Position0, Position1, Position2, -UpNormal,
+	        {0, 0}, {0, 1}, {1, 1}, {1, 0}, FProcMeshTangent(0, 1, 0), InColor);
 }
 
-void XVChartUtils::CreateSphere(TArray<FXVChartSectionInfo>& SectionInfos, const int& SectionIndex,
-	const FVector& InPosition, const float& SphereRadius, const int& NumSphereSlices, const int& NumSphereStacks,
-	const FColor& InColor)
+void FXVMeshBuilder::AddSphere(const FVector& InPosition, float SphereRadius, int32 NumSphereSlices, int32 NumSphereStacks, const FColor& InColor)
 {
 	// 至少需要3个切片和2个堆栈才能形成有效的球体
 	const int32 ActualSlices = FMath::Max(3, NumSphereSlices);
 	const int32 ActualStacks = FMath::Max(2, NumSphereStacks);
-	
+
 	FProcMeshTangent Tangent(0, 1, 0); // 默认切线
 	FLinearColor LinearColor = FLinearColor::FromSRGBColor(InColor);
-	
+
+	// 同一网格段中可能已有其他图元，索引从球体第一个顶点开始
+	const int32 SphereFirstVertex = FirstVertex + NumWrittenVertices;
+
 	// 计算球体顶点
 	for (int32 StackIndex = 0; StackIndex <= ActualStacks; ++StackIndex)
 	{
@@ -140,61 +156,175 @@ void XVChartUtils::CreateSphere(TArray<FXVChartSectionInfo>& SectionInfos, const
 		const float Phi = StackIndex * PI / ActualStacks;
 		const float SinPhi = FMath::Sin(Phi);
 		const float CosPhi = FMath::Cos(Phi);
-		
+
 		for (int32 SliceIndex = 0; SliceIndex <= ActualSlices; ++SliceIndex)
 		{
 			// 计算theta角 (0 到 2*Pi，围绕赤道)
 			const float Theta = SliceIndex * 2.0f * PI / ActualSlices;
 			const float SinTheta = FMath::Sin(Theta);
 			const float CosTheta = FMath::Cos(Theta);
-			
+
 			// 计算球面上的点
-			FVector VertexPosition(SphereRadius * SinPhi * CosTheta,SphereRadius * SinPhi * SinTheta,SphereRadius * CosPhi);
-			
+			FVector VertexPosition(SphereRadius * SinPhi * CosTheta, SphereRadius * SinPhi * SinTheta, SphereRadius * CosPhi);
+
 			// 添加世界位置偏移
 			VertexPosition += InPosition;
-			
+
 			// 计算该点的法线 (从球心指向顶点的单位向量)
 			FVector Normal = (VertexPosition - InPosition).GetSafeNormal();
-			
+
 			// 计算UV坐标
-			FVector2D UV(static_cast<float>(SliceIndex) / ActualSlices,static_cast<float>(StackIndex) / ActualStacks);
-			
-			// 添加顶点
-			int32 VertexIndex = SectionInfos[SectionIndex].Vertices.Emplace(VertexPosition);
-			SectionInfos[SectionIndex].Normals.Emplace(Normal);
-			SectionInfos[SectionIndex].UVs.Emplace(UV);
-			SectionInfos[SectionIndex].Tangents.Emplace(Tangent);
-			SectionInfos[SectionIndex].VertexColors.Emplace(LinearColor);
+			FVector2D UV(static_cast<float>(SliceIndex) / ActualSlices, static_cast<float>(StackIndex) / ActualStacks);
+
+			WriteVertex(VertexPosition, Normal, UV, Tangent, LinearColor);
 		}
 	}
-	
+
 	// 生成三角形索引
 	for (int32 StackIndex = 0; StackIndex < ActualStacks; ++StackIndex)
 	{
 		for (int32 SliceIndex = 0; SliceIndex < ActualSlices; ++SliceIndex)
 		{
 			// 计算当前栈中此切片的顶点索引
-			const int32 CurrentRow = StackIndex * (ActualSlices + 1);
-			const int32 NextRow = (StackIndex + 1) * (ActualSlices + 1);
-			
+			const int32 CurrentRow = SphereFirstVertex + StackIndex * (ActualSlices + 1);
+			const int32 NextRow = SphereFirstVertex + (StackIndex + 1) * (ActualSlices + 1);
+
 			const int32 CurrentVertex = CurrentRow + SliceIndex;
 			const int32 NextRowVertex = NextRow + SliceIndex;
-			
+
 			// 添加两个三角形以形成四边形面
 			// 三角形1
-			SectionInfos[SectionIndex].Indices.Add(CurrentVertex);
-			SectionInfos[SectionIndex].Indices.Add(NextRowVertex);
-			SectionInfos[SectionIndex].Indices.Add(NextRowVertex + 1);
-			
+			WriteIndex(CurrentVertex);
+			WriteIndex(NextRowVertex);
+			WriteIndex(NextRowVertex + 1);
+
 			// 三角形2
-			SectionInfos[SectionIndex].Indices.Add(CurrentVertex);
-			SectionInfos[SectionIndex].Indices.Add(NextRowVertex + 1);
-			SectionInfos[SectionIndex].Indices.Add(CurrentVertex + 1);
+			WriteIndex(CurrentVertex);
+			WriteIndex(NextRowVertex + 1);
+			WriteIndex(CurrentVertex + 1);
 		}
 	}
 }
 
+void XVChartUtils::AddBaseTriangle(TArray<FXVChartSectionInfo>& SectionInfos, 
+                                 const size_t SectionIndex, const FVector& InFirstPoint, const FVector& InSecondPoint,
+                                 const FVector& InThirdPoint,
+                                 const FVector& InFirstNormal, const FVector& InSecondNormal,
+                                 const FVector& InThirdNormal,
+                                 const FVector2D& InFirstUV, const FVector2D& InSecondUV, const FVector2D& InThirdUV,
+                                 const FProcMeshTangent& Tangent, const FColor& TriangleColor)
+{
+	FXVMeshBuilder Builder(SectionInfos[SectionIndex], FXVMeshBuilder::NumTriangleVertices, FXVMeshBuilder::NumTriangleVertices);
+	Builder.AddTriangle(InFirstPoint, InSecondPoint, InThirdPoint,
+	                    InFirstNormal, InSecondNormal, InThirdNormal,
+	                    InFirstUV, InSecondUV, InThirdUV,
+	                    Tangent, TriangleColor);
+}
+
+void XVChartUtils::AddBaseQuad(TArray<FXVChartSectionInfo>& SectionInfos, 
+                             const size_t SectionIndex, const FVector& InFirstPoint, const FVector& InSecondPoint,
+                             const FVector& InThirdPoint,
+                             const FVector& InFouthPoint, const FVector& InQuadNormal, const FVector2D& InFirstUV,
+                             const FVector2D& InSecondUV,
+                             const FVector2D& InThirdUV, const FVector2D& InFouthUV, const FProcMeshTangent& Tangent,
+                             const FColor& TriangleColor)
+{
+	FXVMeshBuilder Builder(SectionInfos[SectionIndex], FXVMeshBuilder::NumQuadVertices, FXVMeshBuilder::NumQuadVertices);
+	Builder.AddQuad(InFirstPoint, InSecondPoint, InThirdPoint, InFouthPoint, InQuadNormal,
+	                InFirstUV, InSecondUV, InThirdUV, InFouthUV,
+	                Tangent, TriangleColor);
+}
+
+void XVChartUtils::CalcAnglePlaneInfo(const FVector& CenterPosition, const size_t& Angle, const float& PlaneNearDis,
+                                    const float& PlaneFarDis, const float& Height,
+                                    FXVPlaneInfo& OutPlaneInfo)
+{
+	float CurrentRadians = FMath::DegreesToRadians(Angle);
+	OutPlaneInfo.RadiansAngle = CurrentRadians;
+	OutPlaneInfo.NearTopNormal = FVector(FMath::Cos(CurrentRadians), FMath::Sin(CurrentRadians), 0);
+	OutPlaneInfo.NearBottomNormal = OutPlaneInfo.NearTopNormal;
+	OutPlaneInfo.FarTopNormal = OutPlaneInfo.NearTopNormal;
+	OutPlaneInfo.FarBottomNormal = OutPlaneInfo.FarTopNormal;
+	OutPlaneInfo.NearBottomVertexPosition = CenterPosition + OutPlaneInfo.NearBottomNormal * PlaneNearDis;
+	OutPlaneInfo.NearTopVertexPosition = OutPlaneInfo.NearBottomVertexPosition + FVector(0, 0, Height);
+	OutPlaneInfo.FarBottomVertexPosition = CenterPosition + OutPlaneInfo.FarBottomNormal * PlaneFarDis;
+	OutPlaneInfo.FarTopVertexPosition = OutPlaneInfo.FarBottomVertexPosition + FVector(0, 0, Height);
+}
+
+void XVChartUtils::CreateBox(TArray<FXVChartSectionInfo>& SectionInfos,
+						  const int& SectionIndex, const FVector& InPosition,
+						  const float& InLength, const float& InWidth, const float& InHeight, const float& InNextHeight,const FColor& InColor)
+{
+	FXVMeshBuilder Builder(SectionInfos[SectionIndex], FXVMeshBuilder::NumBoxVertices, FXVMeshBuilder::NumBoxVertices);
+	Builder.AddBox(InPosition, InLength, InWidth, InHeight, InNextHeight, InColor);
+}
+
+void XVChartUtils::CreateSphere(TArray<FXVChartSectionInfo>& SectionInfos, const int& SectionIndex,
+	const FVector& InPosition, const float& SphereRadius, const int& NumSphereSlices, const int& NumSphereStacks,
+	const FColor& InColor)
+{
+	int32 NumVertices = 0;
+	int32 NumIndices = 0;
+	FXVMeshBuilder::GetSphereCounts(NumSphereSlices, NumSphereStacks, NumVertices, NumIndices);
+	FXVMeshBuilder Builder(SectionInfos[SectionIndex], NumVertices, NumIndices);
+	Builder.AddSphere(InPosition, SphereRadius, NumSphereSlices, NumSphereStacks, InColor);
+}
+
+void XVChartUtils::MergeSectionInfos(TConstArrayView<FXVChartSectionInfo> Parts, FXVChartSectionInfo& OutMerged, TArray<int32>* OutVertexStarts)
+{
+	TArray<int32> VertexStarts;
+	TArray<int32> IndexStarts;
+	VertexStarts.SetNumUninitialized(Parts.Num());
+	IndexStarts.SetNumUninitialized(Parts.Num());
+	int32 NumVertices = 0;
+	int32 NumIndices = 0;
+	bool bHasUV1 = false;
+	for (int32 PartIndex = 0; PartIndex < Parts.Num(); ++PartIndex)
+	{
+		VertexStarts[PartIndex] = NumVertices;
+		IndexStarts[PartIndex] = NumIndices;
+		NumVertices += Parts[PartIndex].Vertices.Num();
+		NumIndices += Parts[PartIndex].Indices.Num();
+		bHasUV1 |= Parts[PartIndex].UV1.Num() > 0;
+	}
+
+	// 各顶点属性与顶点一一对应
+	OutMerged.Vertices.SetNumUninitialized(NumVertices);
+	OutMerged.Normals.SetNumUninitialized(NumVertices);
+	OutMerged.UVs.SetNumUninitialized(NumVertices);
+	OutMerged.Tangents.SetNumUninitialized(NumVertices);
+	OutMerged.VertexColors.SetNumUninitialized(NumVertices);
+	OutMerged.UV1.SetNumZeroed(bHasUV1 ? NumVertices : 0);
+	OutMerged.Indices.SetNumUninitialized(NumIndices);
+
+	ParallelFor(Parts.Num(), [&](int32 PartIndex)
+	{
+		const FXVChartSectionInfo& Part = Parts[PartIndex];
+		const int32 VertexStart = VertexStarts[PartIndex];
+		const int32 NumPartVertices = Part.Vertices.Num();
+		FMemory::Memcpy(OutMerged.Vertices.GetData() + VertexStart, Part.Vertices.GetData(), NumPartVertices * sizeof(FVector));
+		FMemory::Memcpy(OutMerged.Normals.GetData() + VertexStart, Part.Normals.GetData(), NumPartVertices * sizeof(FVector));
+		FMemory::Memcpy(OutMerged.UVs.GetData() + VertexStart, Part.UVs.GetData(), NumPartVertices * sizeof(FVector2D));
+		FMemory::Memcpy(OutMerged.Tangents.GetData() + VertexStart, Part.Tangents.GetData(), NumPartVertices * sizeof(FProcMeshTangent));
+		FMemory::Memcpy(OutMerged.VertexColors.GetData() + VertexStart, Part.VertexColors.GetData(), NumPartVertices * sizeof(FLinearColor));
+		if (bHasUV1 && Part.UV1.Num() == NumPartVertices)
+		{
+			FMemory::Memcpy(OutMerged.UV1.GetData() + VertexStart, Part.UV1.GetData(), NumPartVertices * sizeof(FVector2D));
+		}
+
+		int32* Indices = OutMerged.Indices.GetData() + IndexStarts[PartIndex];
+		for (int32 Index = 0; Index < Part.Indices.Num(); ++Index)
+		{
+			Indices[Index] = Part.Indices[Index] + VertexStart;
+		}
+	});
+
+	if (OutVertexStarts)
+	{
+		*OutVertexStarts = MoveTemp(VertexStarts);
+	}
+}
+
 UTextRenderComponent* XVChartUtils::CreateTextRenderComponent(UObject* Outer, const FText& Text, FColor Color, bool bVisible)
 {
 	UTextRenderComponent* Label = NewObject<UTextRenderComponent>(Outer, UTextRenderComponent::StaticClass());
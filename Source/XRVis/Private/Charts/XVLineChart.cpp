@@ -1,6 +1,10 @@
 ﻿// Fill out your copyright notice in the Description page of Project Settings.
 
 #include "Charts/XVLineChart.h"
+#include "DataProcessing/XVDataConverter.h"
+#include "DataProcessing/XVDownsampler.h"
+#include "Async/ParallelFor.h"
+#include "Algo/BinarySearch.h"
 
 #include "Charts/XVChartAxis.h"
 #include "Components/TextRenderComponent.h"
@@ -8,6 +12,23 @@
 #include "PhysicsEngine/ShapeElem.h"
 #include "ProceduralMeshComponent.h"
 
+namespace XVLineChartPrivate
+{
+	/* 第一遍确定的一个线段或数据点，第二遍并行生成其几何 */
+	struct FLineBuildItem
+	{
+		int32 LODIndex;
+		int32 RowIndex;
+		int32 ColIndex;
+		/* 线段连接到的下一个保留点所在的列，不连接时与ColIndex相同 */
+		int32 NextColIndex;
+		/* 逐线段网格段模式下的网格段下标 */
+		int32 SectionIndex;
+		/* 在该级LOD中的序号 */
+		int32 PointIndex;
+	};
+}
+
 // Sets default values
 AXVLineChart::AXVLineChart()
 {
@@ -29,6 +50,12 @@ AXVLineChart::AXVLineChart()
 	NumSphereSlices = 32;
 	NumSphereStacks = 16;
 
+	LODMethod = ELineChartLODMethod::LTTB;
+	LODReductionFactor = 2.f;
+
+	StreamingCapacity = 512;
+	StreamingTimeScale = 20.f;
+
 	// 默认顶点颜色数组
 	Colors.Add(FColor::FromHex("#313695"));
 	Colors.Add(FColor::FromHex("#4575b4"));
@@ -61,42 +88,45 @@ void AXVLineChart::NotifyActorOnClicked(FKey ButtonPressed)
 	{
 		FVector Result = GetCursorHitRowAndColAndHeight(HitResult);
 
-		int CurrentRow = Result.Y / (YAxisInterval * GetActorScale().Y);
+		const int32 CurrentRow = FMath::FloorToInt32(Result.Y / (YAxisInterval * GetActorScale().Y));
+		if (!LineSelection.IsValidIndex(CurrentRow))
+		{
+			return;
+		}
 		LineSelection[CurrentRow] = !LineSelection[CurrentRow];
 
-		for (size_t col = 0; col < ColCounts; col++)
+		for (int32 col = 0; col < ColCounts; col++)
 		{
-			int CurrentIndex = CurrentRow * ColCounts + col;
-			if (CurrentIndex < TotalCountOfValue)
+			const int32 CurrentIndex = GetCellSection(CurrentRow, col);
+			if (CurrentIndex != INDEX_NONE)
 			{
 				if (!LineSelection[CurrentRow])
 				{
-					ProceduralMeshComponent->ClearMeshSection(CurrentIndex);
-					DynamicMaterialInstances[CurrentIndex]->SetScalarParameterValue(
-						"EmissiveIntensity", 0);
-					ProceduralMeshComponent->SetMaterial(
-						CurrentIndex, DynamicMaterialInstances[CurrentIndex]);
-					ProceduralMeshComponent->CreateMeshSection_LinearColor(
-						CurrentIndex, SectionInfos[CurrentIndex].Vertices,
-						SectionInfos[CurrentIndex].Indices,
-						SectionInfos[CurrentIndex].Normals,
-						SectionInfos[CurrentIndex].UVs,
-						SectionInfos[CurrentIndex].VertexColors,
-						SectionInfos[CurrentIndex].Tangents, true);
+					if (HasSectionStates())
+					{
+						SetSectionStateIntensity(CurrentIndex, 0);
+					}
+					else
+					{
+						ClearMeshSection(CurrentIndex);
+						DynamicMaterialInstances[CurrentIndex]->SetScalarParameterValue(
+							"EmissiveIntensity", 0);
+						GetSectionMeshComponent()->SetMaterial(
+							CurrentIndex, DynamicMaterialInstances[CurrentIndex]);
+						DrawMeshSection(CurrentIndex);
+					}
 					LabelComponents[CurrentIndex]->SetVisibility(false);
 					LabelComponents[CurrentIndex]->MarkRenderStateDirty();
 					TotalSelection[CurrentIndex] = false;
 				}
 				else
 				{
-					ProceduralMeshComponent->ClearMeshSection(CurrentIndex);
-					ProceduralMeshComponent->CreateMeshSection_LinearColor(
-						CurrentIndex, SectionInfos[CurrentIndex].Vertices,
-						SectionInfos[CurrentIndex].Indices,
-						SectionInfos[CurrentIndex].Normals,
-						SectionInfos[CurrentIndex].UVs,
-						SectionInfos[CurrentIndex].VertexColors,
-						SectionInfos[CurrentIndex].Tangents, true);
+					// 合并网格段模式下选中只保留当前的发光状态，不需要重建网格段
+					if (!HasSectionStates())
+					{
+						ClearMeshSection(CurrentIndex);
+						DrawMeshSection(CurrentIndex);
+					}
 					TotalSelection[CurrentIndex] = true;
 				}
 			}
@@ -114,27 +144,23 @@ void AXVLineChart::UpdateOnMouseEnterOrLeft()
 		{
 			FVector Result = GetCursorHitRowAndColAndHeight(HitResult);
 
-			int CurrentRow = Result.Y / (YAxisInterval * GetActorScale().Y);
-			int CurrentCol = Result.X / (XAxisInterval * GetActorScale().X);
-			int CurrentIndex = CurrentRow * ColCounts + CurrentCol;
+			const int32 CurrentRow = FMath::FloorToInt32(Result.Y / (YAxisInterval * GetActorScale().Y));
+			const int32 CurrentCol = FMath::FloorToInt32(Result.X / (XAxisInterval * GetActorScale().X));
+			const int32 CurrentIndex = GetCellSection(CurrentRow, CurrentCol);
 
-			if (CurrentIndex < TotalCountOfValue)
+			if (CurrentIndex != INDEX_NONE)
 			{
 				if (HoveredIndex != -1 && HoveredIndex != CurrentIndex &&
 					!TotalSelection[HoveredIndex])
 				{
-					DynamicMaterialInstances[HoveredIndex]->SetScalarParameterValue(
-						"EmissiveIntensity", 0);
-					UpdateMeshSection(HoveredIndex);
+					SetPointEmissiveIntensity(HoveredIndex, 0);
 					LabelComponents[HoveredIndex]->SetVisibility(false);
 					LabelComponents[HoveredIndex]->MarkRenderStateDirty();
 				}
 				if (HoveredIndex != CurrentIndex && !TotalSelection[CurrentIndex])
 				{
 					HoveredIndex = CurrentIndex;
-					DynamicMaterialInstances[HoveredIndex]->SetScalarParameterValue(
-						"EmissiveIntensity", EmissiveIntensity);
-					UpdateMeshSection(HoveredIndex);
+					SetPointEmissiveIntensity(HoveredIndex, EmissiveIntensity);
 
 					FRotator CamRotation = GetWorld()
 					                       ->GetFirstPlayerController()
@@ -167,18 +193,20 @@ void AXVLineChart::UpdateOnMouseEnterOrLeft()
 	{
 		if (HoveredIndex != -1 && !TotalSelection[HoveredIndex])
 		{
-			ProceduralMeshComponent->ClearMeshSection(HoveredIndex);
-			DynamicMaterialInstances[HoveredIndex]->SetScalarParameterValue(
-				"EmissiveIntensity", 0);
-			ProceduralMeshComponent->SetMaterial(
-				HoveredIndex, DynamicMaterialInstances[HoveredIndex]);
-
-			ProceduralMeshComponent->CreateMeshSection_LinearColor(
-				HoveredIndex, SectionInfos[HoveredIndex].Vertices,
-				SectionInfos[HoveredIndex].Indices,
-				SectionInfos[HoveredIndex].Normals, SectionInfos[HoveredIndex].UVs,
-				SectionInfos[HoveredIndex].VertexColors,
-				SectionInfos[HoveredIndex].Tangents, true);
+			if (HasSectionStates())
+			{
+				SetSectionStateIntensity(HoveredIndex, 0);
+			}
+			else
+			{
+				ClearMeshSection(HoveredIndex);
+				DynamicMaterialInstances[HoveredIndex]->SetScalarParameterValue(
+					"EmissiveIntensity", 0);
+				GetSectionMeshComponent()->SetMaterial(
+					HoveredIndex, DynamicMaterialInstances[HoveredIndex]);
+
+				DrawMeshSection(HoveredIndex);
+			}
 			LabelComponents[HoveredIndex]->SetVisibility(false);
 			LabelComponents[HoveredIndex]->MarkRenderStateDirty();
 			HoveredIndex = -1;
@@ -247,17 +275,11 @@ void AXVLineChart::Create3DLineChart(const FString& Data,
 void AXVLineChart::SetValue(const FString& InValue)
 {
 	if (InValue.IsEmpty()) return;
-	XYZs.Empty();
-	// 清空时间数据
-	TimeData.Empty();
 
 	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(InValue);
 
-	TArray<TSharedPtr<FJsonValue>> Value3DJsonValueArray;
+	FXVChartGridData GridData;
 
-	TotalCountOfValue = 0;
-	bool bHasTimeProperty = false;
-	
 	// 尝试判断数据格式
 	TSharedPtr<FJsonValue> JsonValue;
 	if (FJsonSerializer::Deserialize(Reader, JsonValue) && JsonValue.IsValid())
@@ -265,7 +287,7 @@ void AXVLineChart::SetValue(const FString& InValue)
 		// 检查是否为数组格式
 		if (JsonValue->Type == EJson::Array)
 		{
-			TArray<TSharedPtr<FJsonValue>> JsonArray = JsonValue->AsArray();
+			const TArray<TSharedPtr<FJsonValue>>& JsonArray = JsonValue->AsArray();
 			
 			// 如果数组为空，直接返回
 			if (JsonArray.Num() == 0)
@@ -291,83 +313,89 @@ void AXVLineChart::SetValue(const FString& InValue)
 				ParseNamedDataWithTime(NamedData);
 				return;
 			}
+
+			// 原始格式 [[y,x,z(,time)], ...]，复用已解析的DOM
+			if (!ParseGridFromJsonArray(JsonArray, GridData))
+				return;
 		}
 	}
-	
-	// 如果不是命名对象格式，回退到原始格式处理 [[y,x,z], ...]
-	Reader = TJsonReaderFactory<>::Create(InValue);
-	if (FJsonSerializer::Deserialize(Reader, Value3DJsonValueArray))
+
+	SetValueFromGrid(GridData);
+}
+
+void AXVLineChart::SetValueFromGrid(const FXVChartGridData& GridData)
+{
+	Super::SetValueFromGrid(GridData);
+
+	if (GridData.XLabels.Num() > 0)
 	{
-		for (const TSharedPtr<FJsonValue>& Value3DJsonValue :
-		     Value3DJsonValueArray)
-		{
-			TArray<TSharedPtr<FJsonValue>> Values = Value3DJsonValue->AsArray();
+		XText = GridData.XLabels;
+	}
+	if (GridData.YLabels.Num() > 0)
+	{
+		YText = GridData.YLabels;
+	}
 
-			if (Values.Num() < 3) return;
-			int Y = Values[0]->AsNumber();
-			int X = Values[1]->AsNumber();
-			int V = Values[2]->AsNumber();
-			
-			// 检查是否有第四个值作为时间值
-			float Time = 0.0f;
-			if (Values.Num() > 3)
-			{
-				Time = Values[3]->AsNumber();
-				bHasTimeProperty = true;
-			}
-			else
-			{
-				// 如果没有时间值，使用索引作为默认时间
-				Time = TotalCountOfValue;
-			}
+	ValueGrid.Build(GridData, true);
+	// 单元格与网格段的对应关系在生成网格时重建
+	CellSections.Reset();
 
-			MaxX = FMath::Max(MaxX, X);
-			MinX = FMath::Min(MinX, X);
-			MaxY = FMath::Max(MaxY, Y);
-			MinY = FMath::Min(MinY, Y);
-			MaxZ = FMath::Max(MaxZ, V);
-			MinZ = FMath::Min(MinZ, V);
+	// 清空时间数据
+	TimeData.Empty(GridData.Num());
 
-			if (XYZs.Contains(Y))
-			{
-				XYZs[Y].Add(X, V);
-			}
-			else
-			{
-				TMap<int, int> M;
-				M.Add(X, V);
-				XYZs.Add(Y, M);
-			}
-			ColCounts = FMath::Max(ColCounts, XYZs[Y].Num());
-			TotalCountOfValue++;
-			
-			// 保存数据点的索引和值，用于时间轴功能
-			FXVTimeDataPoint TimePoint;
-			TimePoint.RowIndex = Y;
-			TimePoint.ColIndex = X;
-			TimePoint.Value = V;
-			TimePoint.TimeValue = Time;
-			TimePoint.SortKey = bHasTimeProperty ? 0 : (Y * 1000 + X); // 有时间值时不使用排序键
-			TimeData.Add(TimePoint);
-		}
-		
-		// 对时间数据进行排序
-		if (bHasTimeProperty)
-		{
-			// 如果有时间属性，按时间值排序
-			TimeData.Sort([](const FXVTimeDataPoint& A, const FXVTimeDataPoint& B) {
-				return A.TimeValue < B.TimeValue;
-			});
-		}
-		else
+	const bool bHasTimeProperty = GridData.HasTime();
+	for (int32 i = 0; i < GridData.Num(); ++i)
+	{
+		const int Y = GridData.YIndices[i];
+		const int X = GridData.XIndices[i];
+		const int V = GridData.Values[i];
+
+		// 如果没有时间值，使用索引作为默认时间
+		const double Time = bHasTimeProperty ? GridData.Times[i] : i;
+
+		// 保存数据点的索引和值，用于时间轴功能
+		FXVTimeDataPoint TimePoint;
+		TimePoint.RowIndex = Y;
+		TimePoint.ColIndex = X;
+		TimePoint.Value = V;
+		TimePoint.TimeValue = Time;
+		TimePoint.SortKey = bHasTimeProperty ? 0 : (Y * 1000 + X); // 有时间值时不使用排序键
+		TimeData.Add(TimePoint);
+	}
+	
+	// 对时间数据进行排序
+	if (bHasTimeProperty)
+	{
+		// 如果有时间属性，按时间值排序
+		TimeData.Sort([](const FXVTimeDataPoint& A, const FXVTimeDataPoint& B) {
+			return A.TimeValue < B.TimeValue;
+		});
+	}
+	else
+	{
+		// 否则按排序键排序
+		TimeData.Sort([](const FXVTimeDataPoint& A, const FXVTimeDataPoint& B) {
+			return A.SortKey < B.SortKey;
+		});
+
+		// 没有时间值时按排序后的顺序作为时间，保证时间单调递增
+		for (int32 i = 0; i < TimeData.Num(); ++i)
 		{
-			// 否则按排序键排序
-			TimeData.Sort([](const FXVTimeDataPoint& A, const FXVTimeDataPoint& B) {
-				return A.SortKey < B.SortKey;
-			});
+			TimeData[i].TimeValue = i;
 		}
 	}
-	RowCounts = XYZs.Num();
+
+	// 网格的行列索引从0开始
+	MinX = 0;
+	MinY = 0;
+	MaxX = ValueGrid.GetNumCols() - 1;
+	MaxY = ValueGrid.GetNumRows() - 1;
+	MinZ = static_cast<int>(ValueGrid.GetMinValue());
+	MaxZ = static_cast<int>(ValueGrid.GetMaxValue());
+	RowCounts = ValueGrid.GetNumRows();
+	ColCounts = ValueGrid.GetNumCols();
+	TotalCountOfValue = ValueGrid.Num();
+
 	LineSelection.SetNum(RowCounts);
 	TotalSelection.SetNum(TotalCountOfValue);
 
@@ -386,239 +414,189 @@ void AXVLineChart::ParseNamedDataWithTime(const TArray<TSharedPtr<FJsonObject>>&
 {
 	if (NamedData.IsEmpty())
 		return;
-		
-	// 检查是否有时间属性
-	bool bHasTimeProperty = false;
-	
-	// 收集所有唯一的X和Y值
-	TSet<FString> UniqueXValues;
-	TSet<FString> UniqueYValues;
-	
-	// 第一轮扫描收集所有唯一值
-	for (const auto& DataItem : NamedData)
+
+	FXVChartGridData GridData;
+	UXVDataConverter::ConvertNamedDataToGrid(NamedData, PropertyMapping.XProperty, PropertyMapping.YProperty,
+	                                         PropertyMapping.ZProperty, PropertyMapping.TimeProperty, GridData);
+
+	SetValueFromGrid(GridData);
+}
+
+void AXVLineChart::AppendSamples(int32 Series, const TArray<double>& Timestamps, const TArray<float>& Values)
+{
+	if (Series < 0 || Timestamps.Num() != Values.Num())
 	{
-		// 检查时间属性
-		if (DataItem->HasField(PropertyMapping.TimeProperty))
-		{
-			bHasTimeProperty = true;
-		}
-		
-		// 检查X和Y属性
-		if (DataItem->HasField(PropertyMapping.XProperty) &&
-			DataItem->HasField(PropertyMapping.YProperty))
-		{
-			// 获取X值
-			FString XValue;
-			if (DataItem->TryGetStringField(PropertyMapping.XProperty, XValue))
-			{
-				UniqueXValues.Add(XValue);
-			}
-			else
-			{
-				double XNumeric = 0;
-				if (DataItem->TryGetNumberField(PropertyMapping.XProperty, XNumeric))
-				{
-					XValue = FString::Printf(TEXT("%g"), XNumeric);
-					UniqueXValues.Add(XValue);
-				}
-			}
+		UE_LOG(LogTemp, Warning, TEXT("AppendSamples: invalid series %d or mismatched sample counts (%d timestamps, %d values)"),
+		       Series, Timestamps.Num(), Values.Num());
+		return;
+	}
+	if (Values.IsEmpty())
+	{
+		return;
+	}
 
-			// 获取Y值
-			FString YValue;
-			if (DataItem->TryGetStringField(PropertyMapping.YProperty, YValue))
-			{
-				UniqueYValues.Add(YValue);
-			}
-			else
-			{
-				double YNumeric = 0;
-				if (DataItem->TryGetNumberField(PropertyMapping.YProperty, YNumeric))
-				{
-					YValue = FString::Printf(TEXT("%g"), YNumeric);
-					UniqueYValues.Add(YValue);
-				}
-			}
-		}
+	// 容量改变后，已有网格段的索引不再适用，需要重新开始
+	if (StreamSeries.Num() > 0 && StreamSeries[0].Samples.Capacity() != StreamingCapacity)
+	{
+		ResetStreaming();
 	}
-	
-	// 转换为排序数组
-	TArray<FString> SortedXValues = UniqueXValues.Array();
-	TArray<FString> SortedYValues = UniqueYValues.Array();
-	
-	// 自定义排序逻辑：如果是纯数字则按照数值排序，否则按照字符串排序
-	auto NumericSort = [](const FString& A, const FString& B) -> bool
+
+	EnsureStreamSeries(Series);
+
+	for (int32 i = 0; i < Values.Num(); ++i)
 	{
-		// 检查是否都是数字
-		bool bAIsNumeric = true;
-		bool bBIsNumeric = true;
-		double ANumeric = 0.0;
-		double BNumeric = 0.0;
+		AppendStreamSample(Series, Timestamps[i], Values[i]);
+	}
 
-		// 尝试将字符串转换为数字
-		if (A.IsNumeric() && B.IsNumeric())
-		{
-			ANumeric = FCString::Atod(*A);
-			BNumeric = FCString::Atod(*B);
-			// 按数值排序
-			return ANumeric < BNumeric;
-		}
-		// 否则使用默认的字符串排序
-		return A < B;
-	};
-	
-	// 使用自定义排序逻辑
-	SortedXValues.Sort(NumericSort);
-	SortedYValues.Sort(NumericSort);
-	
-	// 创建映射字典
-	TMap<FString, int32> XValueToIndex;
-	TMap<FString, int32> YValueToIndex;
+	UpdateStreamScroll();
+}
 
-	for (int32 i = 0; i < SortedXValues.Num(); i++)
+void AXVLineChart::ResetStreaming()
+{
+	StreamSeries.Empty();
+	bHasStreamTimeOrigin = false;
+	StreamTimeOrigin = 0;
+
+	if (StreamMeshComponent)
 	{
-		XValueToIndex.Add(SortedXValues[i], i);
+		StreamMeshComponent->ClearAllMeshSections();
+		StreamMeshComponent->SetRelativeLocation(FVector::ZeroVector);
 	}
+}
 
-	for (int32 i = 0; i < SortedYValues.Num(); i++)
+void AXVLineChart::EnsureStreamSeries(int32 Series)
+{
+	StreamingCapacity = FMath::Max(2, StreamingCapacity);
+
+	if (!StreamMeshComponent)
 	{
-		YValueToIndex.Add(SortedYValues[i], i);
+		StreamMeshComponent = NewObject<UProceduralMeshComponent>(this, TEXT("StreamMeshComponent"));
+		StreamMeshComponent->SetupAttachment(RootComponent);
+		StreamMeshComponent->RegisterComponent();
 	}
-	
-	// 存储轴标签
-	XText = SortedXValues;
-	YText = SortedYValues;
-	
-	// 第二轮扫描处理数据
-	for (const auto& DataItem : NamedData)
+
+	const int32 OldNum = StreamSeries.Num();
+	if (Series >= OldNum)
 	{
-		if (DataItem->HasField(PropertyMapping.XProperty) &&
-			DataItem->HasField(PropertyMapping.YProperty) &&
-			DataItem->HasField(PropertyMapping.ZProperty))
+		StreamSeries.SetNum(Series + 1);
+		for (int32 i = OldNum; i < StreamSeries.Num(); ++i)
 		{
-			// 获取X值和索引
-			FString XValue;
-			int32 XIndex = 0;
+			StreamSeries[i].Samples.SetCapacity(StreamingCapacity);
+			StreamSeries[i].CreatedSegments.Init(false, StreamingCapacity);
+		}
+	}
+}
 
-			if (DataItem->TryGetStringField(PropertyMapping.XProperty, XValue))
-			{
-				XIndex = XValueToIndex.FindRef(XValue);
-			}
-			else
-			{
-				double XNumeric = 0;
-				if (DataItem->TryGetNumberField(PropertyMapping.XProperty, XNumeric))
-				{
-					XValue = FString::Printf(TEXT("%g"), XNumeric);
-					XIndex = XValueToIndex.FindRef(XValue);
-				}
-			}
+void AXVLineChart::AppendStreamSample(int32 Series, double Time, float Value)
+{
+	FStreamSeries& Stream = StreamSeries[Series];
 
-			// 获取Y值和索引
-			FString YValue;
-			int32 YIndex = 0;
+	if (!bHasStreamTimeOrigin)
+	{
+		StreamTimeOrigin = Time;
+		bHasStreamTimeOrigin = true;
+	}
 
-			if (DataItem->TryGetStringField(PropertyMapping.YProperty, YValue))
-			{
-				YIndex = YValueToIndex.FindRef(YValue);
-			}
-			else
-			{
-				double YNumeric = 0;
-				if (DataItem->TryGetNumberField(PropertyMapping.YProperty, YNumeric))
-				{
-					YValue = FString::Printf(TEXT("%g"), YNumeric);
-					YIndex = YValueToIndex.FindRef(YValue);
-				}
-			}
+	const int32 PrevSlot = Stream.Samples.IsEmpty() ? INDEX_NONE : Stream.Samples.GetSlot(Stream.Samples.Num() - 1);
+	const int32 NewSlot = Stream.Samples.Push({Time, Value});
 
-			// 获取Z值
-			double ZValue = 0;
-			DataItem->TryGetNumberField(PropertyMapping.ZProperty, ZValue);
-			
-			// 获取时间值
-			float TimeValue = TotalCountOfValue; // 默认使用计数作为时间
-			if (bHasTimeProperty)
-			{
-				double TimeNumeric = 0;
-				if (DataItem->TryGetNumberField(PropertyMapping.TimeProperty, TimeNumeric))
-				{
-					TimeValue = TimeNumeric;
-				}
-				else
-				{
-					FString TimeString;
-					if (DataItem->TryGetStringField(PropertyMapping.TimeProperty, TimeString))
-					{
-						// 尝试将字符串转换为数字（简单处理）
-						if (TimeString.IsNumeric())
-						{
-							TimeValue = FCString::Atof(*TimeString);
-						}
-						// 可以在这里添加更复杂的时间字符串解析
-					}
-				}
-			}
-			
-			// 更新数据范围
-			MaxX = FMath::Max(MaxX, XIndex);
-			MinX = FMath::Min(MinX, XIndex);
-			MaxY = FMath::Max(MaxY, YIndex);
-			MinY = FMath::Min(MinY, YIndex);
-			MaxZ = FMath::Max(MaxZ, ZValue);
-			MinZ = FMath::Min(MinZ, ZValue);
-			
-			// 添加到XYZs数据结构
-			if (XYZs.Contains(YIndex))
-			{
-				XYZs[YIndex].Add(XIndex, ZValue);
-			}
-			else
-			{
-				TMap<int, int> M;
-				M.Add(XIndex, ZValue);
-				XYZs.Add(YIndex, M);
-			}
-			
-			ColCounts = FMath::Max(ColCounts, XYZs[YIndex].Num());
-			TotalCountOfValue++;
-			
-			// 保存数据点的索引和值，用于时间轴功能
-			FXVTimeDataPoint TimePoint;
-			TimePoint.RowIndex = YIndex;
-			TimePoint.ColIndex = XIndex;
-			TimePoint.Value = ZValue;
-			TimePoint.TimeValue = TimeValue;
-			TimePoint.SortKey = bHasTimeProperty ? 0 : (YIndex * 1000 + XIndex); // 有时间值时不使用排序键
-			TimeData.Add(TimePoint);
-		}
+	// 缓冲区已满时新采样点覆盖了最旧的采样点，以它为起点的线段离开了窗口
+	if (Stream.CreatedSegments[NewSlot])
+	{
+		StreamMeshComponent->SetMeshSectionVisible(GetStreamSectionIndex(Series, NewSlot), false);
 	}
-	
-	// 对时间数据进行排序
-	if (bHasTimeProperty)
+
+	if (PrevSlot != INDEX_NONE)
 	{
-		// 如果有时间属性，按时间值排序
-		TimeData.Sort([](const FXVTimeDataPoint& A, const FXVTimeDataPoint& B) {
-			return A.TimeValue < B.TimeValue;
-		});
+		WriteStreamSegment(Series, PrevSlot);
+	}
+}
+
+void AXVLineChart::WriteStreamSegment(int32 Series, int32 StartSlot)
+{
+	FStreamSeries& Stream = StreamSeries[Series];
+	const FStreamSample& Start = Stream.Samples.GetBySlot(StartSlot);
+	const FStreamSample& End = Stream.Samples.GetBySlot((StartSlot + 1) % Stream.Samples.Capacity());
+
+	const float StartX = (Start.Time - StreamTimeOrigin) * StreamingTimeScale;
+	const float EndX = (End.Time - StreamTimeOrigin) * StreamingTimeScale;
+	const FVector Position(StartX, YAxisInterval * Series, 0);
+	const float AdjustedHeight = CalculateAdjustedHeight(Start.Value);
+	const float AdjustedNextHeight = CalculateAdjustedHeight(End.Value);
+	const FColor& Color = Colors[Series % Colors.Num()];
+
+	// 清空时保留容量，每个线段的顶点数相同，之后写入不再分配内存
+	StreamSectionScratch.SetNum(1);
+	FXVChartSectionInfo& Scratch = StreamSectionScratch[0];
+	Scratch.Vertices.Reset();
+	Scratch.Indices.Reset();
+	Scratch.Normals.Reset();
+	Scratch.UVs.Reset();
+	Scratch.Tangents.Reset();
+	Scratch.VertexColors.Reset();
+	if (LineChartStyle != ELineChartStyle::Point)
+	{
+		XVChartUtils::CreateBox(StreamSectionScratch, 0, Position, EndX - StartX, Width,
+		                        AdjustedHeight, AdjustedNextHeight, Color);
 	}
 	else
 	{
-		// 否则按排序键排序
-		TimeData.Sort([](const FXVTimeDataPoint& A, const FXVTimeDataPoint& B) {
-			return A.SortKey < B.SortKey;
-		});
+		XVChartUtils::CreateSphere(StreamSectionScratch, 0, Position + FVector(0, 0, AdjustedHeight),
+		                           SphereRadius, NumSphereSlices, NumSphereStacks, Color);
 	}
-	
-	RowCounts = XYZs.Num();
-	LineSelection.SetNum(RowCounts);
-	TotalSelection.SetNum(TotalCountOfValue);
 
-	DynamicMaterialInstances.Empty();
-	DynamicMaterialInstances.SetNum(TotalCountOfValue + 1);
-	SectionSelectStates.Init(false, TotalCountOfValue + 1);
-	SectionsHeight.SetNum(TotalCountOfValue + 1);
+	const FXVChartSectionInfo& Info = StreamSectionScratch[0];
+	const int32 SectionIndex = GetStreamSectionIndex(Series, StartSlot);
+	if (!Stream.CreatedSegments[StartSlot])
+	{
+		StreamMeshComponent->CreateMeshSection_LinearColor(SectionIndex, Info.Vertices, Info.Indices, Info.Normals,
+		                                                   Info.UVs, Info.VertexColors, Info.Tangents, false);
+		StreamMeshComponent->SetMaterial(SectionIndex, BaseMaterial);
+		Stream.CreatedSegments[StartSlot] = true;
+	}
+	else
+	{
+		// 每个线段的顶点数相同，只需更新顶点缓冲
+		StreamMeshComponent->UpdateMeshSection_LinearColor(SectionIndex, Info.Vertices, Info.Normals, Info.UVs,
+		                                                   Info.VertexColors, Info.Tangents);
+		StreamMeshComponent->SetMeshSectionVisible(SectionIndex, true);
+	}
+}
 
-	GenerateAllMeshInfo();
+void AXVLineChart::UpdateStreamScroll()
+{
+	double OldestTime = TNumericLimits<double>::Max();
+	double NewestTime = TNumericLimits<double>::Lowest();
+	for (const FStreamSeries& Stream : StreamSeries)
+	{
+		if (!Stream.Samples.IsEmpty())
+		{
+			OldestTime = FMath::Min(OldestTime, Stream.Samples.First().Time);
+			NewestTime = FMath::Max(NewestTime, Stream.Samples.Last().Time);
+		}
+	}
+	if (OldestTime > NewestTime)
+	{
+		return;
+	}
+
+	// 顶点坐标随时间不断增大，超过阈值后以当前最旧的采样点为原点重建窗口内的线段，避免单精度坐标失真
+	constexpr double RebaseDistance = 1e6;
+	if ((NewestTime - StreamTimeOrigin) * StreamingTimeScale > RebaseDistance)
+	{
+		StreamTimeOrigin = OldestTime;
+		for (int32 Series = 0; Series < StreamSeries.Num(); ++Series)
+		{
+			const TXVRingBuffer<FStreamSample>& Samples = StreamSeries[Series].Samples;
+			for (int32 i = 0; i + 1 < Samples.Num(); ++i)
+			{
+				WriteStreamSegment(Series, Samples.GetSlot(i));
+			}
+		}
+	}
+
+	// 窗口滚动只移动组件，已生成的线段不需要改动
+	StreamMeshComponent->SetRelativeLocation(FVector(-(OldestTime - StreamTimeOrigin) * StreamingTimeScale, 0, 0));
 }
 
 void AXVLineChart::ConstructMesh(double Rate)
@@ -643,7 +621,13 @@ void AXVLineChart::ConstructMesh(double Rate)
 		UpdateSectionVerticesOfZ(Rate);
 	}
 
+	// 切换LOD会重新绘制该级的全部网格段，时间轴需要在下一次更新时完整同步
+	const int PreviousLOD = CurrentLOD;
 	UpdateLOD();
+	if (CurrentLOD != PreviousLOD)
+	{
+		TimelineVisibleCount = INDEX_NONE;
+	}
 }
 
 /**
@@ -652,64 +636,122 @@ void AXVLineChart::ConstructMesh(double Rate)
 void AXVLineChart::UpdateMeshBasedOnTimeProgress(double Progress)
 {
 	// 如果没有数据或时间数据为空，直接返回
-	if (TotalCountOfValue == 0 || TimeData.Num() == 0)
+	if (TotalCountOfValue == 0 || TimelineSections.Num() == 0)
 	{
 		return;
 	}
 	
-	// 更新顶点高度
+	// 显示时需要从备份恢复顶点高度
 	BackupVertices();
 	
-	// 计算当前时间点应该显示的数据点数量
-	int MaxPointsToShow = FMath::FloorToInt(TimeData.Num() * Progress);
-	
-	// 确保至少显示1个点
-	MaxPointsToShow = FMath::Max(1, MaxPointsToShow);
-	
-	// 创建一个集合来记录当前应该显示的点
-	TSet<int> VisiblePoints;
-	for (int i = 0; i < MaxPointsToShow; ++i)
+	// 二分查找当前进度对应的时间之前出现的数据点，确保至少显示1个点
+	const double StartTime = TimelineTimes[0];
+	const double CutoffTime = StartTime + (TimelineTimes.Last() - StartTime) * Progress;
+	const int32 VisibleCount = FMath::Max(1, Algo::UpperBound(TimelineTimes, CutoffTime));
+
+	if (TimelineVisibleCount == INDEX_NONE)
 	{
-		const FXVTimeDataPoint& Point = TimeData[i];
-		int SectionIndex = Point.RowIndex * ColCounts + Point.ColIndex;
-		VisiblePoints.Add(SectionIndex);
+		// 重新生成网格或切换LOD后不知道哪些网格段已显示，完整同步一次
+		for (int32 i = 0; i < TimelineSections.Num(); ++i)
+		{
+			SetTimelineSectionVisible(TimelineSections[i], i < VisibleCount);
+		}
 	}
-	
-	// 遍历所有数据点，更新其可见性
-	for (int RowIndex = 0; RowIndex < RowCounts; RowIndex++)
+	else
 	{
-		const auto& Row = XYZs[RowIndex];
-		for (const auto& XZPair : Row)
+		// 只处理上一次和本次进度之间的数据点
+		for (int32 i = TimelineVisibleCount; i < VisibleCount; ++i)
 		{
-			int SectionIndex = RowIndex * ColCounts + XZPair.Key;
-			
-			// 检查当前点是否应该显示
-			bool bShouldShowPoint = VisiblePoints.Contains(SectionIndex);
-			
-			// 更新该点的所有顶点
-			if (bShouldShowPoint)
-			{
-				FXVChartSectionInfo& XVChartSectionInfo = SectionInfos[SectionIndex];
-				for (size_t VerticeIndex = 0; VerticeIndex < XVChartSectionInfo.Vertices.Num(); VerticeIndex++)
-				{
-					FVector& Vertice = XVChartSectionInfo.Vertices[VerticeIndex];
-				
-					if (bShouldShowPoint)
-					{
-						// 完全显示
-						Vertice.Z = VerticesBackup[SectionIndex][VerticeIndex].Z;
-					}
-					
-				}
-				DrawMeshSection(SectionIndex);
-			}
-			else
-			{
-				ProceduralMeshComponent->ClearMeshSection(SectionIndex);
-			}
-			
-			
+			SetTimelineSectionVisible(TimelineSections[i], true);
+		}
+		for (int32 i = VisibleCount; i < TimelineVisibleCount; ++i)
+		{
+			SetTimelineSectionVisible(TimelineSections[i], false);
+		}
+	}
+	TimelineVisibleCount = VisibleCount;
+}
+
+void AXVLineChart::SetTimelineSectionVisible(int32 SectionIndex, bool bVisible)
+{
+	// 合并网格段模式下LOD0网格段的序号即为数据点的ID，较粗LOD中来自该数据点的线段一起隐藏
+	if (HasSectionStates())
+	{
+		SetSectionStateVisible(SectionIndex, bVisible);
+		return;
+	}
+
+	if (!bVisible)
+	{
+		ClearMeshSection(SectionIndex);
+		return;
+	}
+
+	// 完全显示
+	FXVChartSectionInfo& XVChartSectionInfo = SectionInfos[SectionIndex];
+	for (int32 VerticeIndex = 0; VerticeIndex < XVChartSectionInfo.Vertices.Num(); VerticeIndex++)
+	{
+		XVChartSectionInfo.Vertices[VerticeIndex].Z = VerticesBackup[SectionIndex][VerticeIndex].Z;
+	}
+	DrawMeshSection(SectionIndex);
+}
+
+void AXVLineChart::SetPointEmissive(int32 Index, const FLinearColor& Color, float Intensity)
+{
+	if (HasSectionStates())
+	{
+		SetSectionState(Index, Color, Intensity);
+		return;
+	}
+
+	DynamicMaterialInstances[Index]->SetVectorParameterValue("EmissiveColor", Color);
+	DynamicMaterialInstances[Index]->SetScalarParameterValue("EmissiveIntensity", Intensity);
+	UpdateMeshSection(Index);
+}
+
+void AXVLineChart::SetPointEmissiveIntensity(int32 Index, float Intensity)
+{
+	if (HasSectionStates())
+	{
+		SetSectionStateIntensity(Index, Intensity);
+		return;
+	}
+
+	DynamicMaterialInstances[Index]->SetScalarParameterValue("EmissiveIntensity", Intensity);
+	UpdateMeshSection(Index);
+}
+
+int32 AXVLineChart::GetCellSection(int32 Row, int32 Col) const
+{
+	if (!ValueGrid.Contains(Row, Col) || !ValueGrid.IsValid(Row, Col))
+	{
+		return INDEX_NONE;
+	}
+	const int32 CellIndex = ValueGrid.GetCellIndex(Row, Col);
+	return CellSections.IsValidIndex(CellIndex) ? CellSections[CellIndex] : INDEX_NONE;
+}
+
+void AXVLineChart::BuildTimelineIndex()
+{
+	// 同一单元格出现多次时以最早的时间为准，TimeData已按时间排序
+	TimelineSections.Reset();
+	TimelineTimes.Reset();
+	TimelineVisibleCount = INDEX_NONE;
+	TBitArray<> SeenSections(false, TotalCountOfValue);
+	for (const FXVTimeDataPoint& Point : TimeData)
+	{
+		if (!ValueGrid.Contains(Point.RowIndex, Point.ColIndex))
+		{
+			continue;
 		}
+		const int32 SectionIndex = CellSections[ValueGrid.GetCellIndex(Point.RowIndex, Point.ColIndex)];
+		if (SectionIndex == INDEX_NONE || SeenSections[SectionIndex])
+		{
+			continue;
+		}
+		SeenSections[SectionIndex] = true;
+		TimelineSections.Add(SectionIndex);
+		TimelineTimes.Add(Point.TimeValue);
 	}
 }
 
@@ -727,73 +769,164 @@ void AXVLineChart::GenerateAllMeshInfo()
 	}
 
 	PrepareMeshSections();
+	BuildLODColumns();
+
+	// LOD0中每个单元格对应的网格段，较粗的LOD共用该单元格的材质实例
+	CellSections.Init(INDEX_NONE, ValueGrid.GetNumRows() * ValueGrid.GetNumCols());
 
+	// 合并网格段模式下每级LOD只有一个网格段，各级LOD的顶点都指向来源数据点在状态纹理中的纹素
+	const bool bMerged = IsMergingSections();
+	if (bMerged)
+	{
+		InitSectionStates(TotalCountOfValue, BaseMaterial);
+	}
+	else
+	{
+		ReleaseSectionStates();
+	}
+
+	// 第一遍：确定每级LOD的线段及其网格段下标
+	TArray<XVLineChartPrivate::FLineBuildItem> Items;
+	TArray<int32> LODItemStarts;
+	LODItemStarts.SetNum(GenerateLODCount + 1);
 	int LODOffset = 0;
 	for (int LODIndex = 0; LODIndex < GenerateLODCount; ++LODIndex)
 	{
+		LODItemStarts[LODIndex] = Items.Num();
 		int CurrentIndex = 0;
 		for (int RowIndex = 0; RowIndex < RowCounts; RowIndex++)
 		{
-			CurColCount = XYZs[RowIndex].Num();
-
-			for (int ColIndex = 0; ColIndex < CurColCount; ColIndex += LODIndex + 1)
+			const TArray<int32>& Columns = LODColumns[LODIndex][RowIndex];
+			for (int32 PointIndex = 0; PointIndex < Columns.Num(); ++PointIndex)
 			{
-				FVector Position(XAxisInterval * ColIndex, YAxisInterval * RowIndex, 0);
+				const int ColIndex = Columns[PointIndex];
 
-				int NewColIndex = FMath::Min(CurColCount - 1, ColIndex + LODIndex + 1);
-
-				// 获取原始高度
-				float RawHeight = XYZs[RowIndex][ColIndex];
-				float RawNextHeight = XYZs[RowIndex][NewColIndex];
-
-				// 应用Z轴调整
-				float AdjustedHeight = CalculateAdjustedHeight(RawHeight);
-				float AdjustedNextHeight = CalculateAdjustedHeight(RawNextHeight);
-
-				if (LODIndex == 0)
+				// 连接到下一个保留的点；LOD0只连接相邻的列，缺失的数据点处断开
+				int NewColIndex = PointIndex + 1 < Columns.Num() ? Columns[PointIndex + 1] : ColIndex;
+				if (LODIndex == 0 && NewColIndex != ColIndex + 1)
 				{
-					SectionsHeight[CurrentIndex] =
-						FMath::Max(AdjustedHeight, AdjustedNextHeight);
+					NewColIndex = ColIndex;
 				}
 
-				if (LineChartStyle != ELineChartStyle::Point)
-				{
-					XVChartUtils::CreateBox(SectionInfos, CurrentIndex, Position,
-					                        YAxisInterval, Width, AdjustedHeight,
-					                        AdjustedNextHeight,
-					                        Colors[RowIndex % Colors.Num()]);
-				}
-				else
+				if (LODIndex == 0)
 				{
-					int LODNumSphereSlices = FMath::Max(3, NumSphereSlices - LODIndex);
-					int LODNumSphereStacks = FMath::Max(2, NumSphereStacks - LODIndex);
-
-					XVChartUtils::CreateSphere(SectionInfos, CurrentIndex,
-					                           Position + FVector(0, 0, AdjustedHeight),
-					                           SphereRadius, LODNumSphereSlices,
-					                           LODNumSphereStacks,
-					                           Colors[RowIndex % Colors.Num()]);
+					CellSections[ValueGrid.GetCellIndex(RowIndex, ColIndex)] = CurrentIndex;
 				}
-
-				DynamicMaterialInstances[CurrentIndex] =
-					UMaterialInstanceDynamic::Create(BaseMaterial, this);
-				DynamicMaterialInstances[CurrentIndex]->SetVectorParameterValue(
-					TEXT("EmissiveColor"), EmissiveColor);
-				ProceduralMeshComponent->SetMaterial(
-					CurrentIndex, DynamicMaterialInstances[CurrentIndex]);
-
-				// 使用原始高度值作为标签文本
-				LabelComponents[CurrentIndex] = XVChartUtils::CreateTextRenderComponent(
-					this, FText::FromString(FString::Printf(TEXT("%.2f"), RawHeight)),
-					FColor::Cyan, false);
+				Items.Add({LODIndex, RowIndex, ColIndex, NewColIndex, bMerged ? LODIndex : LODOffset + CurrentIndex, CurrentIndex});
 
 				CurrentIndex++;
 			}
 		}
-		LODInfos[LODIndex].LODCount = CurrentIndex;
-		LODInfos[LODIndex].LODOffset = LODOffset;
-		LODOffset += CurrentIndex;
+
+		if (bMerged)
+		{
+			LODInfos[LODIndex].LODCount = 1;
+			LODInfos[LODIndex].LODOffset = LODIndex;
+		}
+		else
+		{
+			LODInfos[LODIndex].LODCount = CurrentIndex;
+			LODInfos[LODIndex].LODOffset = LODOffset;
+			LODOffset += CurrentIndex;
+		}
 	}
+	LODItemStarts[GenerateLODCount] = Items.Num();
+	SectionInfos.SetNum(bMerged ? GenerateLODCount : LODOffset);
+
+	// 第二遍：并行生成几何，每个线段只写入自己的网格段；合并网格段模式下先写入临时网格段
+	TArray<FXVChartSectionInfo> PointSections;
+	if (bMerged)
+	{
+		PointSections.SetNum(Items.Num());
+	}
+
+	ParallelFor(Items.Num(), [&](int32 ItemIndex)
+	{
+		const XVLineChartPrivate::FLineBuildItem& Item = Items[ItemIndex];
+		TArray<FXVChartSectionInfo>& TargetSections = bMerged ? PointSections : SectionInfos;
+		const int32 TargetIndex = bMerged ? ItemIndex : Item.SectionIndex;
+
+		FVector Position(XAxisInterval * Item.ColIndex, YAxisInterval * Item.RowIndex, 0);
+
+		// 获取原始高度
+		float RawHeight = ValueGrid.Get(Item.RowIndex, Item.ColIndex);
+		float RawNextHeight = ValueGrid.Get(Item.RowIndex, Item.NextColIndex);
+
+		// 应用Z轴调整
+		float AdjustedHeight = CalculateAdjustedHeight(RawHeight);
+		float AdjustedNextHeight = CalculateAdjustedHeight(RawNextHeight);
+
+		if (Item.LODIndex == 0)
+		{
+			SectionsHeight[Item.PointIndex] =
+				FMath::Max(AdjustedHeight, AdjustedNextHeight);
+		}
+
+		if (LineChartStyle != ELineChartStyle::Point)
+		{
+			// 线段跨越到下一个保留点所在的列
+			XVChartUtils::CreateBox(TargetSections, TargetIndex, Position,
+			                        XAxisInterval * FMath::Max(1, Item.NextColIndex - Item.ColIndex), Width, AdjustedHeight,
+			                        AdjustedNextHeight,
+			                        Colors[Item.RowIndex % Colors.Num()]);
+		}
+		else
+		{
+			int LODNumSphereSlices = FMath::Max(3, NumSphereSlices - Item.LODIndex);
+			int LODNumSphereStacks = FMath::Max(2, NumSphereStacks - Item.LODIndex);
+
+			XVChartUtils::CreateSphere(TargetSections, TargetIndex,
+			                           Position + FVector(0, 0, AdjustedHeight),
+			                           SphereRadius, LODNumSphereSlices,
+			                           LODNumSphereStacks,
+			                           Colors[Item.RowIndex % Colors.Num()]);
+		}
+
+		if (bMerged)
+		{
+			AssignSectionId(PointSections[ItemIndex], 0, CellSections[ValueGrid.GetCellIndex(Item.RowIndex, Item.ColIndex)]);
+		}
+	});
+
+	// 第三遍：在游戏线程上拼接合并网格段，并创建材质实例和标签
+	for (int LODIndex = 0; LODIndex < GenerateLODCount && bMerged; ++LODIndex)
+	{
+		const int32 ItemStart = LODItemStarts[LODIndex];
+		XVChartUtils::MergeSectionInfos(MakeArrayView(PointSections.GetData() + ItemStart, LODItemStarts[LODIndex + 1] - ItemStart), SectionInfos[LODIndex]);
+		GetSectionMeshComponent()->SetMaterial(LODIndex, MergedSectionMaterialInstance);
+	}
+
+	for (const XVLineChartPrivate::FLineBuildItem& Item : Items)
+	{
+		if (Item.LODIndex != 0)
+		{
+			break;
+		}
+		if (!bMerged)
+		{
+			DynamicMaterialInstances[Item.PointIndex] =
+				UMaterialInstanceDynamic::Create(BaseMaterial, this);
+			DynamicMaterialInstances[Item.PointIndex]->SetVectorParameterValue(
+				TEXT("EmissiveColor"), EmissiveColor);
+		}
+
+		// 使用原始高度值作为标签文本，标签只对应LOD0的数据点
+		LabelComponents[Item.PointIndex] = XVChartUtils::CreateTextRenderComponent(
+			this, FText::FromString(FString::Printf(TEXT("%.2f"), ValueGrid.Get(Item.RowIndex, Item.ColIndex))),
+			FColor::Cyan, false);
+	}
+
+	// 较粗的LOD共用来源单元格的材质实例
+	if (!bMerged)
+	{
+		for (const XVLineChartPrivate::FLineBuildItem& Item : Items)
+		{
+			GetSectionMeshComponent()->SetMaterial(
+				Item.SectionIndex, DynamicMaterialInstances[CellSections[ValueGrid.GetCellIndex(Item.RowIndex, Item.ColIndex)]]);
+		}
+	}
+
+	BuildTimelineIndex();
 
 	// 如果启用了参考值高亮，应用高亮效果
 	if (bEnableReferenceHighlight)
@@ -815,6 +948,69 @@ void AXVLineChart::GenerateAllMeshInfo()
 	}
 }
 
+void AXVLineChart::BuildLODColumns()
+{
+	LODColumns.SetNum(GenerateLODCount);
+	for (TArray<TArray<int32>>& Rows : LODColumns)
+	{
+		Rows.SetNum(RowCounts);
+	}
+
+	ParallelFor(RowCounts, [this](int32 RowIndex)
+	{
+		// LOD0保留行中所有有效的数据点
+		TArray<int32>& FullColumns = LODColumns[0][RowIndex];
+		TArray<float> Xs;
+		TArray<float> Ys;
+		FullColumns.Reset();
+		const int32 RowLength = ValueGrid.GetRowLength(RowIndex);
+		for (int32 ColIndex = 0; ColIndex < RowLength; ++ColIndex)
+		{
+			if (ValueGrid.IsValid(RowIndex, ColIndex))
+			{
+				FullColumns.Add(ColIndex);
+				Xs.Add(ColIndex);
+				Ys.Add(ValueGrid.Get(RowIndex, ColIndex));
+			}
+		}
+
+		TArray<int32> Kept;
+		for (int32 LODIndex = 1; LODIndex < GenerateLODCount; ++LODIndex)
+		{
+			TArray<int32>& Columns = LODColumns[LODIndex][RowIndex];
+			Columns.Reset();
+
+			if (LODMethod == ELineChartLODMethod::Stride)
+			{
+				for (int32 ColIndex = 0; ColIndex < RowLength; ColIndex += LODIndex + 1)
+				{
+					if (ValueGrid.IsValid(RowIndex, ColIndex))
+					{
+						Columns.Add(ColIndex);
+					}
+				}
+				continue;
+			}
+
+			const int32 Threshold = FMath::Max(3, FMath::CeilToInt32(FullColumns.Num() / FMath::Pow(LODReductionFactor, LODIndex)));
+			if (LODMethod == ELineChartLODMethod::LTTB)
+			{
+				FXVDownsampler::LargestTriangleThreeBuckets(Xs, Ys, Threshold, Kept);
+			}
+			else
+			{
+				FXVDownsampler::MinMaxBuckets(Ys, Threshold, Kept);
+			}
+
+			Columns.Reserve(Kept.Num());
+			for (const int32 PointIndex : Kept)
+			{
+				Columns.Add(FullColumns[PointIndex]);
+			}
+		}
+	});
+}
+
 #if WITH_EDITOR
 void AXVLineChart::PostEditChangeProperty(
 	FPropertyChangedEvent& PropertyChangedEvent)
@@ -854,40 +1050,27 @@ void AXVLineChart::ApplyReferenceHighlight()
 
 	// 遍历所有线段/点，检查是否符合参考值条件
 	size_t CurrentIndex = 0;
-	for (int RowIndex = 0; RowIndex < XYZs.Num(); RowIndex++)
+	ValueGrid.ForEachValid([this, &CurrentIndex](int32 RowIndex, int32 ColIndex, float Value)
 	{
-		const auto& Row = XYZs[RowIndex];
-		for (const auto& XZPair : Row)
-		{
-			// 使用原始高度值进行比较，而不是调整后的高度
-			int RawValue = XZPair.Value; // Z值
-
-			// 检查值是否符合参考值条件
-			bool bMatchesReference = CheckAgainstReference(RawValue);
-
-			if (bMatchesReference)
-			{
-				// 符合条件，应用高亮颜色和发光效果
-				DynamicMaterialInstances[CurrentIndex]->SetVectorParameterValue(
-					"EmissiveColor", ReferenceHighlightColor);
-				DynamicMaterialInstances[CurrentIndex]->SetScalarParameterValue(
-					"EmissiveIntensity", EmissiveIntensity);
-			}
-			else
-			{
-				// 不符合条件，恢复默认颜色和发光效果
-				DynamicMaterialInstances[CurrentIndex]->SetVectorParameterValue(
-					"EmissiveColor", EmissiveColor);
-				DynamicMaterialInstances[CurrentIndex]->SetScalarParameterValue(
-					"EmissiveIntensity", 0);
-			}
+		// 使用原始高度值进行比较，而不是调整后的高度
+		int RawValue = static_cast<int>(Value); // Z值
 
-			// 更新网格部分
-			UpdateMeshSection(CurrentIndex);
+		// 检查值是否符合参考值条件
+		bool bMatchesReference = CheckAgainstReference(RawValue);
 
-			CurrentIndex++;
+		if (bMatchesReference)
+		{
+			// 符合条件，应用高亮颜色和发光效果
+			SetPointEmissive(CurrentIndex, ReferenceHighlightColor, EmissiveIntensity);
 		}
-	}
+		else
+		{
+			// 不符合条件，恢复默认颜色和发光效果
+			SetPointEmissive(CurrentIndex, EmissiveColor, 0);
+		}
+
+		CurrentIndex++;
+	});
 }
 
 // 应用统计轴线到线图
@@ -934,13 +1117,7 @@ TArray<float> AXVLineChart::GetAllDataValues() const
 	TArray<float> Values;
 
 	// 收集所有Z值（高度值）
-	for (const auto& Row : XYZs)
-	{
-		for (const auto& Item : Row.Value)
-		{
-			Values.Add(Item.Value);
-		}
-	}
+	ValueGrid.GetValidValues(Values);
 
 	return Values;
 }
@@ -1099,39 +1276,26 @@ void AXVLineChart::ApplyValueTriggerConditions()
 
 	// 遍历所有线段/点，检查是否符合触发条件
 	size_t CurrentIndex = 0;
-	for (int RowIndex = 0; RowIndex < XYZs.Num(); RowIndex++)
+	ValueGrid.ForEachValid([this, &CurrentIndex](int32 RowIndex, int32 ColIndex, float Value)
 	{
-		const auto& Row = XYZs[RowIndex];
-		for (const auto& XZPair : Row)
+		// 使用原始高度值进行比较
+		int RawValue = static_cast<int>(Value); // Z值
+		
+		// 检查值是否满足任何触发条件
+		FLinearColor HighlightColor;
+		bool bMatchesTrigger = CheckValueTriggerConditions(RawValue, HighlightColor);
+		
+		if (bMatchesTrigger)
 		{
-			// 使用原始高度值进行比较
-			int RawValue = XZPair.Value; // Z值
-			
-			// 检查值是否满足任何触发条件
-			FLinearColor HighlightColor;
-			bool bMatchesTrigger = CheckValueTriggerConditions(RawValue, HighlightColor);
-			
-			if (bMatchesTrigger)
-			{
-				// 符合条件，应用高亮颜色和发光效果
-				DynamicMaterialInstances[CurrentIndex]->SetVectorParameterValue(
-					"EmissiveColor", HighlightColor);
-				DynamicMaterialInstances[CurrentIndex]->SetScalarParameterValue(
-					"EmissiveIntensity", EmissiveIntensity);
-			}
-			else
-			{
-				// 不符合条件，恢复默认颜色和发光效果
-				DynamicMaterialInstances[CurrentIndex]->SetVectorParameterValue(
-					"EmissiveColor", EmissiveColor);
-				DynamicMaterialInstances[CurrentIndex]->SetScalarParameterValue(
-					"EmissiveIntensity", 0);
-			}
-			
-			// 更新网格部分
-			UpdateMeshSection(CurrentIndex);
-			
-			CurrentIndex++;
+			// 符合条件，应用高亮颜色和发光效果
+			SetPointEmissive(CurrentIndex, HighlightColor, EmissiveIntensity);
 		}
-	}
+		else
+		{
+			// 不符合条件，恢复默认颜色和发光效果
+			SetPointEmissive(CurrentIndex, EmissiveColor, 0);
+		}
+		
+		CurrentIndex++;
+	});
 }
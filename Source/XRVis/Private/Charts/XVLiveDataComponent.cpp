@@ -0,0 +1,146 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Charts/XVLiveDataComponent.h"
+#include "Charts/XVBarChart.h"
+#include "Charts/XVLineChart.h"
+
+UXVLiveDataComponent::UXVLiveDataComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	// 在图表自身Tick之前应用更新，柱状图可以在同一帧重建脏柱体
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+void UXVLiveDataComponent::TickComponent(float DeltaTime, ELevelTick TickType,
+                                         FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	DrainSources();
+	ApplyPendingUpdates();
+}
+
+void UXVLiveDataComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	RemoveAllSources();
+	Super::EndPlay(EndPlayReason);
+}
+
+void UXVLiveDataComponent::AddSource(TUniquePtr<IXVLiveDataSource> Source)
+{
+	if (!Source)
+	{
+		return;
+	}
+
+	if (!Source->Start())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to start live data source: %s"), *Source->GetDescription());
+		return;
+	}
+	Sources.Add(MoveTemp(Source));
+}
+
+void UXVLiveDataComponent::AddFileTailSource(const FString& FilePath, bool bStartAtEnd)
+{
+	AddSource(MakeUnique<FXVFileTailLiveDataSource>(FilePath, bStartAtEnd));
+}
+
+void UXVLiveDataComponent::AddNamedPipeSource(const FString& PipeName)
+{
+	AddSource(MakeUnique<FXVNamedPipeLiveDataSource>(PipeName));
+}
+
+void UXVLiveDataComponent::AddTcpSource(int32 Port)
+{
+	AddSource(MakeUnique<FXVTcpLiveDataSource>(Port));
+}
+
+void UXVLiveDataComponent::RemoveAllSources()
+{
+	for (const TUniquePtr<IXVLiveDataSource>& Source : Sources)
+	{
+		Source->Stop();
+	}
+	Sources.Empty();
+	PendingCells.Reset();
+	PendingSeries.Reset();
+	NumPendingSamples = 0;
+}
+
+void UXVLiveDataComponent::DrainSources()
+{
+	FXVLiveSample Sample;
+	for (const TUniquePtr<IXVLiveDataSource>& Source : Sources)
+	{
+		while (Source->Dequeue(Sample))
+		{
+			if (Sample.bHasTime)
+			{
+				FPendingSeries& Series = PendingSeries.FindOrAdd(Sample.Row);
+				Series.Times.Add(Sample.Time);
+				Series.Values.Add(Sample.Value);
+				++NumPendingSamples;
+			}
+			else
+			{
+				const uint64 Key = (static_cast<uint64>(static_cast<uint32>(Sample.Row)) << 32) | static_cast<uint32>(Sample.Col);
+				PendingCells.Add(Key, Sample.Value);
+			}
+		}
+	}
+}
+
+void UXVLiveDataComponent::ApplyPendingUpdates()
+{
+	if (PendingCells.IsEmpty() && NumPendingSamples == 0)
+	{
+		return;
+	}
+
+	AActor* Owner = GetOwner();
+	bool bApplied = false;
+
+	if (AXVBarChart* BarChart = Cast<AXVBarChart>(Owner))
+	{
+		if (!PendingCells.IsEmpty())
+		{
+			CellUpdates.Reset(PendingCells.Num());
+			for (const TPair<uint64, float>& Cell : PendingCells)
+			{
+				FXVCellUpdate& Update = CellUpdates.AddDefaulted_GetRef();
+				Update.Row = static_cast<int32>(Cell.Key >> 32);
+				Update.Col = static_cast<int32>(Cell.Key & 0xFFFFFFFF);
+				Update.Value = Cell.Value;
+			}
+			BarChart->UpdateValues(CellUpdates);
+		}
+		bApplied = NumPendingSamples == 0;
+	}
+	else if (AXVLineChart* LineChart = Cast<AXVLineChart>(Owner))
+	{
+		for (const TPair<int32, FPendingSeries>& Series : PendingSeries)
+		{
+			if (Series.Value.Values.Num() > 0)
+			{
+				LineChart->AppendSamples(Series.Key, Series.Value.Times, Series.Value.Values);
+			}
+		}
+		bApplied = PendingCells.IsEmpty();
+	}
+
+	if (!bApplied && !bWarnedUnsupportedOwner)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s: some live updates are not supported by the owning actor and were dropped"),
+		       *GetNameSafe(Owner));
+		bWarnedUnsupportedOwner = true;
+	}
+
+	PendingCells.Reset();
+	for (TPair<int32, FPendingSeries>& Series : PendingSeries)
+	{
+		Series.Value.Times.Reset();
+		Series.Value.Values.Reset();
+	}
+	NumPendingSamples = 0;
+}
@@ -3,6 +3,7 @@
 #include "UObject/ConstructorHelpers.h"
 #include "Components/TextRenderComponent.h"
 #include "ProceduralMeshComponent.h"
+#include "Async/ParallelFor.h"
 
 
 // Sets default values
@@ -45,6 +46,7 @@ void AXVPieChart::Create3DPieChart(const TMap<FString, float>& Data, EPieChartSt
                                    const TArray<FColor>& PieChartColor, EPieShape Shape)
 {
 	TotalCountOfValue = Data.Num();
+	InvalidateStatistics();
 
 	if (TotalCountOfValue <= 0 || InternalDiameter > ExternalDiameter)
 	{
@@ -120,6 +122,25 @@ void AXVPieChart::Create3DPieChart(const TMap<FString, float>& Data, EPieChartSt
 	}
 }
 
+void AXVPieChart::SetValueFromGrid(const FXVChartGridData& GridData)
+{
+	Super::SetValueFromGrid(GridData);
+
+	// 饼图的XIndices为类别在XLabels中的索引
+	TMap<FString, float> Data;
+	Data.Reserve(GridData.XLabels.Num());
+	for (int32 i = 0; i < GridData.Num(); ++i)
+	{
+		if (GridData.XLabels.IsValidIndex(GridData.XIndices[i]))
+		{
+			Data.FindOrAdd(GridData.XLabels[GridData.XIndices[i]]) += GridData.Values[i];
+		}
+	}
+
+	// 沿用当前的样式、颜色和形状
+	Create3DPieChart(Data, PieChartStyle, SectionColors, PieShape);
+}
+
 void AXVPieChart::Set3DPieChart(EPieChartStyle ChartStyle, const TArray<FColor>& PieChartColor, EPieShape Shape)
 {
 	// Only for editor panel
@@ -241,29 +262,43 @@ void AXVPieChart::GenerateLOD()
 	check(GenerateLODCount);
 	LODInfos.SetNum(GenerateLODCount);
 	size_t DataSize = AccumulatedValues.Num() - 1;
+
+	// 各扇区的起止角度只取决于累计值，先算好后各网格段可以独立生成
+	TArray<size_t> SectionEndAngles;
+	SectionEndAngles.SetNum(DataSize);
+	for (int CurrentIndex = 0; CurrentIndex < DataSize; ++CurrentIndex)
+	{
+		SectionEndAngles[CurrentIndex] = static_cast<size_t>(AccumulatedValues[CurrentIndex] * AngleConvertFactor);
+	}
 	for (int i = 0; i < GenerateLODCount; i++)
 	{
-		size_t CurrentSectionStartAngle = 0;
 		LODInfos[i].LODOffset = i * DataSize;
-		for (int CurrentIndex = 0; CurrentIndex < DataSize; ++CurrentIndex)
-		{
-			uint32_t SectionIndex = LODInfos[i].LODOffset + CurrentIndex;
-			size_t CurrentSectionEndAngle = static_cast<size_t>(AccumulatedValues[CurrentIndex] * AngleConvertFactor);
-			GeneratePieSectionInfo(CenterPosition, SectionIndex,
-			                       CurrentSectionStartAngle, CurrentSectionEndAngle - FinalSectionGapAngle,
-			                       FinalInternalDiameter, ExternalDiameter + CurrentIndex * FinalNightingaleOffset,
-			                       SectionHeight,
-			                       SectionColors[CurrentIndex],
-			                       i + 1);
-
-			DynamicMaterialInstances[SectionIndex] = UMaterialInstanceDynamic::Create(Material, this);
-			DynamicMaterialInstances[SectionIndex]->SetVectorParameterValue("EmissiveColor", EmissiveColor);
-			ProceduralMeshComponent->SetMaterial(SectionIndex, DynamicMaterialInstances[SectionIndex]);
-
-			CurrentSectionStartAngle = CurrentSectionEndAngle;
-		}
 		LODInfos[i].LODCount = DataSize;
 	}
+
+	// 并行生成几何，每个扇区只写入自己的网格段
+	const int32 TotalSectionCount = static_cast<int32>(GenerateLODCount * DataSize);
+	SectionInfos.SetNum(TotalSectionCount);
+	ParallelFor(TotalSectionCount, [this, DataSize, &SectionEndAngles](int32 SectionIndex)
+	{
+		const int i = SectionIndex / DataSize;
+		const int CurrentIndex = SectionIndex % DataSize;
+		const size_t CurrentSectionStartAngle = CurrentIndex > 0 ? SectionEndAngles[CurrentIndex - 1] : 0;
+		GeneratePieSectionInfo(CenterPosition, SectionIndex,
+		                       CurrentSectionStartAngle, SectionEndAngles[CurrentIndex] - FinalSectionGapAngle,
+		                       FinalInternalDiameter, ExternalDiameter + CurrentIndex * FinalNightingaleOffset,
+		                       SectionHeight,
+		                       SectionColors[CurrentIndex],
+		                       i + 1);
+	});
+
+	// 材质实例在游戏线程上创建
+	for (int32 SectionIndex = 0; SectionIndex < TotalSectionCount; ++SectionIndex)
+	{
+		DynamicMaterialInstances[SectionIndex] = UMaterialInstanceDynamic::Create(Material, this);
+		DynamicMaterialInstances[SectionIndex]->SetVectorParameterValue("EmissiveColor", EmissiveColor);
+		GetSectionMeshComponent()->SetMaterial(SectionIndex, DynamicMaterialInstances[SectionIndex]);
+	}
 }
 
 void AXVPieChart::ProcessTypeAndShapeInfo()
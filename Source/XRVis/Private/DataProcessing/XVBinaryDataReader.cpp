@@ -0,0 +1,34 @@
+#include "DataProcessing/XVBinaryDataReader.h"
+
+bool UXVBinaryDataReader::ReadFromFile(const FString& FilePath)
+{
+    // 清除之前的数据
+    DataTable.Clear();
+    LastError.Empty();
+
+    if (!Dataset.Open(FilePath, LastError) || !ReportProgress(0.5f))
+    {
+        return false;
+    }
+
+    Dataset.CopyToDataTable(DataTable);
+    if (!ReportProgress(1.0f))
+    {
+        DataTable.Clear();
+        return false;
+    }
+    return true;
+}
+
+bool UXVBinaryDataReader::ReadFromString(const FString& Content)
+{
+    DataTable.Clear();
+    LastError = TEXT("二进制数据集不支持从字符串读取");
+    return false;
+}
+
+bool UXVBinaryDataReader::WriteToFile(const FXVDataTable& InDataTable, const FString& FilePath)
+{
+    LastError.Empty();
+    return FXVBinaryDataset::Write(InDataTable, FilePath, LastError);
+}
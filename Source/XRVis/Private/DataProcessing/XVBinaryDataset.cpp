@@ -0,0 +1,369 @@
+#include "DataProcessing/XVBinaryDataset.h"
+#include "Async/MappedFileHandle.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+
+static_assert(PLATFORM_LITTLE_ENDIAN, "二进制数据集按小端序存储");
+
+namespace XVBinaryDatasetPrivate
+{
+    /** 文件魔数 "XVB1" */
+    constexpr uint32 FileMagic = 0x31425658;
+    constexpr uint32 FileVersion = 1;
+
+    /** 数据块的对齐字节数，保证映射后可以直接按int64/double访问 */
+    constexpr int64 BlockAlignment = 8;
+
+    struct FFileHeader
+    {
+        uint32 Magic;
+        uint32 Version;
+        int32 ColumnCount;
+        int32 Reserved;
+        int64 RowCount;
+    };
+    static_assert(sizeof(FFileHeader) == 24, "文件头布局不能改变");
+
+    struct FColumnDesc
+    {
+        uint8 Type;
+        uint8 Padding[3];
+        int32 NameBytes;
+        int64 NameOffset;
+        int64 ValidityOffset;
+        int64 ValuesOffset;
+        int64 DictionaryOffset;
+        int32 DictionaryCount;
+        int32 Reserved;
+        int64 DictionaryNumbersOffset;
+    };
+    static_assert(sizeof(FColumnDesc) == 56, "列描述布局不能改变");
+
+    int32 NumValidityWords(int32 NumRows)
+    {
+        return (NumRows + 31) / 32;
+    }
+
+    /** 值数组中每个元素的字节数 */
+    int32 GetValueSize(EXVColumnType Type)
+    {
+        switch (Type)
+        {
+        case EXVColumnType::Int64:
+        case EXVColumnType::Timestamp:
+            return sizeof(int64);
+        case EXVColumnType::Double:
+            return sizeof(double);
+        case EXVColumnType::String:
+            return sizeof(int32);
+        default:
+            return 0;
+        }
+    }
+
+    /** 写入数据块，写入前按BlockAlignment补齐，返回数据块的偏移 */
+    int64 WriteBlock(FArchive& Ar, const void* Bytes, int64 NumBytes)
+    {
+        static const uint8 Zeros[BlockAlignment] = {};
+        const int64 Padding = Align(Ar.Tell(), BlockAlignment) - Ar.Tell();
+        Ar.Serialize(const_cast<uint8*>(Zeros), Padding);
+
+        const int64 Offset = Ar.Tell();
+        if (NumBytes > 0)
+        {
+            Ar.Serialize(const_cast<void*>(Bytes), NumBytes);
+        }
+        return Offset;
+    }
+
+    /** 检查数据块是否对齐且完全位于文件内 */
+    bool IsBlockInRange(int64 Offset, int64 NumBytes, int64 FileSize)
+    {
+        return Offset >= 0 && NumBytes >= 0 && Offset % BlockAlignment == 0 && Offset <= FileSize && NumBytes <= FileSize - Offset;
+    }
+}
+
+const TCHAR* FXVBinaryDataset::FileExtension = TEXT("xvb");
+
+FXVBinaryDataset::FXVBinaryDataset() = default;
+
+FXVBinaryDataset::~FXVBinaryDataset()
+{
+    Close();
+}
+
+bool FXVBinaryDataset::Write(const FXVDataTable& DataTable, const FString& FilePath, FString& OutError)
+{
+    using namespace XVBinaryDatasetPrivate;
+
+    TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*FilePath));
+    if (!Ar)
+    {
+        OutError = FString::Printf(TEXT("无法写入文件: %s"), *FilePath);
+        return false;
+    }
+
+    const int32 NumColumns = DataTable.GetColumnCount();
+    const int32 NumRows = DataTable.GetRowCount();
+
+    FFileHeader Header = {};
+    Header.Magic = FileMagic;
+    Header.Version = FileVersion;
+    Header.ColumnCount = NumColumns;
+    Header.RowCount = NumRows;
+    Ar->Serialize(&Header, sizeof(Header));
+
+    // 列描述表先占位，数据块写完后再回填偏移
+    TArray<FColumnDesc> Descs;
+    Descs.SetNumZeroed(NumColumns);
+    const int64 DescsOffset = Ar->Tell();
+    Ar->Serialize(Descs.GetData(), Descs.Num() * sizeof(FColumnDesc));
+
+    // 没有行的表可能尚未创建列，按空列写入
+    const TBitArray<> EmptyValidity(false, NumRows);
+    TArray<uint8> DictionaryBytes;
+    TArray<int32> DictionaryLengths;
+
+    for (int32 ColumnIndex = 0; ColumnIndex < NumColumns; ++ColumnIndex)
+    {
+        const FXVDataColumn* Column = DataTable.GetColumn(ColumnIndex);
+        FColumnDesc& Desc = Descs[ColumnIndex];
+
+        const FTCHARToUTF8 Name(*DataTable.ColumnNames[ColumnIndex]);
+        Desc.NameBytes = Name.Length();
+        Desc.NameOffset = WriteBlock(*Ar, Name.Get(), Name.Length());
+
+        const TBitArray<>& Validity = Column ? Column->GetValidity() : EmptyValidity;
+        Desc.ValidityOffset = WriteBlock(*Ar, Validity.GetData(), NumValidityWords(NumRows) * sizeof(uint32));
+
+        const EXVColumnType Type = Column ? Column->GetType() : EXVColumnType::Empty;
+        Desc.Type = static_cast<uint8>(Type);
+        switch (Type)
+        {
+        case EXVColumnType::Int64:
+        case EXVColumnType::Timestamp:
+            Desc.ValuesOffset = WriteBlock(*Ar, Column->GetInt64Values().GetData(), NumRows * sizeof(int64));
+            break;
+        case EXVColumnType::Double:
+            Desc.ValuesOffset = WriteBlock(*Ar, Column->GetDoubleValues().GetData(), NumRows * sizeof(double));
+            break;
+        case EXVColumnType::String:
+            Desc.ValuesOffset = WriteBlock(*Ar, Column->GetStringCodes().GetData(), NumRows * sizeof(int32));
+            break;
+        default:
+            Desc.ValuesOffset = WriteBlock(*Ar, nullptr, 0);
+            break;
+        }
+
+        // 字典：先写各项的字节长度，再连续写入UTF-8内容
+        const TConstArrayView<FString> Dictionary = Column ? Column->GetDictionary() : TConstArrayView<FString>();
+        DictionaryBytes.Reset();
+        DictionaryLengths.Reset(Dictionary.Num());
+        for (const FString& Entry : Dictionary)
+        {
+            const FTCHARToUTF8 Utf8(*Entry);
+            DictionaryLengths.Add(Utf8.Length());
+            DictionaryBytes.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length());
+        }
+        Desc.DictionaryCount = Dictionary.Num();
+        Desc.DictionaryOffset = WriteBlock(*Ar, DictionaryLengths.GetData(), DictionaryLengths.Num() * sizeof(int32));
+        Ar->Serialize(DictionaryBytes.GetData(), DictionaryBytes.Num());
+
+        const TConstArrayView<double> DictionaryNumbers = Column ? Column->GetDictionaryNumbers() : TConstArrayView<double>();
+        Desc.DictionaryNumbersOffset = WriteBlock(*Ar, DictionaryNumbers.GetData(), DictionaryNumbers.Num() * sizeof(double));
+    }
+
+    Ar->Seek(DescsOffset);
+    Ar->Serialize(Descs.GetData(), Descs.Num() * sizeof(FColumnDesc));
+
+    const bool bSuccess = Ar->Close() && !Ar->IsError();
+    if (!bSuccess)
+    {
+        OutError = FString::Printf(TEXT("写入文件失败: %s"), *FilePath);
+    }
+    return bSuccess;
+}
+
+bool FXVBinaryDataset::Open(const FString& FilePath, FString& OutError)
+{
+    Close();
+
+    MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*FilePath));
+    if (MappedFile && MappedFile->GetFileSize() > 0)
+    {
+        MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+    }
+
+    if (MappedRegion)
+    {
+        Data = MappedRegion->GetMappedPtr();
+        DataSize = MappedRegion->GetMappedSize();
+    }
+    else
+    {
+        // 平台不支持内存映射时退回到整体读取
+        MappedFile.Reset();
+        if (!FFileHelper::LoadFileToArray(FallbackData, *FilePath))
+        {
+            OutError = FString::Printf(TEXT("无法读取文件: %s"), *FilePath);
+            return false;
+        }
+        Data = FallbackData.GetData();
+        DataSize = FallbackData.Num();
+    }
+
+    if (!Data || !ParseLayout(OutError))
+    {
+        if (OutError.IsEmpty())
+        {
+            OutError = FString::Printf(TEXT("文件为空: %s"), *FilePath);
+        }
+        Close();
+        return false;
+    }
+    return true;
+}
+
+void FXVBinaryDataset::Close()
+{
+    Columns.Empty();
+    RowCount = 0;
+    Data = nullptr;
+    DataSize = 0;
+
+    // 先释放映射区域再关闭文件
+    MappedRegion.Reset();
+    MappedFile.Reset();
+    FallbackData.Empty();
+}
+
+bool FXVBinaryDataset::ParseLayout(FString& OutError)
+{
+    using namespace XVBinaryDatasetPrivate;
+
+    if (DataSize < static_cast<int64>(sizeof(FFileHeader)))
+    {
+        OutError = TEXT("二进制数据集文件头不完整");
+        return false;
+    }
+
+    const FFileHeader& Header = *reinterpret_cast<const FFileHeader*>(Data);
+    if (Header.Magic != FileMagic)
+    {
+        OutError = TEXT("不是有效的二进制数据集文件");
+        return false;
+    }
+    if (Header.Version != FileVersion)
+    {
+        OutError = FString::Printf(TEXT("不支持的二进制数据集版本: %u"), Header.Version);
+        return false;
+    }
+    if (Header.ColumnCount < 0 || Header.RowCount < 0 || Header.RowCount > MAX_int32
+        || !IsBlockInRange(sizeof(FFileHeader), static_cast<int64>(Header.ColumnCount) * sizeof(FColumnDesc), DataSize))
+    {
+        OutError = TEXT("二进制数据集文件头损坏");
+        return false;
+    }
+
+    RowCount = static_cast<int32>(Header.RowCount);
+    const FColumnDesc* Descs = reinterpret_cast<const FColumnDesc*>(Data + sizeof(FFileHeader));
+    Columns.SetNum(Header.ColumnCount);
+
+    for (int32 ColumnIndex = 0; ColumnIndex < Columns.Num(); ++ColumnIndex)
+    {
+        const FColumnDesc& Desc = Descs[ColumnIndex];
+        FColumnView& Column = Columns[ColumnIndex];
+
+        if (Desc.Type > static_cast<uint8>(EXVColumnType::Timestamp))
+        {
+            OutError = FString::Printf(TEXT("第%d列的类型无效"), ColumnIndex);
+            return false;
+        }
+        Column.Type = static_cast<EXVColumnType>(Desc.Type);
+
+        const int64 ValuesBytes = static_cast<int64>(RowCount) * GetValueSize(Column.Type);
+        const int64 DictionaryLengthsBytes = static_cast<int64>(Desc.DictionaryCount) * sizeof(int32);
+        if (Desc.NameBytes < 0 || Desc.DictionaryCount < 0
+            || !IsBlockInRange(Desc.NameOffset, Desc.NameBytes, DataSize)
+            || !IsBlockInRange(Desc.ValidityOffset, static_cast<int64>(NumValidityWords(RowCount)) * sizeof(uint32), DataSize)
+            || !IsBlockInRange(Desc.ValuesOffset, ValuesBytes, DataSize)
+            || !IsBlockInRange(Desc.DictionaryOffset, DictionaryLengthsBytes, DataSize)
+            || !IsBlockInRange(Desc.DictionaryNumbersOffset, static_cast<int64>(Desc.DictionaryCount) * sizeof(double), DataSize))
+        {
+            OutError = FString::Printf(TEXT("第%d列的数据块超出文件范围"), ColumnIndex);
+            return false;
+        }
+
+        const FUTF8ToTCHAR Name(reinterpret_cast<const ANSICHAR*>(Data + Desc.NameOffset), Desc.NameBytes);
+        Column.Name = FString(Name.Length(), Name.Get());
+        Column.ValidityWords = reinterpret_cast<const uint32*>(Data + Desc.ValidityOffset);
+
+        switch (Column.Type)
+        {
+        case EXVColumnType::Int64:
+        case EXVColumnType::Timestamp:
+            Column.Int64Values = MakeArrayView(reinterpret_cast<const int64*>(Data + Desc.ValuesOffset), RowCount);
+            break;
+        case EXVColumnType::Double:
+            Column.DoubleValues = MakeArrayView(reinterpret_cast<const double*>(Data + Desc.ValuesOffset), RowCount);
+            break;
+        case EXVColumnType::String:
+            Column.StringCodes = MakeArrayView(reinterpret_cast<const int32*>(Data + Desc.ValuesOffset), RowCount);
+            break;
+        default:
+            break;
+        }
+
+        // 解码字典，字典内容紧跟在各项长度之后
+        const int32* Lengths = reinterpret_cast<const int32*>(Data + Desc.DictionaryOffset);
+        int64 EntryOffset = Desc.DictionaryOffset + DictionaryLengthsBytes;
+        Column.Dictionary.Reserve(Desc.DictionaryCount);
+        for (int32 Code = 0; Code < Desc.DictionaryCount; ++Code)
+        {
+            if (Lengths[Code] < 0 || Lengths[Code] > DataSize - EntryOffset)
+            {
+                OutError = FString::Printf(TEXT("第%d列的字典损坏"), ColumnIndex);
+                return false;
+            }
+            const FUTF8ToTCHAR Entry(reinterpret_cast<const ANSICHAR*>(Data + EntryOffset), Lengths[Code]);
+            Column.Dictionary.Emplace(Entry.Length(), Entry.Get());
+            EntryOffset += Lengths[Code];
+        }
+        Column.DictionaryNumbers = MakeArrayView(reinterpret_cast<const double*>(Data + Desc.DictionaryNumbersOffset), Desc.DictionaryCount);
+
+        // 字典编码越界会导致读取时访问越界，打开时检查一次
+        for (const int32 Code : Column.StringCodes)
+        {
+            if (Code < INDEX_NONE || Code >= Desc.DictionaryCount)
+            {
+                OutError = FString::Printf(TEXT("第%d列的字典编码越界"), ColumnIndex);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void FXVBinaryDataset::CopyToDataTable(FXVDataTable& OutTable) const
+{
+    TArray<FString> ColumnNames;
+    ColumnNames.Reserve(Columns.Num());
+    for (const FColumnView& Column : Columns)
+    {
+        ColumnNames.Add(Column.Name);
+    }
+
+    TArray<FXVDataColumn> TableColumns;
+    TableColumns.SetNum(Columns.Num());
+    ParallelFor(Columns.Num(), [this, &TableColumns](int32 ColumnIndex)
+    {
+        const FColumnView& Column = Columns[ColumnIndex];
+        TArray<FString> Dictionary = Column.Dictionary;
+        TableColumns[ColumnIndex].AssignBlocks(Column.Type, RowCount, Column.ValidityWords, Column.Int64Values, Column.DoubleValues,
+                                               Column.StringCodes, MoveTemp(Dictionary), Column.DictionaryNumbers);
+    });
+
+    OutTable.AssignColumns(MoveTemp(ColumnNames), MoveTemp(TableColumns));
+}
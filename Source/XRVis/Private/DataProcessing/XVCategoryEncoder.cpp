@@ -0,0 +1,87 @@
+#include "XVCategoryEncoder.h"
+
+void FXVCategoryEncoder::Reserve(int32 ExpectedCategories)
+{
+    Categories.Reserve(ExpectedCategories);
+    LabelIds.Reserve(ExpectedCategories);
+}
+
+int32 FXVCategoryEncoder::Encode(const FString& Key)
+{
+    if (const int32* Id = LabelIds.Find(Key))
+    {
+        return *Id;
+    }
+
+    // 只在首次出现时判断并解析数值
+    const bool bNumeric = Key.IsNumeric();
+    return AddCategory(Key, bNumeric, bNumeric ? FCString::Atod(*Key) : 0.0);
+}
+
+int32 FXVCategoryEncoder::EncodeNumber(double Value)
+{
+    if (const int32* Id = NumberIds.Find(Value))
+    {
+        return *Id;
+    }
+
+    const FString Label = FString::SanitizeFloat(Value, 0);
+    const int32* ExistingId = LabelIds.Find(Label);
+    const int32 Id = ExistingId ? *ExistingId : AddCategory(Label, true, Value);
+    NumberIds.Add(Value, Id);
+    return Id;
+}
+
+void FXVCategoryEncoder::Reset()
+{
+    Categories.Reset();
+    LabelIds.Reset();
+    NumberIds.Reset();
+}
+
+void FXVCategoryEncoder::Finalize(TArray<FString>& OutLabels, TArray<int32>& Indices) const
+{
+    // 对编号排序，比较时使用预先解析的数值
+    TArray<int32> Order;
+    Order.SetNumUninitialized(Categories.Num());
+    for (int32 Id = 0; Id < Order.Num(); ++Id)
+    {
+        Order[Id] = Id;
+    }
+
+    Order.Sort([this](int32 A, int32 B)
+    {
+        const FCategory& CategoryA = Categories[A];
+        const FCategory& CategoryB = Categories[B];
+        if (CategoryA.bNumeric && CategoryB.bNumeric)
+        {
+            return CategoryA.NumericValue < CategoryB.NumericValue;
+        }
+        return CategoryA.Label < CategoryB.Label;
+    });
+
+    TArray<int32> SortedIndex;
+    SortedIndex.SetNumUninitialized(Categories.Num());
+    OutLabels.Reset(Categories.Num());
+    for (int32 Position = 0; Position < Order.Num(); ++Position)
+    {
+        SortedIndex[Order[Position]] = Position;
+        OutLabels.Add(Categories[Order[Position]].Label);
+    }
+
+    for (int32& Index : Indices)
+    {
+        Index = Index == INDEX_NONE ? 0 : SortedIndex[Index];
+    }
+}
+
+int32 FXVCategoryEncoder::AddCategory(const FString& Label, bool bNumeric, double NumericValue)
+{
+    const int32 Id = Categories.Num();
+    FCategory& Category = Categories.AddDefaulted_GetRef();
+    Category.Label = Label;
+    Category.NumericValue = NumericValue;
+    Category.bNumeric = bNumeric;
+    LabelIds.Add(Label, Id);
+    return Id;
+}
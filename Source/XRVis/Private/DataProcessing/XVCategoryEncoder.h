@@ -0,0 +1,51 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 分类轴编码器，单遍扫描把X/Y的取值映射为连续的编号
+ * 数值型的键只在首次出现时解析一次，排序时直接比较解析后的数值，
+ * 因此编码N条记录的代价为线性扫描加上对不同取值的一次排序。
+ */
+class FXVCategoryEncoder
+{
+public:
+    /** 预留不同取值的数量 */
+    void Reserve(int32 ExpectedCategories);
+
+    /** 编码字符串键，返回按首次出现顺序分配的编号 */
+    int32 Encode(const FString& Key);
+
+    /** 编码数值键，标签与FJsonValue::TryGetString的格式一致，因此数值1与字符串"1"属于同一分类 */
+    int32 EncodeNumber(double Value);
+
+    /** 不同取值的数量 */
+    int32 Num() const { return Categories.Num(); }
+
+    /** 清空所有分类 */
+    void Reset();
+
+    /**
+     * 排序所有分类并输出轴标签，同时把Indices中的编号替换为排序后的索引
+     * 两个标签都是数字时按数值排序，否则按字符串排序；INDEX_NONE映射为0
+     */
+    void Finalize(TArray<FString>& OutLabels, TArray<int32>& Indices) const;
+
+private:
+    int32 AddCategory(const FString& Label, bool bNumeric, double NumericValue);
+
+    struct FCategory
+    {
+        FString Label;
+        double NumericValue = 0.0;
+        bool bNumeric = false;
+    };
+
+    TArray<FCategory> Categories;
+
+    /** 标签到编号的映射 */
+    TMap<FString, int32> LabelIds;
+
+    /** 数值键到编号的映射，避免每次都格式化数值 */
+    TMap<double, int32> NumberIds;
+};
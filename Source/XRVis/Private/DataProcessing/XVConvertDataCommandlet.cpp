@@ -0,0 +1,95 @@
+#include "DataProcessing/XVConvertDataCommandlet.h"
+#include "DataProcessing/XVDataManager.h"
+#include "HAL/FileManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/Paths.h"
+
+UXVConvertDataCommandlet::UXVConvertDataCommandlet()
+{
+    IsClient = false;
+    IsServer = false;
+    IsEditor = true;
+    LogToConsole = true;
+}
+
+int32 UXVConvertDataCommandlet::Main(const FString& Params)
+{
+    // 默认转换插件Data目录下的文件
+    FString Source;
+    if (!FParse::Value(*Params, TEXT("Source="), Source))
+    {
+        const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("XRVis"));
+        if (!Plugin.IsValid())
+        {
+            UE_LOG(LogTemp, Error, TEXT("XVConvertData: 找不到XRVis插件，请通过-Source=指定数据目录"));
+            return 1;
+        }
+        Source = FPaths::Combine(Plugin->GetBaseDir(), TEXT("Data"));
+    }
+    Source = FPaths::ConvertRelativePathToFull(Source);
+
+    FString OutputDir;
+    const bool bHasOutputDir = FParse::Value(*Params, TEXT("Output="), OutputDir);
+    const bool bRecursive = FParse::Param(*Params, TEXT("Recursive"));
+
+    // 收集需要转换的文件
+    TArray<FString> SourceFiles;
+    IFileManager& FileManager = IFileManager::Get();
+    if (FileManager.DirectoryExists(*Source))
+    {
+        for (const TCHAR* Pattern : { TEXT("*.csv"), TEXT("*.json") })
+        {
+            TArray<FString> Found;
+            if (bRecursive)
+            {
+                FileManager.FindFilesRecursive(Found, *Source, Pattern, true, false);
+            }
+            else
+            {
+                FileManager.FindFiles(Found, *FPaths::Combine(Source, Pattern), true, false);
+                for (FString& File : Found)
+                {
+                    File = FPaths::Combine(Source, File);
+                }
+            }
+            SourceFiles.Append(Found);
+        }
+    }
+    else if (FileManager.FileExists(*Source))
+    {
+        SourceFiles.Add(Source);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Error, TEXT("XVConvertData: 源路径不存在: %s"), *Source);
+        return 1;
+    }
+
+    UXVDataManager* DataManager = NewObject<UXVDataManager>();
+    int32 NumFailed = 0;
+
+    for (const FString& SourceFile : SourceFiles)
+    {
+        const FString Extension = FPaths::GetExtension(SourceFile);
+        const bool bLoaded = Extension.Equals(TEXT("csv"), ESearchCase::IgnoreCase)
+            ? DataManager->LoadFromCsvFile(SourceFile)
+            : DataManager->LoadFromJsonFile(SourceFile);
+
+        const FString TargetDir = bHasOutputDir ? OutputDir : FPaths::GetPath(SourceFile);
+        const FString TargetFile = FPaths::Combine(TargetDir, FPaths::GetBaseFilename(SourceFile) + TEXT(".") + FXVBinaryDataset::FileExtension);
+
+        if (!bLoaded || !DataManager->SaveToBinaryFile(TargetFile))
+        {
+            UE_LOG(LogTemp, Error, TEXT("XVConvertData: 转换失败 %s - %s"), *SourceFile, *DataManager->GetLastError());
+            ++NumFailed;
+            continue;
+        }
+
+        const FXVDataTable& DataTable = DataManager->GetDataTable();
+        UE_LOG(LogTemp, Display, TEXT("XVConvertData: %s -> %s (%d行, %d列)"), *SourceFile, *TargetFile,
+               DataTable.GetRowCount(), DataTable.GetColumnCount());
+    }
+
+    UE_LOG(LogTemp, Display, TEXT("XVConvertData: 共转换%d个文件，失败%d个"), SourceFiles.Num() - NumFailed, NumFailed);
+    return NumFailed > 0 ? 1 : 0;
+}
@@ -1,10 +1,159 @@
 #include "DataProcessing/XVCsvDataReader.h"
+#include "XVCsvScanner.h"
+#include "XVUtf8FileReader.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "Misc/FileHelper.h"
 
 UXVCsvDataReader::UXVCsvDataReader()
 {
     Delimiter = TEXT(",");
     bHasHeaderRow = true;
     bAutoDetectDelimiter = true;
+    StreamChunkSize = 1024 * 1024;
+    StreamBatchRowCount = 4096;
+    bParallelParse = false;
+    ParallelMinSegmentSize = 1024 * 1024;
+}
+
+FString UXVCsvDataReader::GetCacheOptionsKey() const
+{
+    return FString::Printf(TEXT("%s|%s|%d|%d"), *Super::GetCacheOptionsKey(), *Delimiter, bHasHeaderRow, bAutoDetectDelimiter);
+}
+
+bool UXVCsvDataReader::ReadFromFile(const FString& FilePath)
+{
+    if (bParallelParse)
+    {
+        // 并行解析需要完整的内容，回退到整体读取
+        return Super::ReadFromFile(FilePath);
+    }
+
+    DataTable.Clear();
+    LastError.Empty();
+
+    return StreamFile(FilePath, [this](FXVDataTable& RowBatch)
+    {
+        DataTable.AppendTable(MoveTemp(RowBatch));
+        return true;
+    });
+}
+
+bool UXVCsvDataReader::ReadFromFileStreaming(const FString& FilePath, TFunctionRef<bool(const FXVDataTable& RowBatch)> OnRowBatch)
+{
+    DataTable.Clear();
+    LastError.Empty();
+
+    return StreamFile(FilePath, [&OnRowBatch](FXVDataTable& RowBatch)
+    {
+        return OnRowBatch(RowBatch);
+    });
+}
+
+bool UXVCsvDataReader::StreamFile(const FString& FilePath, TFunctionRef<bool(FXVDataTable& RowBatch)> OnRowBatch)
+{
+    FXVUtf8FileReader FileReader;
+    if (!FileReader.Open(FilePath, StreamChunkSize))
+    {
+        LastError = FString::Printf(TEXT("无法读取文件: %s"), *FilePath);
+        return false;
+    }
+
+    if (FileReader.GetFileSize() <= 0)
+    {
+        LastError = TEXT("CSV内容为空");
+        return false;
+    }
+
+    if (FileReader.IsUtf16())
+    {
+        // UTF-16文件无法按UTF-8分块解码，回退到整体读取
+        UE_LOG(LogTemp, Warning, TEXT("UXVCsvDataReader: %s 不是UTF-8编码，回退为整体读取"), *FilePath);
+        FString FileContent;
+        if (!FFileHelper::LoadFileToString(FileContent, *FilePath))
+        {
+            LastError = FString::Printf(TEXT("无法读取文件: %s"), *FilePath);
+            return false;
+        }
+        if (!ReadFromString(FileContent))
+        {
+            return false;
+        }
+        FXVDataTable Batch = MoveTemp(DataTable);
+        DataTable.ColumnNames = Batch.ColumnNames;
+        DataTable.ResetRows();
+        OnRowBatch(Batch);
+        return true;
+    }
+
+    const int32 BatchRowCount = FMath::Max(StreamBatchRowCount, 1);
+
+    TArray<TCHAR> Text;
+    FCsvStreamState State;
+    FXVDataTable Batch;
+    bool bAborted = false;
+
+    auto FlushBatch = [&]()
+    {
+        if (Batch.GetRowCount() > 0 && !bAborted)
+        {
+            Batch.ColumnNames = DataTable.ColumnNames;
+            bAborted = !OnRowBatch(Batch);
+            Batch.ResetRows();
+        }
+    };
+
+    auto OnRecord = [&](FStringView Record)
+    {
+        HandleRecord(Record, State, Batch);
+        if (Batch.GetRowCount() >= BatchRowCount)
+        {
+            FlushBatch();
+        }
+    };
+
+    while (!FileReader.IsEnd() && !bAborted)
+    {
+        Text.Reset();
+        if (!FileReader.ReadChunk(Text))
+        {
+            LastError = FString::Printf(TEXT("读取文件失败: %s"), *FilePath);
+            return false;
+        }
+
+        if (Text.Num() > 0)
+        {
+            if (State.ActiveDelimiter.IsEmpty())
+            {
+                // 只根据第一块内容检测分隔符
+                State.ActiveDelimiter = bAutoDetectDelimiter ? DetectDelimiter(FStringView(Text.GetData(), Text.Num())) : Delimiter;
+            }
+
+            ConsumeText(Text.GetData(), Text.Num(), State, OnRecord);
+        }
+
+        if (!ReportProgress(FileReader.GetProgress()))
+        {
+            DataTable.Clear();
+            return false;
+        }
+    }
+
+    if (bAborted)
+    {
+        return true;
+    }
+
+    FinishText(State, OnRecord);
+    FlushBatch();
+
+    if (!State.bFirstRecordHandled)
+    {
+        LastError = TEXT("CSV没有有效行");
+        return false;
+    }
+
+    return true;
 }
 
 bool UXVCsvDataReader::ReadFromString(const FString& Content)
@@ -19,176 +168,369 @@ bool UXVCsvDataReader::ReadFromString(const FString& Content)
         return false;
     }
 
+    FCsvStreamState State;
+
     // 如果需要，自动检测分隔符
-    FString CurrentDelimiter = Delimiter;
-    if (bAutoDetectDelimiter)
+    State.ActiveDelimiter = bAutoDetectDelimiter ? DetectDelimiter(Content) : Delimiter;
+
+    if (bParallelParse && Content.Len() >= FMath::Max(ParallelMinSegmentSize, 1024) * 2)
     {
-        CurrentDelimiter = DetectDelimiter(Content);
+        ParseParallel(Content, State);
     }
+    else
+    {
+        auto OnRecord = [this, &State](FStringView Record)
+        {
+            HandleRecord(Record, State, DataTable);
+        };
 
-    // 按行分割
-    TArray<FString> Lines;
-    Content.ParseIntoArrayLines(Lines, false);
+        ConsumeText(*Content, Content.Len(), State, OnRecord);
+        FinishText(State, OnRecord);
+    }
 
-    if (Lines.Num() == 0)
+    if (!State.bFirstRecordHandled)
     {
         LastError = TEXT("CSV没有有效行");
         return false;
     }
 
-    // 处理标题行
-    int32 StartIndex = 0;
-    if (bHasHeaderRow)
+    return true;
+}
+
+void UXVCsvDataReader::ParseParallel(FStringView Content, FCsvStreamState& State)
+{
+    const TCHAR* Text = Content.GetData();
+    const int32 Len = Content.Len();
+
+    // 串行处理第一条记录（标题行或用于确定列数的行）
+    int32 BodyStart = Len;
     {
-        TArray<FString> Headers;
-        ParseCSVRow(Lines[0], Headers);
-        DataTable.ColumnNames = Headers;
-        StartIndex = 1;
+        bool bInQuotes = false;
+        int32 RecordStart = 0;
+        XVCsvScanner::ScanStructural(Text, Len, 0, bInQuotes, [&](int32 Index, TCHAR)
+        {
+            if (Index > RecordStart)
+            {
+                HandleRecord(FStringView(Text + RecordStart, Index - RecordStart), State, DataTable);
+                BodyStart = Index + 1;
+                return false;
+            }
+            RecordStart = Index + 1;
+            return true;
+        });
+
+        if (!State.bFirstRecordHandled)
+        {
+            // 整个内容只有一条记录
+            HandleRecord(FStringView(Text + RecordStart, Len - RecordStart), State, DataTable);
+            return;
+        }
     }
-    else
+
+    const int32 BodyLen = Len - BodyStart;
+    const int32 MinSegmentSize = FMath::Max(ParallelMinSegmentSize, 1024);
+    const int32 MaxSegments = FMath::Max(FTaskGraphInterface::Get().GetNumWorkerThreads() + 1, 1) * 4;
+    const int32 NumSegments = FMath::Clamp(BodyLen / MinSegmentSize, 1, MaxSegments);
+    const int32 SegmentLen = FMath::DivideAndRoundUp(BodyLen, NumSegments);
+
+    // 1. 并行统计每个分段中的引号数量
+    TArray<int32> QuoteCounts;
+    QuoteCounts.SetNumZeroed(NumSegments);
+    ParallelFor(NumSegments, [&](int32 SegmentIndex)
+    {
+        const int32 Start = BodyStart + SegmentIndex * SegmentLen;
+        const int32 End = FMath::Min(Start + SegmentLen, Len);
+        QuoteCounts[SegmentIndex] = XVCsvScanner::CountChar(Text + Start, End - Start, TEXT('"'));
+    });
+
+    // 2. 根据引号数量的前缀奇偶性得到每个分段起点是否处于引号内
+    TArray<bool> StartsInQuotes;
+    StartsInQuotes.SetNumUninitialized(NumSegments);
+    bool bParity = false;
+    for (int32 SegmentIndex = 0; SegmentIndex < NumSegments; ++SegmentIndex)
+    {
+        StartsInQuotes[SegmentIndex] = bParity;
+        bParity ^= (QuoteCounts[SegmentIndex] & 1) != 0;
+    }
+
+    // 3. 并行查找每个分段中第一个引号外的换行，作为切分点
+    TArray<int32> SplitPoints;
+    SplitPoints.SetNumUninitialized(NumSegments);
+    SplitPoints[0] = BodyStart;
+    ParallelFor(NumSegments - 1, [&](int32 Index)
     {
-        // 如果没有标题行，生成默认列名
-        TArray<FString> FirstRow;
-        ParseCSVRow(Lines[0], FirstRow);
-        
-        for (int32 i = 0; i < FirstRow.Num(); ++i)
+        const int32 SegmentIndex = Index + 1;
+        const int32 Start = BodyStart + SegmentIndex * SegmentLen;
+        const int32 End = FMath::Min(Start + SegmentLen, Len);
+        bool bInQuotes = StartsInQuotes[SegmentIndex];
+        SplitPoints[SegmentIndex] = INDEX_NONE;
+        XVCsvScanner::ScanStructural(Text + Start, End - Start, 0, bInQuotes, [&](int32 Index, TCHAR)
         {
-            DataTable.ColumnNames.Add(FString::Printf(TEXT("Column%d"), i));
+            SplitPoints[SegmentIndex] = Start + Index + 1;
+            return false;
+        });
+    });
+
+    // 没有找到切分点的分段并入前一段
+    TArray<int32> ChunkStarts;
+    for (int32 SplitPoint : SplitPoints)
+    {
+        if (SplitPoint != INDEX_NONE)
+        {
+            ChunkStarts.Add(SplitPoint);
         }
     }
+    ChunkStarts.Add(Len);
 
-    // 处理数据行
-    for (int32 i = StartIndex; i < Lines.Num(); ++i)
+    // 4. 并行解析各段，每段写入独立的表
+    const int32 NumChunks = ChunkStarts.Num() - 1;
+    TArray<FXVDataTable> ChunkTables;
+    ChunkTables.SetNum(NumChunks);
+    const FString ActiveDelimiter = State.ActiveDelimiter;
+    ParallelFor(NumChunks, [&](int32 ChunkIndex)
     {
-        if (!Lines[i].IsEmpty())
+        FXVDataTable& ChunkTable = ChunkTables[ChunkIndex];
+        ChunkTable.ColumnNames = DataTable.ColumnNames;
+
+        FCsvStreamState ChunkState;
+        ChunkState.ActiveDelimiter = ActiveDelimiter;
+        ChunkState.bFirstRecordHandled = true;
+
+        auto OnRecord = [this, &ChunkState, &ChunkTable](FStringView Record)
         {
-            TArray<FString> RowCells;
-            ParseCSVRow(Lines[i], RowCells);
-            
-            // 创建数据行
-            FXVDataRow RowData;
-            
-            // 确保行长度与标题数匹配
-            while (RowCells.Num() < DataTable.ColumnNames.Num())
-            {
-                RowCells.Add(TEXT(""));
-            }
-            
-            // 如果行过长，截断
-            if (RowCells.Num() > DataTable.ColumnNames.Num())
+            HandleRecord(Record, ChunkState, ChunkTable);
+        };
+
+        const int32 ChunkStart = ChunkStarts[ChunkIndex];
+        ConsumeText(Text + ChunkStart, ChunkStarts[ChunkIndex + 1] - ChunkStart, ChunkState, OnRecord);
+        FinishText(ChunkState, OnRecord);
+    });
+
+    // 5. 按原始顺序合并
+    DataTable.AppendTables(ChunkTables);
+}
+
+void UXVCsvDataReader::ConsumeText(const TCHAR* Text, int32 Len, FCsvStreamState& State, TFunctionRef<void(FStringView Record)> OnRecord)
+{
+    int32 RecordStart = 0;
+
+    // 只扫描换行，"\r\n" 会在两个换行之间产生一条空记录，由HandleRecord跳过
+    XVCsvScanner::ScanStructural(Text, Len, 0, State.bInQuotes, [&](int32 Index, TCHAR)
+    {
+        // 记录结束，跨块的记录需要先拼接到PendingRecord
+        if (State.PendingRecord.IsEmpty())
+        {
+            OnRecord(FStringView(Text + RecordStart, Index - RecordStart));
+        }
+        else
+        {
+            State.PendingRecord.AppendChars(Text + RecordStart, Index - RecordStart);
+            OnRecord(State.PendingRecord);
+            State.PendingRecord.Reset();
+        }
+        RecordStart = Index + 1;
+        return true;
+    });
+
+    if (RecordStart < Len)
+    {
+        State.PendingRecord.AppendChars(Text + RecordStart, Len - RecordStart);
+    }
+}
+
+void UXVCsvDataReader::FinishText(FCsvStreamState& State, TFunctionRef<void(FStringView Record)> OnRecord)
+{
+    if (!State.PendingRecord.IsEmpty())
+    {
+        OnRecord(State.PendingRecord);
+        State.PendingRecord.Empty();
+    }
+    State.bInQuotes = false;
+}
+
+void UXVCsvDataReader::HandleRecord(FStringView Record, FCsvStreamState& State, FXVDataTable& OutTable)
+{
+    // 空行直接跳过
+    if (Record.IsEmpty())
+    {
+        return;
+    }
+
+    // 复用状态中的缓冲区，避免每条记录分配内存
+    TArray<FStringView>& RowCells = State.FieldViews;
+    RowCells.Reset();
+    State.UnescapedFields.Reset();
+    ParseCSVRow(Record, State.ActiveDelimiter, RowCells, State.UnescapedFields);
+
+    if (!State.bFirstRecordHandled)
+    {
+        State.bFirstRecordHandled = true;
+
+        // 处理标题行
+        if (bHasHeaderRow)
+        {
+            for (const FStringView& Cell : RowCells)
             {
-                RowCells.SetNum(DataTable.ColumnNames.Num());
+                DataTable.ColumnNames.Emplace(Cell);
             }
-            
-            // 设置单元格数据
-            RowData.Cells = RowCells;
-            
-            DataTable.Rows.Add(RowData);
+            OutTable.ColumnNames = DataTable.ColumnNames;
+            return;
         }
+
+        // 如果没有标题行，生成默认列名，第一行仍作为数据
+        for (int32 i = 0; i < RowCells.Num(); ++i)
+        {
+            DataTable.ColumnNames.Add(FString::Printf(TEXT("Column%d"), i));
+        }
+        OutTable.ColumnNames = DataTable.ColumnNames;
     }
 
-    return true;
+    // 行长度与标题数不匹配时，过长截断，过短补空
+    OutTable.AddRow(RowCells);
 }
 
-void UXVCsvDataReader::ParseCSVRow(const FString& InRow, TArray<FString>& OutRow)
+void UXVCsvDataReader::ParseCSVRow(FStringView InRow, const FString& InDelimiter, TArray<FStringView>& OutRow, TArray<FString>& UnescapedFields) const
 {
-    const TCHAR* Start = *InRow;
-    const TCHAR* End = Start + InRow.Len();
-    const TCHAR* Current = Start;
-    bool bInQuotes = false;
-    FString Field;
+    const TCHAR* RowData = InRow.GetData();
 
-    while (Current < End)
+    auto AddField = [&](int32 Start, int32 End)
     {
-        if (*Current == TEXT('"'))
+        const FStringView Field(RowData + Start, End - Start);
+
+        int32 QuoteIndex;
+        if (!Field.FindChar(TEXT('"'), QuoteIndex))
         {
-            bInQuotes = !bInQuotes;
+            // 没有引号，直接引用原始内容
+            OutRow.Add(Field);
+            return;
         }
-        else if (!bInQuotes && Delimiter.Len() == 1 && Delimiter[0] != 0 && *Current == Delimiter[0])
+
+        const FStringView Inner = Field.Len() >= 2 && Field[0] == TEXT('"') && Field[Field.Len() - 1] == TEXT('"') ? Field.Mid(1, Field.Len() - 2) : FStringView();
+        if (!Inner.IsEmpty() && !Inner.FindChar(TEXT('"'), QuoteIndex))
         {
-            // 简单分隔符处理
-            OutRow.Add(Field);
-            Field.Empty();
+            // 整个字段被一对引号包围，去掉引号后仍然是原始内容的视图
+            OutRow.Add(Inner);
+            return;
         }
-        else if (!bInQuotes && Delimiter.Len() > 1 && (End - Current) >= Delimiter.Len() && 
-                FCString::Strncmp(Current, *Delimiter, Delimiter.Len()) == 0)
+
+        // 包含转义引号（""）或不规范的引号，需要生成新的字符串
+        FString& Unescaped = UnescapedFields.AddDefaulted_GetRef();
+        Unescaped.Reserve(Field.Len());
+        bool bInQuotes = false;
+        for (int32 Index = 0; Index < Field.Len(); ++Index)
         {
-            // 多字符分隔符处理
-            OutRow.Add(Field);
-            Field.Empty();
-            Current += (Delimiter.Len() - 1); // -1 因为之后会 ++Current
+            const TCHAR Char = Field[Index];
+            if (Char != TEXT('"'))
+            {
+                Unescaped.AppendChar(Char);
+            }
+            else if (bInQuotes && Index + 1 < Field.Len() && Field[Index + 1] == TEXT('"'))
+            {
+                Unescaped.AppendChar(TEXT('"'));
+                ++Index;
+            }
+            else
+            {
+                bInQuotes = !bInQuotes;
+            }
         }
-        else
+        OutRow.Add(Unescaped);
+    };
+
+    int32 FieldStart = 0;
+    const int32 DelimiterLen = InDelimiter.Len();
+    if (DelimiterLen == 1)
+    {
+        // 单字符分隔符：由扫描器的位掩码直接给出字段边界
+        bool bInQuotes = false;
+        const TCHAR DelimiterChar = InDelimiter[0];
+        XVCsvScanner::ScanStructural(RowData, InRow.Len(), DelimiterChar, bInQuotes, [&](int32 Index, TCHAR Char)
         {
-            Field.AppendChar(*Current);
+            if (Char == DelimiterChar)
+            {
+                AddField(FieldStart, Index);
+                FieldStart = Index + 1;
+            }
+            return true;
+        });
+    }
+    else if (DelimiterLen > 1)
+    {
+        // 多字符分隔符处理
+        bool bInQuotes = false;
+        for (int32 Index = 0; Index < InRow.Len(); ++Index)
+        {
+            if (RowData[Index] == TEXT('"'))
+            {
+                bInQuotes = !bInQuotes;
+            }
+            else if (!bInQuotes && InRow.Len() - Index >= DelimiterLen &&
+                    FCString::Strncmp(RowData + Index, *InDelimiter, DelimiterLen) == 0)
+            {
+                AddField(FieldStart, Index);
+                Index += DelimiterLen - 1; // -1 因为之后会 ++Index
+                FieldStart = Index + 1;
+            }
         }
-        
-        ++Current;
     }
-    
+
     // 添加最后一个字段
-    OutRow.Add(Field);
+    AddField(FieldStart, InRow.Len());
 }
 
-FString UXVCsvDataReader::DetectDelimiter(const FString& Content)
+FString UXVCsvDataReader::DetectDelimiter(FStringView Content) const
 {
     // 常用的CSV分隔符
-    TArray<FString> CommonDelimiters = { TEXT(","), TEXT(";"), TEXT("\t"), TEXT("|") };
-    
-    // 对每种分隔符，计算在前几行中出现的次数
-    TMap<FString, int32> DelimiterCounts;
-    
-    // 只检查前几行
-    TArray<FString> Lines;
-    Content.ParseIntoArrayLines(Lines, false);
-    int32 LinesToCheck = FMath::Min(10, Lines.Num());
-    
-    for (int32 i = 0; i < LinesToCheck; ++i)
-    {
-        for (const FString& Delim : CommonDelimiters)
-        {
-            int32 Count = 0;
-            const TCHAR* Start = *Lines[i];
-            const TCHAR* End = Start + Lines[i].Len();
-            const TCHAR* Current = Start;
-            bool bInQuotes = false;
-            
-            while (Current < End)
+    static const TCHAR CommonDelimiters[] = { TEXT(','), TEXT(';'), TEXT('\t'), TEXT('|') };
+    int32 DelimiterCounts[UE_ARRAY_COUNT(CommonDelimiters)] = {};
+
+    // 只检查前几行，按块统计引号外的各分隔符数量
+    const int32 MaxLinesToCheck = 10;
+    int32 LinesChecked = 0;
+    bool bInQuotes = false;
+
+    for (int32 BlockStart = 0; BlockStart < Content.Len() && LinesChecked < MaxLinesToCheck; BlockStart += XVCsvScanner::BlockSize)
+    {
+        const int32 Count = FMath::Min(XVCsvScanner::BlockSize, Content.Len() - BlockStart);
+        const XVCsvScanner::FBlock Block(Content.GetData() + BlockStart, Count);
+
+        const uint64 Quotes = Block.Match(TEXT('"'));
+        const uint64 InQuotes = XVCsvScanner::PrefixXor(Quotes) ^ (bInQuotes ? ~0ull : 0ull);
+        uint64 Outside = ~InQuotes & XVCsvScanner::LowBitsMask(Count);
+
+        // 到达行数上限时只统计该行之前的部分
+        uint64 LineFeeds = Block.Match(TEXT('\n')) & Outside;
+        const int32 NumLineFeeds = static_cast<int32>(FMath::CountBits(LineFeeds));
+        if (LinesChecked + NumLineFeeds >= MaxLinesToCheck)
+        {
+            for (int32 Skip = MaxLinesToCheck - LinesChecked - 1; Skip > 0; --Skip)
             {
-                if (*Current == TEXT('"'))
-                {
-                    bInQuotes = !bInQuotes;
-                }
-                else if (!bInQuotes && Delim.Len() == 1 && Delim[0] != 0 && *Current == Delim[0])
-                {
-                    Count++;
-                }
-                else if (!bInQuotes && Delim.Len() > 1 && (End - Current) >= Delim.Len() &&
-                        FCString::Strncmp(Current, *Delim, Delim.Len()) == 0)
-                {
-                    Count++;
-                    Current += (Delim.Len() - 1);
-                }
-                
-                ++Current;
+                LineFeeds &= LineFeeds - 1;
             }
-            
-            DelimiterCounts.FindOrAdd(Delim) += Count;
+            Outside &= XVCsvScanner::LowBitsMask(static_cast<int32>(FMath::CountTrailingZeros64(LineFeeds)));
+        }
+        LinesChecked += NumLineFeeds;
+
+        for (int32 DelimIndex = 0; DelimIndex < UE_ARRAY_COUNT(CommonDelimiters); ++DelimIndex)
+        {
+            DelimiterCounts[DelimIndex] += static_cast<int32>(FMath::CountBits(Block.Match(CommonDelimiters[DelimIndex]) & Outside));
         }
+
+        bInQuotes ^= (FMath::CountBits(Quotes) & 1) != 0;
     }
-    
+
     // 查找出现次数最多的分隔符
     FString BestDelimiter = Delimiter; // 默认
     int32 MaxCount = 0;
-    
-    for (const TPair<FString, int32>& Pair : DelimiterCounts)
+
+    for (int32 DelimIndex = 0; DelimIndex < UE_ARRAY_COUNT(CommonDelimiters); ++DelimIndex)
     {
-        if (Pair.Value > MaxCount)
+        if (DelimiterCounts[DelimIndex] > MaxCount)
         {
-            MaxCount = Pair.Value;
-            BestDelimiter = Pair.Key;
+            MaxCount = DelimiterCounts[DelimIndex];
+            BestDelimiter = FString::Chr(CommonDelimiters[DelimIndex]);
         }
     }
-    
+
     return BestDelimiter;
-} 
\ No newline at end of file
+}
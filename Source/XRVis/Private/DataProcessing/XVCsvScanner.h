@@ -0,0 +1,182 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if PLATFORM_ENABLE_VECTORINTRINSICS_NEON
+#include <arm_neon.h>
+#define XV_CSV_SCANNER_NEON 1
+#define XV_CSV_SCANNER_SSE2 0
+#elif PLATFORM_ENABLE_VECTORINTRINSICS && PLATFORM_CPU_X86_FAMILY
+#include <emmintrin.h>
+#define XV_CSV_SCANNER_NEON 0
+#define XV_CSV_SCANNER_SSE2 1
+#else
+#define XV_CSV_SCANNER_NEON 0
+#define XV_CSV_SCANNER_SSE2 0
+#endif
+
+/**
+ * CSV结构字符扫描器
+ * 每次处理64个TCHAR，为引号、分隔符和换行生成位掩码，再通过引号掩码的前缀异或得到“引号内”掩码，
+ * 从而一次性得到引号外的字段边界和记录边界。
+ * x86上使用SSE2（引擎默认不开启AVX2），ARM上使用NEON，其他平台使用标量实现。
+ */
+namespace XVCsvScanner
+{
+    /** 每个块包含的字符数 */
+    constexpr int32 BlockSize = 64;
+
+    /** 已加载的一个字符块 */
+    struct FBlock
+    {
+        explicit FBlock(const TCHAR* Text, int32 Count)
+        {
+            static_assert(sizeof(TCHAR) == 2, "XVCsvScanner 假定TCHAR为16位");
+
+            const TCHAR* Source = Text;
+            if (Count < BlockSize)
+            {
+                // 末尾不足一个块时拷贝到补零的缓冲区，0不会匹配任何结构字符
+                FMemory::Memzero(Padded, sizeof(Padded));
+                FMemory::Memcpy(Padded, Text, Count * sizeof(TCHAR));
+                Source = Padded;
+            }
+
+#if XV_CSV_SCANNER_SSE2
+            for (int32 Lane = 0; Lane < 8; ++Lane)
+            {
+                Vectors[Lane] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(Source + Lane * 8));
+            }
+#elif XV_CSV_SCANNER_NEON
+            for (int32 Lane = 0; Lane < 8; ++Lane)
+            {
+                Vectors[Lane] = vld1q_u16(reinterpret_cast<const uint16*>(Source + Lane * 8));
+            }
+#else
+            Chars = Source;
+#endif
+        }
+
+        /** 返回块中等于Char的位置掩码，第i位对应第i个字符 */
+        FORCEINLINE uint64 Match(TCHAR Char) const
+        {
+#if XV_CSV_SCANNER_SSE2
+            const __m128i Needle = _mm_set1_epi16(static_cast<short>(Char));
+            uint64 Mask = 0;
+            for (int32 Pair = 0; Pair < 4; ++Pair)
+            {
+                const __m128i Lo = _mm_cmpeq_epi16(Vectors[Pair * 2], Needle);
+                const __m128i Hi = _mm_cmpeq_epi16(Vectors[Pair * 2 + 1], Needle);
+                // 比较结果为0或-1，饱和压缩为8位后取符号位
+                const uint32 Bits = static_cast<uint32>(_mm_movemask_epi8(_mm_packs_epi16(Lo, Hi)));
+                Mask |= static_cast<uint64>(Bits) << (Pair * 16);
+            }
+            return Mask;
+#elif XV_CSV_SCANNER_NEON
+            static const uint8 BitWeights[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+            const uint8x16_t Weights = vld1q_u8(BitWeights);
+            const uint16x8_t Needle = vdupq_n_u16(static_cast<uint16>(Char));
+            uint64 Mask = 0;
+            for (int32 Pair = 0; Pair < 4; ++Pair)
+            {
+                const uint8x16_t Narrow = vcombine_u8(
+                    vmovn_u16(vceqq_u16(Vectors[Pair * 2], Needle)),
+                    vmovn_u16(vceqq_u16(Vectors[Pair * 2 + 1], Needle)));
+                const uint8x16_t Weighted = vandq_u8(Narrow, Weights);
+                const uint64 Bits = static_cast<uint64>(vaddv_u8(vget_low_u8(Weighted))) | (static_cast<uint64>(vaddv_u8(vget_high_u8(Weighted))) << 8);
+                Mask |= Bits << (Pair * 16);
+            }
+            return Mask;
+#else
+            uint64 Mask = 0;
+            for (int32 Index = 0; Index < BlockSize; ++Index)
+            {
+                Mask |= static_cast<uint64>(Chars[Index] == Char) << Index;
+            }
+            return Mask;
+#endif
+        }
+
+    private:
+#if XV_CSV_SCANNER_SSE2
+        __m128i Vectors[8];
+#elif XV_CSV_SCANNER_NEON
+        uint16x8_t Vectors[8];
+#else
+        const TCHAR* Chars = nullptr;
+#endif
+        TCHAR Padded[BlockSize];
+    };
+
+    /** 前缀异或：第i位为掩码中0..i位的异或，用于从引号位置得到“引号内”区域 */
+    FORCEINLINE uint64 PrefixXor(uint64 Mask)
+    {
+        Mask ^= Mask << 1;
+        Mask ^= Mask << 2;
+        Mask ^= Mask << 4;
+        Mask ^= Mask << 8;
+        Mask ^= Mask << 16;
+        Mask ^= Mask << 32;
+        return Mask;
+    }
+
+    /** 低Count位为1的掩码 */
+    FORCEINLINE uint64 LowBitsMask(int32 Count)
+    {
+        return Count >= BlockSize ? ~0ull : ((1ull << Count) - 1);
+    }
+
+    /**
+     * 扫描文本中位于引号外的结构字符（换行符'\n'/'\r'，以及Delimiter不为0时的分隔符）
+     * 对每个结构字符按顺序调用 OnStructural(int32 Index, TCHAR Char)，回调返回false时停止扫描
+     * bInQuotes 输入为扫描起点是否处于引号内，输出为扫描结束（或停止）处的引号状态
+     * @return 是否因回调返回false而提前停止
+     */
+    template <typename CallbackType>
+    FORCEINLINE bool ScanStructural(const TCHAR* Text, int32 Len, TCHAR Delimiter, bool& bInQuotes, CallbackType&& OnStructural)
+    {
+        for (int32 BlockStart = 0; BlockStart < Len; BlockStart += BlockSize)
+        {
+            const int32 Count = FMath::Min(BlockSize, Len - BlockStart);
+            const FBlock Block(Text + BlockStart, Count);
+
+            const uint64 Quotes = Block.Match(TEXT('"'));
+            const uint64 InQuotes = PrefixXor(Quotes) ^ (bInQuotes ? ~0ull : 0ull);
+
+            uint64 Structural = Block.Match(TEXT('\n')) | Block.Match(TEXT('\r'));
+            if (Delimiter != 0)
+            {
+                Structural |= Block.Match(Delimiter);
+            }
+            Structural &= ~InQuotes & LowBitsMask(Count);
+
+            while (Structural != 0)
+            {
+                const int32 Bit = static_cast<int32>(FMath::CountTrailingZeros64(Structural));
+                const int32 Index = BlockStart + Bit;
+                if (!OnStructural(Index, Text[Index]))
+                {
+                    // 结构字符一定位于引号外
+                    bInQuotes = false;
+                    return true;
+                }
+                Structural &= Structural - 1;
+            }
+
+            bInQuotes ^= (FMath::CountBits(Quotes) & 1) != 0;
+        }
+        return false;
+    }
+
+    /** 统计文本中某个字符出现的次数 */
+    FORCEINLINE int32 CountChar(const TCHAR* Text, int32 Len, TCHAR Char)
+    {
+        int32 Count = 0;
+        for (int32 BlockStart = 0; BlockStart < Len; BlockStart += BlockSize)
+        {
+            const int32 BlockCount = FMath::Min(BlockSize, Len - BlockStart);
+            Count += static_cast<int32>(FMath::CountBits(FBlock(Text + BlockStart, BlockCount).Match(Char) & LowBitsMask(BlockCount)));
+        }
+        return Count;
+    }
+}
@@ -0,0 +1,187 @@
+#include "DataProcessing/XVDataCacheSubsystem.h"
+#include "Engine/Engine.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+UXVDataCacheSubsystem::UXVDataCacheSubsystem()
+    : MaxCacheBytes(512ll * 1024 * 1024)
+{
+}
+
+UXVDataCacheSubsystem* UXVDataCacheSubsystem::Get()
+{
+    return GEngine ? GEngine->GetEngineSubsystem<UXVDataCacheSubsystem>() : nullptr;
+}
+
+void UXVDataCacheSubsystem::Deinitialize()
+{
+    ClearCache();
+    Super::Deinitialize();
+}
+
+UXVDataCacheSubsystem::FTablePtr UXVDataCacheSubsystem::FindOrLoad(const FString& FilePath, const FString& OptionsKey, TFunctionRef<FTablePtr()> Load)
+{
+    const FString NormalizedPath = FPaths::ConvertRelativePathToFull(FilePath);
+    const FFileStatData StatData = IFileManager::Get().GetStatData(*NormalizedPath);
+    if (!StatData.bIsValid || StatData.bIsDirectory)
+    {
+        // 文件不存在时不缓存，由读取器给出错误信息
+        return Load();
+    }
+
+    // Windows路径不区分大小写，键统一使用小写路径
+    const FString Key = FString::Printf(TEXT("%s|%lld|%lld|%s"), *NormalizedPath.ToLower(), StatData.ModificationTime.GetTicks(),
+                                        StatData.FileSize, *OptionsKey);
+
+    TSharedPtr<TPromise<FTablePtr>, ESPMode::ThreadSafe> Promise;
+    TSharedFuture<FTablePtr> PendingResult;
+    {
+        FScopeLock ScopeLock(&Lock);
+        if (FEntry* Entry = Entries.Find(Key))
+        {
+            Entry->LastAccess = ++AccessCounter;
+            return Entry->Table;
+        }
+
+        if (const TSharedFuture<FTablePtr>* Pending = PendingLoads.Find(Key))
+        {
+            PendingResult = *Pending;
+        }
+        else
+        {
+            Promise = MakeShared<TPromise<FTablePtr>, ESPMode::ThreadSafe>();
+            PendingLoads.Add(Key, Promise->GetFuture().Share());
+        }
+    }
+
+    // 其他调用者正在读取同一个文件，等待其结果
+    if (!Promise.IsValid())
+    {
+        return PendingResult.Get();
+    }
+
+    FTablePtr Table = Load();
+    {
+        FScopeLock ScopeLock(&Lock);
+        PendingLoads.Remove(Key);
+        if (Table.IsValid())
+        {
+            AddEntryLocked(Key, NormalizedPath, StatData, Table);
+        }
+    }
+    Promise->SetValue(Table);
+    return Table;
+}
+
+void UXVDataCacheSubsystem::ClearCache()
+{
+    FScopeLock ScopeLock(&Lock);
+    Entries.Empty();
+    TotalBytes = 0;
+}
+
+void UXVDataCacheSubsystem::InvalidateFile(const FString& FilePath)
+{
+    const FString NormalizedPath = FPaths::ConvertRelativePathToFull(FilePath);
+
+    FScopeLock ScopeLock(&Lock);
+    TArray<FString> Keys;
+    for (const TPair<FString, FEntry>& Pair : Entries)
+    {
+        if (Pair.Value.FilePath.Equals(NormalizedPath, ESearchCase::IgnoreCase))
+        {
+            Keys.Add(Pair.Key);
+        }
+    }
+    for (const FString& Key : Keys)
+    {
+        RemoveEntryLocked(Key);
+    }
+}
+
+int32 UXVDataCacheSubsystem::GetNumCachedTables() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return Entries.Num();
+}
+
+int64 UXVDataCacheSubsystem::GetCachedBytes() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return TotalBytes;
+}
+
+void UXVDataCacheSubsystem::SetMaxCacheBytes(int64 InMaxCacheBytes)
+{
+    FScopeLock ScopeLock(&Lock);
+    MaxCacheBytes = FMath::Max<int64>(InMaxCacheBytes, 0);
+    EvictLocked();
+}
+
+int64 UXVDataCacheSubsystem::GetMaxCacheBytes() const
+{
+    FScopeLock ScopeLock(&Lock);
+    return MaxCacheBytes;
+}
+
+void UXVDataCacheSubsystem::AddEntryLocked(const FString& Key, const FString& NormalizedPath, const FFileStatData& StatData, const FTablePtr& Table)
+{
+    // 文件被修改后旧版本的缓存不会再命中，直接移除
+    TArray<FString> StaleKeys;
+    for (const TPair<FString, FEntry>& Pair : Entries)
+    {
+        const FEntry& Other = Pair.Value;
+        if (Other.FilePath.Equals(NormalizedPath, ESearchCase::IgnoreCase)
+            && (Other.ModificationTime != StatData.ModificationTime || Other.FileSize != StatData.FileSize))
+        {
+            StaleKeys.Add(Pair.Key);
+        }
+    }
+    for (const FString& StaleKey : StaleKeys)
+    {
+        RemoveEntryLocked(StaleKey);
+    }
+
+    RemoveEntryLocked(Key);
+
+    FEntry& Entry = Entries.Add(Key);
+    Entry.FilePath = NormalizedPath;
+    Entry.ModificationTime = StatData.ModificationTime;
+    Entry.FileSize = StatData.FileSize;
+    Entry.Table = Table;
+    Entry.Bytes = Table->GetAllocatedSize();
+    Entry.LastAccess = ++AccessCounter;
+    TotalBytes += Entry.Bytes;
+
+    EvictLocked();
+}
+
+void UXVDataCacheSubsystem::EvictLocked()
+{
+    while (TotalBytes > MaxCacheBytes && Entries.Num() > 1)
+    {
+        // 缓存项数量很少，线性查找最久未使用的项即可
+        const FString* OldestKey = nullptr;
+        uint64 OldestAccess = MAX_uint64;
+        for (const TPair<FString, FEntry>& Pair : Entries)
+        {
+            if (Pair.Value.LastAccess < OldestAccess)
+            {
+                OldestAccess = Pair.Value.LastAccess;
+                OldestKey = &Pair.Key;
+            }
+        }
+
+        const FString Key = *OldestKey;
+        RemoveEntryLocked(Key);
+    }
+}
+
+void UXVDataCacheSubsystem::RemoveEntryLocked(const FString& Key)
+{
+    FEntry Removed;
+    if (Entries.RemoveAndCopyValue(Key, Removed))
+    {
+        TotalBytes -= Removed.Bytes;
+    }
+}
@@ -1,142 +1,622 @@
 #include "DataProcessing/XVDataConverter.h"
+#include "DataProcessing/XVTimestampParser.h"
+#include "XVCategoryEncoder.h"
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonSerializer.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include <algorithm>
+
+namespace XVDataConverterPrivate
+{
+    /** 按列读取 [Y, X, Z] 三列数值填充类型化数据 */
+    bool FillGridFromColumns(const FXVDataTable& DataTable, int32 XColIdx, int32 YColIdx, int32 ZColIdx, FXVChartGridData& OutGrid)
+    {
+        OutGrid.Reset();
+
+        // 检查列索引是否有效
+        if (XColIdx == INDEX_NONE || YColIdx == INDEX_NONE || ZColIdx == INDEX_NONE)
+        {
+            return false;
+        }
+
+        // 表中没有行时列可能尚未创建
+        const FXVDataColumn* XCol = DataTable.GetColumn(XColIdx);
+        const FXVDataColumn* YCol = DataTable.GetColumn(YColIdx);
+        const FXVDataColumn* ZCol = DataTable.GetColumn(ZColIdx);
+        const int32 NumRows = XCol && YCol && ZCol ? DataTable.GetRowCount() : 0;
+        OutGrid.Reserve(NumRows);
+
+        for (int32 i = 0; i < NumRows; ++i)
+        {
+            // 注意：图表数据的顺序为 [Y, X, Z]
+            OutGrid.Add(static_cast<int32>(YCol->GetNumber(i)), static_cast<int32>(XCol->GetNumber(i)), static_cast<float>(ZCol->GetNumber(i)));
+        }
+        return true;
+    }
+
+    /** 编码命名数据中作为分类键的值，字符串和布尔值按标签编码，数字按数值编码；无法作为键时返回INDEX_NONE */
+    int32 EncodeKeyValue(const TSharedPtr<FJsonValue>& Value, FXVCategoryEncoder& Encoder)
+    {
+        if (Value->Type == EJson::Number)
+        {
+            return Encoder.EncodeNumber(Value->AsNumber());
+        }
+
+        FString Key;
+        return Value->TryGetString(Key) ? Encoder.Encode(Key) : INDEX_NONE;
+    }
+
+    /** 按列名查找列，与JSON对象的键一样不区分大小写 */
+    int32 FindColumnIgnoreCase(const FXVDataTable& DataTable, const FString& ColumnName)
+    {
+        return DataTable.ColumnNames.IndexOfByPredicate([&ColumnName](const FString& Name)
+        {
+            return Name.Equals(ColumnName, ESearchCase::IgnoreCase);
+        });
+    }
+
+    /** 将单元格作为分类键编码，字符串列的每个字典项只编码一次（结果缓存在DictionaryIds中），数值列按数值编码 */
+    int32 EncodeKeyCell(const FXVDataColumn& Column, int32 Row, FXVCategoryEncoder& Encoder, TArray<int32>& DictionaryIds)
+    {
+        switch (Column.GetType())
+        {
+        case EXVColumnType::String:
+            {
+                if (DictionaryIds.IsEmpty())
+                {
+                    DictionaryIds.Init(INDEX_NONE, Column.GetDictionary().Num());
+                }
+
+                const int32 Code = Column.GetStringCodes()[Row];
+                if (DictionaryIds[Code] == INDEX_NONE)
+                {
+                    DictionaryIds[Code] = Encoder.Encode(Column.GetDictionary()[Code]);
+                }
+                return DictionaryIds[Code];
+            }
+        case EXVColumnType::Timestamp:
+            // JSON中的时间戳原本是字符串，按字符串编码
+            return Encoder.Encode(Column.GetString(Row));
+        default:
+            return Encoder.EncodeNumber(Column.GetNumber(Row));
+        }
+    }
+
+    /** 读取时间列的值，时间戳为Unix秒，非数值时返回Default */
+    double GetTimeValue(const FXVDataColumn& Column, int32 Row, double Default)
+    {
+        if (!Column.IsValid(Row))
+        {
+            return Default;
+        }
+
+        switch (Column.GetType())
+        {
+        case EXVColumnType::Int64:
+        case EXVColumnType::Double:
+        case EXVColumnType::Timestamp:
+            return Column.GetNumber(Row);
+        case EXVColumnType::String:
+            {
+                const int32 Code = Column.GetStringCodes()[Row];
+                return Column.GetDictionary()[Code].IsNumeric() ? Column.GetDictionaryNumbers()[Code] : Default;
+            }
+        default:
+            return Default;
+        }
+    }
+
+    /** 一个X/Y分组的聚合状态 */
+    struct FGroupAccumulator
+    {
+        double Sum = 0.0;
+        double Min = TNumericLimits<double>::Max();
+        double Max = TNumericLimits<double>::Lowest();
+        int64 Count = 0;
+
+        /** 分组中最靠前的行，用于生成轴标签 */
+        int32 FirstRow = MAX_int32;
+
+        /** 分组中的所有值，只在计算百分位数时收集 */
+        TArray<float> Values;
+
+        void Merge(FGroupAccumulator& Other)
+        {
+            Sum += Other.Sum;
+            Min = FMath::Min(Min, Other.Min);
+            Max = FMath::Max(Max, Other.Max);
+            Count += Other.Count;
+            FirstRow = FMath::Min(FirstRow, Other.FirstRow);
+            Values.Append(MoveTemp(Other.Values));
+        }
+    };
+
+    using FGroupKey = TPair<uint64, uint64>;
+    using FGroupMap = TMap<FGroupKey, FGroupAccumulator>;
+
+    /** 单元格的分组键：字符串列为字典编码，其他列为数值的位模式，与EncodeKeyCell的分类一一对应 */
+    uint64 GetGroupKey(const FXVDataColumn& Column, int32 Row)
+    {
+        switch (Column.GetType())
+        {
+        case EXVColumnType::String:
+            return static_cast<uint32>(Column.GetStringCodes()[Row]);
+        case EXVColumnType::Int64:
+        case EXVColumnType::Timestamp:
+            return static_cast<uint64>(Column.GetInt64Values()[Row]);
+        default:
+            {
+                // +0与-0视为同一个键
+                const double Value = Column.GetNumber(Row) + 0.0;
+                uint64 Bits;
+                FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+                return Bits;
+            }
+        }
+    }
+
+    /** 按线性插值计算百分位数，会打乱Values的顺序 */
+    float ComputePercentile(TArray<float>& Values, float Percentile)
+    {
+        const double Rank = FMath::Clamp(Percentile, 0.0f, 100.0f) / 100.0 * (Values.Num() - 1);
+        const int32 Lower = FMath::FloorToInt32(Rank);
+        float* Begin = Values.GetData();
+        float* End = Begin + Values.Num();
+        std::nth_element(Begin, Begin + Lower, End);
+        const float LowerValue = Values[Lower];
+        if (Lower + 1 >= Values.Num())
+        {
+            return LowerValue;
+        }
+        // nth_element之后Lower之后的元素都不小于LowerValue，其中的最小值即为下一个顺序统计量
+        const float UpperValue = *std::min_element(Begin + Lower + 1, End);
+        return static_cast<float>(LowerValue + (UpperValue - LowerValue) * (Rank - Lower));
+    }
+
+    /** 按聚合方式得到分组的结果 */
+    float FinishGroup(FGroupAccumulator& Group, EXVAggregation Aggregation, float Percentile)
+    {
+        switch (Aggregation)
+        {
+        case EXVAggregation::Sum:
+            return static_cast<float>(Group.Sum);
+        case EXVAggregation::Mean:
+            return static_cast<float>(Group.Sum / Group.Count);
+        case EXVAggregation::Count:
+            return static_cast<float>(Group.Count);
+        case EXVAggregation::Min:
+            return static_cast<float>(Group.Min);
+        case EXVAggregation::Max:
+            return static_cast<float>(Group.Max);
+        case EXVAggregation::Percentile:
+            return ComputePercentile(Group.Values, Percentile);
+        default:
+            return 0.0f;
+        }
+    }
+}
 
 FString UXVDataConverter::ConvertToBarChartFormat(const FXVDataTable& DataTable, const FString& XColumn, const FString& YColumn, const FString& ZColumn)
 {
-    // 查找列索引
-    int32 XColIdx = FindColumnIndex(DataTable, XColumn);
-    int32 YColIdx = FindColumnIndex(DataTable, YColumn);
-    int32 ZColIdx = FindColumnIndex(DataTable, ZColumn);
+    FXVChartGridData Grid;
+    if (!ConvertToBarChartGrid(DataTable, XColumn, YColumn, ZColumn, Grid))
+    {
+        return TEXT("");
+    }
+    return SerializeGrid(Grid);
+}
 
-    // 检查列索引是否有效
-    if (XColIdx == INDEX_NONE || YColIdx == INDEX_NONE || ZColIdx == INDEX_NONE)
+FString UXVDataConverter::ConvertToLineChartFormat(const FXVDataTable& DataTable, const FString& XColumn, const FString& YColumn, const FString& ZColumn)
+{
+    FXVChartGridData Grid;
+    if (!ConvertToLineChartGrid(DataTable, XColumn, YColumn, ZColumn, Grid))
     {
         return TEXT("");
     }
 
-    // 创建JSON数组
-    TArray<TSharedPtr<FJsonValue>> JsonArray;
+    // 折线图的值为整数
+    for (float& Value : Grid.Values)
+    {
+        Value = static_cast<float>(static_cast<int32>(Value));
+    }
+    return SerializeGrid(Grid);
+}
+
+TMap<FString, float> UXVDataConverter::ConvertToPieChartFormat(const FXVDataTable& DataTable, const FString& LabelColumn, const FString& ValueColumn)
+{
+    TMap<FString, float> Result;
 
-    for (int32 i = 0; i < DataTable.GetRowCount(); ++i)
+    FXVChartGridData Grid;
+    if (ConvertToPieChartGrid(DataTable, LabelColumn, ValueColumn, Grid))
     {
-        const FXVDataRow& Row = DataTable.Rows[i];
-        
-        // 确保行有足够的列
-        if (Row.Cells.Num() > FMath::Max3(XColIdx, YColIdx, ZColIdx))
+        for (int32 i = 0; i < Grid.Num(); ++i)
         {
-            // 创建一个包含三个值的数组 [Y, X, Z]
-            TArray<TSharedPtr<FJsonValue>> RowArray;
-            
-            // 注意：柱状图的格式为 [Y, X, Z] - 确保顺序正确
-            int32 Y = FCString::Atoi(*Row.Cells[YColIdx]);
-            int32 X = FCString::Atoi(*Row.Cells[XColIdx]);
-            float Z = FCString::Atof(*Row.Cells[ZColIdx]);
-            
-            RowArray.Add(MakeShared<FJsonValueNumber>(Y));
-            RowArray.Add(MakeShared<FJsonValueNumber>(X));
-            RowArray.Add(MakeShared<FJsonValueNumber>(Z));
-            
-            JsonArray.Add(MakeShared<FJsonValueArray>(RowArray));
+            // 添加或更新值
+            Result.FindOrAdd(Grid.XLabels[Grid.XIndices[i]]) += Grid.Values[i];
         }
     }
 
-    // 序列化JSON
-    FString OutputString;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
-    FJsonSerializer::Serialize(JsonArray, Writer);
+    return Result;
+}
 
-    return OutputString;
+bool UXVDataConverter::ConvertToBarChartGrid(const FXVDataTable& DataTable, const FString& XColumn, const FString& YColumn, const FString& ZColumn, FXVChartGridData& OutGrid)
+{
+    return XVDataConverterPrivate::FillGridFromColumns(DataTable,
+        FindColumnIndex(DataTable, XColumn), FindColumnIndex(DataTable, YColumn), FindColumnIndex(DataTable, ZColumn), OutGrid);
 }
 
-FString UXVDataConverter::ConvertToLineChartFormat(const FXVDataTable& DataTable, const FString& XColumn, const FString& YColumn, const FString& ZColumn)
+bool UXVDataConverter::ConvertToLineChartGrid(const FXVDataTable& DataTable, const FString& XColumn, const FString& YColumn, const FString& ZColumn, FXVChartGridData& OutGrid)
+{
+    return XVDataConverterPrivate::FillGridFromColumns(DataTable,
+        FindColumnIndex(DataTable, XColumn), FindColumnIndex(DataTable, YColumn), FindColumnIndex(DataTable, ZColumn), OutGrid);
+}
+
+bool UXVDataConverter::ConvertToPieChartGrid(const FXVDataTable& DataTable, const FString& LabelColumn, const FString& ValueColumn, FXVChartGridData& OutGrid)
 {
+    OutGrid.Reset();
+
     // 查找列索引
-    int32 XColIdx = FindColumnIndex(DataTable, XColumn);
-    int32 YColIdx = FindColumnIndex(DataTable, YColumn);
-    int32 ZColIdx = FindColumnIndex(DataTable, ZColumn);
+    const int32 LabelColIdx = FindColumnIndex(DataTable, LabelColumn);
+    const int32 ValueColIdx = FindColumnIndex(DataTable, ValueColumn);
+    if (LabelColIdx == INDEX_NONE || ValueColIdx == INDEX_NONE)
+    {
+        return false;
+    }
 
-    // 检查列索引是否有效
-    if (XColIdx == INDEX_NONE || YColIdx == INDEX_NONE || ZColIdx == INDEX_NONE)
+    // 表中没有行时列可能尚未创建
+    const FXVDataColumn* LabelCol = DataTable.GetColumn(LabelColIdx);
+    const FXVDataColumn* ValueCol = DataTable.GetColumn(ValueColIdx);
+    if (!LabelCol || !ValueCol)
     {
-        return TEXT("");
+        return true;
     }
 
-    // 创建JSON数组
-    TArray<TSharedPtr<FJsonValue>> JsonArray;
+    // 每个类别在结果中的位置，INDEX_NONE表示尚未出现
+    TArray<float> Sums;
+    auto Accumulate = [&OutGrid, &Sums](int32& CategorySlot, const FString& Label, float Value)
+    {
+        if (CategorySlot == INDEX_NONE)
+        {
+            CategorySlot = OutGrid.XLabels.Add(Label);
+            Sums.Add(0.0f);
+        }
+        Sums[CategorySlot] += Value;
+    };
+
+    int32 NullLabelSlot = INDEX_NONE;
+    if (LabelCol->GetType() == EXVColumnType::String)
+    {
+        // 字符串标签直接按字典编码累加
+        const TConstArrayView<int32> Codes = LabelCol->GetStringCodes();
+        const TConstArrayView<FString> Dictionary = LabelCol->GetDictionary();
+        TArray<int32> SlotsByCode;
+        SlotsByCode.Init(INDEX_NONE, Dictionary.Num());
+
+        for (int32 i = 0; i < DataTable.GetRowCount(); ++i)
+        {
+            const float Value = static_cast<float>(ValueCol->GetNumber(i));
+            if (Codes[i] == INDEX_NONE)
+            {
+                Accumulate(NullLabelSlot, FString(), Value);
+            }
+            else
+            {
+                Accumulate(SlotsByCode[Codes[i]], Dictionary[Codes[i]], Value);
+            }
+        }
+    }
+    else
+    {
+        TMap<FString, int32> SlotsByLabel;
+        for (int32 i = 0; i < DataTable.GetRowCount(); ++i)
+        {
+            const FString Label = LabelCol->GetString(i);
+            Accumulate(SlotsByLabel.FindOrAdd(Label, INDEX_NONE), Label, static_cast<float>(ValueCol->GetNumber(i)));
+        }
+    }
+
+    OutGrid.Reserve(Sums.Num());
+    for (int32 Slot = 0; Slot < Sums.Num(); ++Slot)
+    {
+        OutGrid.Add(0, Slot, Sums[Slot]);
+    }
+    return true;
+}
+
+bool UXVDataConverter::ConvertNamedDataToGrid(const TArray<TSharedPtr<FJsonObject>>& NamedData, const FString& XProperty, const FString& YProperty,
+                                               const FString& ZProperty, const FString& TimeProperty, FXVChartGridData& OutGrid)
+{
+    using namespace XVDataConverterPrivate;
+
+    OutGrid.Reset();
+    if (NamedData.IsEmpty())
+    {
+        return false;
+    }
+
+    // 单遍扫描：X/Y取值按首次出现编号，扫描结束后统一排序并重新映射
+    FXVCategoryEncoder XEncoder;
+    FXVCategoryEncoder YEncoder;
+    FXVTimestampParser TimeParser;
+    bool bHasTimeProperty = false;
+    OutGrid.Reserve(NamedData.Num(), true);
 
-    for (int32 i = 0; i < DataTable.GetRowCount(); ++i)
+    for (const auto& DataItem : NamedData)
     {
-        const FXVDataRow& Row = DataTable.Rows[i];
-        
-        // 确保行有足够的列
-        if (Row.Cells.Num() > FMath::Max3(XColIdx, YColIdx, ZColIdx))
+        // 每个字段只查找一次
+        const TSharedPtr<FJsonValue>* TimeField = TimeProperty.IsEmpty() ? nullptr : DataItem->Values.Find(TimeProperty);
+        bHasTimeProperty |= TimeField != nullptr;
+
+        // 检查所需的字段是否存在
+        const TSharedPtr<FJsonValue>* XField = DataItem->Values.Find(XProperty);
+        const TSharedPtr<FJsonValue>* YField = DataItem->Values.Find(YProperty);
+        const TSharedPtr<FJsonValue>* ZField = DataItem->Values.Find(ZProperty);
+        if (!XField || !YField || !ZField)
+        {
+            continue;
+        }
+
+        const int32 XId = EncodeKeyValue(*XField, XEncoder);
+        const int32 YId = EncodeKeyValue(*YField, YEncoder);
+
+        double ZValue = 0;
+        (*ZField)->TryGetNumber(ZValue);
+
+        // 获取时间值，默认使用数据点序号
+        double TimeValue = OutGrid.Num();
+        double TimeNumeric = 0;
+        FString TimeString;
+        int64 TimeTicks = 0;
+        if (TimeField && (*TimeField)->TryGetNumber(TimeNumeric))
+        {
+            TimeValue = TimeNumeric;
+        }
+        else if (TimeField && (*TimeField)->TryGetString(TimeString))
         {
-            // 创建一个包含三个值的数组 [Y, X, Z]
-            TArray<TSharedPtr<FJsonValue>> RowArray;
-            
-            // 注意：折线图格式为 [Y, X, Z]
-            int32 Y = FCString::Atoi(*Row.Cells[YColIdx]);
-            int32 X = FCString::Atoi(*Row.Cells[XColIdx]);
-            int32 Z = FCString::Atoi(*Row.Cells[ZColIdx]);
-            
-            RowArray.Add(MakeShared<FJsonValueNumber>(Y));
-            RowArray.Add(MakeShared<FJsonValueNumber>(X));
-            RowArray.Add(MakeShared<FJsonValueNumber>(Z));
-            
-            JsonArray.Add(MakeShared<FJsonValueArray>(RowArray));
+            if (TimeString.IsNumeric())
+            {
+                TimeValue = FCString::Atod(*TimeString);
+            }
+            else if (TimeParser.Parse(TimeString, TimeTicks))
+            {
+                TimeValue = FXVDataColumn::TimestampToUnixSeconds(TimeTicks);
+            }
         }
+        OutGrid.Add(YId, XId, ZValue, TimeValue);
     }
 
-    // 序列化JSON
-    FString OutputString;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
-    FJsonSerializer::Serialize(JsonArray, Writer);
+    if (!bHasTimeProperty)
+    {
+        OutGrid.Times.Reset();
+    }
 
-    return OutputString;
+    XEncoder.Finalize(OutGrid.XLabels, OutGrid.XIndices);
+    YEncoder.Finalize(OutGrid.YLabels, OutGrid.YIndices);
+
+    return OutGrid.Num() > 0;
 }
 
-TMap<FString, float> UXVDataConverter::ConvertToPieChartFormat(const FXVDataTable& DataTable, const FString& LabelColumn, const FString& ValueColumn)
+bool UXVDataConverter::ConvertJsonTableToGrid(const FXVDataTable& DataTable, const FString& XProperty, const FString& YProperty,
+                                              const FString& ZProperty, const FString& TimeProperty, FXVChartGridData& OutGrid)
 {
-    TMap<FString, float> Result;
-    
-    // 查找列索引
-    int32 LabelColIdx = FindColumnIndex(DataTable, LabelColumn);
-    int32 ValueColIdx = FindColumnIndex(DataTable, ValueColumn);
+    using namespace XVDataConverterPrivate;
 
-    // 检查列索引是否有效
-    if (LabelColIdx == INDEX_NONE || ValueColIdx == INDEX_NONE)
+    OutGrid.Reset();
+    const int32 NumRows = DataTable.GetRowCount();
+    if (NumRows == 0)
     {
-        return Result;
+        return false;
     }
 
-    // 遍历数据表行
-    for (int32 i = 0; i < DataTable.GetRowCount(); ++i)
+    const int32 XColIdx = XProperty.IsEmpty() ? INDEX_NONE : FindColumnIgnoreCase(DataTable, XProperty);
+    const int32 YColIdx = YProperty.IsEmpty() ? INDEX_NONE : FindColumnIgnoreCase(DataTable, YProperty);
+    const int32 ZColIdx = ZProperty.IsEmpty() ? INDEX_NONE : FindColumnIgnoreCase(DataTable, ZProperty);
+    const int32 TimeColIdx = TimeProperty.IsEmpty() ? INDEX_NONE : FindColumnIgnoreCase(DataTable, TimeProperty);
+
+    if (XColIdx == INDEX_NONE || YColIdx == INDEX_NONE || ZColIdx == INDEX_NONE)
     {
-        const FXVDataRow& Row = DataTable.Rows[i];
-        
-        // 确保行有足够的列
-        if (Row.Cells.Num() > FMath::Max(LabelColIdx, ValueColIdx))
+        // 原始格式 [y, x, z(, time)]，前三列必须是数值
+        const FXVDataColumn* Cols[4] = {};
+        for (int32 i = 0; i < 4; ++i)
         {
-            FString Label = Row.Cells[LabelColIdx];
-            float Value = FCString::Atof(*Row.Cells[ValueColIdx]);
-            
-            // 添加或更新值
-            if (Result.Contains(Label))
+            const int32 ColIdx = DataTable.ColumnNames.Find(FString::Printf(TEXT("Column%d"), i));
+            Cols[i] = ColIdx == INDEX_NONE ? nullptr : DataTable.GetColumn(ColIdx);
+        }
+        for (int32 i = 0; i < 3; ++i)
+        {
+            if (!Cols[i] || (Cols[i]->GetType() != EXVColumnType::Int64 && Cols[i]->GetType() != EXVColumnType::Double))
+            {
+                return false;
+            }
+        }
+
+        const bool bHasTime = Cols[3] && (Cols[3]->GetType() == EXVColumnType::Int64 || Cols[3]->GetType() == EXVColumnType::Double);
+        OutGrid.Reserve(NumRows, bHasTime);
+        for (int32 Row = 0; Row < NumRows; ++Row)
+        {
+            if (!Cols[0]->IsValid(Row) || !Cols[1]->IsValid(Row) || !Cols[2]->IsValid(Row))
+            {
+                OutGrid.Reset();
+                return false;
+            }
+
+            const int32 Y = static_cast<int32>(Cols[0]->GetNumber(Row));
+            const int32 X = static_cast<int32>(Cols[1]->GetNumber(Row));
+            const float Z = static_cast<float>(Cols[2]->GetNumber(Row));
+            if (bHasTime)
             {
-                Result[Label] += Value;
+                OutGrid.Add(Y, X, Z, GetTimeValue(*Cols[3], Row, OutGrid.Num()));
             }
             else
             {
-                Result.Add(Label, Value);
+                OutGrid.Add(Y, X, Z);
             }
         }
+        return true;
     }
 
-    return Result;
+    const FXVDataColumn* XCol = DataTable.GetColumn(XColIdx);
+    const FXVDataColumn* YCol = DataTable.GetColumn(YColIdx);
+    const FXVDataColumn* ZCol = DataTable.GetColumn(ZColIdx);
+    const FXVDataColumn* TimeCol = TimeColIdx == INDEX_NONE ? nullptr : DataTable.GetColumn(TimeColIdx);
+    if (!XCol || !YCol || !ZCol)
+    {
+        return false;
+    }
+
+    // 单遍扫描：X/Y取值按首次出现编号，扫描结束后统一排序并重新映射
+    FXVCategoryEncoder XEncoder;
+    FXVCategoryEncoder YEncoder;
+    TArray<int32> XDictionaryIds;
+    TArray<int32> YDictionaryIds;
+
+    OutGrid.Reserve(NumRows, TimeCol != nullptr);
+    for (int32 Row = 0; Row < NumRows; ++Row)
+    {
+        if (!XCol->IsValid(Row) || !YCol->IsValid(Row) || !ZCol->IsValid(Row))
+        {
+            continue;
+        }
+
+        const int32 XId = EncodeKeyCell(*XCol, Row, XEncoder, XDictionaryIds);
+        const int32 YId = EncodeKeyCell(*YCol, Row, YEncoder, YDictionaryIds);
+        const float ZValue = ZCol->GetType() == EXVColumnType::String ? 0.0f : static_cast<float>(ZCol->GetNumber(Row));
+        if (TimeCol)
+        {
+            // 没有时间值时使用数据点序号
+            OutGrid.Add(YId, XId, ZValue, GetTimeValue(*TimeCol, Row, OutGrid.Num()));
+        }
+        else
+        {
+            OutGrid.Add(YId, XId, ZValue);
+        }
+    }
+
+    XEncoder.Finalize(OutGrid.XLabels, OutGrid.XIndices);
+    YEncoder.Finalize(OutGrid.YLabels, OutGrid.YIndices);
+
+    return OutGrid.Num() > 0;
+}
+
+bool UXVDataConverter::AggregateToGrid(const FXVDataTable& DataTable, const FString& XColumn, const FString& YColumn, const FString& ZColumn,
+                                       EXVAggregation Aggregation, float Percentile, FXVChartGridData& OutGrid)
+{
+    using namespace XVDataConverterPrivate;
+
+    OutGrid.Reset();
+
+    const bool bNeedsValue = Aggregation != EXVAggregation::Count;
+    const int32 XColIdx = FindColumnIndex(DataTable, XColumn);
+    const int32 YColIdx = FindColumnIndex(DataTable, YColumn);
+    const int32 ZColIdx = bNeedsValue ? FindColumnIndex(DataTable, ZColumn) : INDEX_NONE;
+    if (Aggregation == EXVAggregation::None || XColIdx == INDEX_NONE || YColIdx == INDEX_NONE || (bNeedsValue && ZColIdx == INDEX_NONE))
+    {
+        return false;
+    }
+
+    // 表中没有行时列可能尚未创建
+    const FXVDataColumn* XCol = DataTable.GetColumn(XColIdx);
+    const FXVDataColumn* YCol = DataTable.GetColumn(YColIdx);
+    const FXVDataColumn* ZCol = bNeedsValue ? DataTable.GetColumn(ZColIdx) : nullptr;
+    if (!XCol || !YCol || (bNeedsValue && !ZCol))
+    {
+        return true;
+    }
+
+    // 按行分块，每块使用自己的哈希表，块数不超过工作线程数，避免合并的开销超过扫描本身
+    constexpr int32 MinRowsPerChunk = 16 * 1024;
+    const int32 NumRows = DataTable.GetRowCount();
+    const int32 NumChunks = FMath::Clamp(NumRows / MinRowsPerChunk, 1, FTaskGraphInterface::Get().GetNumWorkerThreads() + 1);
+    const bool bCollectValues = Aggregation == EXVAggregation::Percentile;
+
+    TArray<FGroupMap> ChunkGroups;
+    ChunkGroups.SetNum(NumChunks);
+    ParallelFor(NumChunks, [&](int32 Chunk)
+    {
+        const int32 Begin = static_cast<int32>(static_cast<int64>(NumRows) * Chunk / NumChunks);
+        const int32 End = static_cast<int32>(static_cast<int64>(NumRows) * (Chunk + 1) / NumChunks);
+        FGroupMap& Groups = ChunkGroups[Chunk];
+
+        for (int32 Row = Begin; Row < End; ++Row)
+        {
+            if (!XCol->IsValid(Row) || !YCol->IsValid(Row) || (ZCol && !ZCol->IsValid(Row)))
+            {
+                continue;
+            }
+
+            FGroupAccumulator& Group = Groups.FindOrAdd(FGroupKey(GetGroupKey(*XCol, Row), GetGroupKey(*YCol, Row)));
+            Group.FirstRow = FMath::Min(Group.FirstRow, Row);
+            ++Group.Count;
+            if (ZCol)
+            {
+                const double Value = ZCol->GetNumber(Row);
+                Group.Sum += Value;
+                Group.Min = FMath::Min(Group.Min, Value);
+                Group.Max = FMath::Max(Group.Max, Value);
+                if (bCollectValues)
+                {
+                    Group.Values.Add(static_cast<float>(Value));
+                }
+            }
+        }
+    });
+
+    // 合并各块的结果，分组数量远小于行数，串行合并即可
+    FGroupMap& Groups = ChunkGroups[0];
+    for (int32 Chunk = 1; Chunk < NumChunks; ++Chunk)
+    {
+        for (TPair<FGroupKey, FGroupAccumulator>& Pair : ChunkGroups[Chunk])
+        {
+            Groups.FindOrAdd(Pair.Key).Merge(Pair.Value);
+        }
+        ChunkGroups[Chunk].Empty();
+    }
+
+    // 分组的X/Y取值按与命名数据相同的规则排序并生成轴标签
+    FXVCategoryEncoder XEncoder;
+    FXVCategoryEncoder YEncoder;
+    TArray<int32> XDictionaryIds;
+    TArray<int32> YDictionaryIds;
+    OutGrid.Reserve(Groups.Num());
+    for (TPair<FGroupKey, FGroupAccumulator>& Pair : Groups)
+    {
+        FGroupAccumulator& Group = Pair.Value;
+        OutGrid.Add(EncodeKeyCell(*YCol, Group.FirstRow, YEncoder, YDictionaryIds),
+                    EncodeKeyCell(*XCol, Group.FirstRow, XEncoder, XDictionaryIds),
+                    FinishGroup(Group, Aggregation, Percentile));
+    }
+
+    XEncoder.Finalize(OutGrid.XLabels, OutGrid.XIndices);
+    YEncoder.Finalize(OutGrid.YLabels, OutGrid.YIndices);
+    return true;
+}
+
+FString UXVDataConverter::SerializeGrid(const FXVChartGridData& Grid)
+{
+    // 创建JSON数组 [[Y, X, Z], ...]
+    TArray<TSharedPtr<FJsonValue>> JsonArray;
+    JsonArray.Reserve(Grid.Num());
+
+    for (int32 i = 0; i < Grid.Num(); ++i)
+    {
+        TArray<TSharedPtr<FJsonValue>> RowArray;
+        RowArray.Add(MakeShared<FJsonValueNumber>(Grid.YIndices[i]));
+        RowArray.Add(MakeShared<FJsonValueNumber>(Grid.XIndices[i]));
+        RowArray.Add(MakeShared<FJsonValueNumber>(Grid.Values[i]));
+
+        JsonArray.Add(MakeShared<FJsonValueArray>(RowArray));
+    }
+
+    // 序列化JSON
+    FString OutputString;
+    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+    FJsonSerializer::Serialize(JsonArray, Writer);
+
+    return OutputString;
 }
 
 int32 UXVDataConverter::FindColumnIndex(const FXVDataTable& DataTable, const FString& ColumnName)
 {
     return DataTable.ColumnNames.Find(ColumnName);
-} 
\ No newline at end of file
+}
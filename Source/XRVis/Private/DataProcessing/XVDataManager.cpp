@@ -1,5 +1,7 @@
 #include "DataProcessing/XVDataManager.h"
 #include "DataProcessing/XVDataConverter.h"
+#include "DataProcessing/XVDataCacheSubsystem.h"
+#include "Misc/Paths.h"
 
 UXVDataManager::UXVDataManager(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
@@ -7,6 +9,7 @@ UXVDataManager::UXVDataManager(const FObjectInitializer& ObjectInitializer)
     // 使用CreateDefaultSubobject创建子对象
     JsonReader = ObjectInitializer.CreateDefaultSubobject<UXVJsonDataReader>(this, TEXT("JsonReader"));
     CsvReader = ObjectInitializer.CreateDefaultSubobject<UXVCsvDataReader>(this, TEXT("CsvReader"));
+    BinaryReader = ObjectInitializer.CreateDefaultSubobject<UXVBinaryDataReader>(this, TEXT("BinaryReader"));
     ActiveReader = nullptr;
 }
 
@@ -21,7 +24,7 @@ bool UXVDataManager::LoadFromJsonFile(const FString& FilePath)
 
     if (JsonReader->ReadFromFile(FilePath))
     {
-        ActiveReader = JsonReader;
+        SetActiveReader(JsonReader);
         return true;
     }
     else
@@ -42,7 +45,7 @@ bool UXVDataManager::LoadFromCsvFile(const FString& FilePath)
 
     if (CsvReader->ReadFromFile(FilePath))
     {
-        ActiveReader = CsvReader;
+        SetActiveReader(CsvReader);
         return true;
     }
     else
@@ -52,6 +55,97 @@ bool UXVDataManager::LoadFromCsvFile(const FString& FilePath)
     }
 }
 
+bool UXVDataManager::LoadFromBinaryFile(const FString& FilePath)
+{
+    LastError.Empty();
+    if (!BinaryReader)
+    {
+        LastError = TEXT("二进制读取器未初始化");
+        return false;
+    }
+
+    if (BinaryReader->ReadFromFile(FilePath))
+    {
+        SetActiveReader(BinaryReader);
+        return true;
+    }
+    else
+    {
+        LastError = BinaryReader->GetLastError();
+        return false;
+    }
+}
+
+bool UXVDataManager::LoadFromFileCached(const FString& FilePath)
+{
+    LastError.Empty();
+    UXVDataReader* Reader = FindReaderForFile(FilePath);
+    if (!Reader)
+    {
+        LastError = FString::Printf(TEXT("不支持的文件扩展名: %s"), *FPaths::GetExtension(FilePath));
+        return false;
+    }
+
+    UXVDataCacheSubsystem* Cache = UXVDataCacheSubsystem::Get();
+    if (!Cache)
+    {
+        // 引擎子系统不可用时直接读取
+        if (!Reader->ReadFromFile(FilePath))
+        {
+            LastError = Reader->GetLastError();
+            return false;
+        }
+        SetActiveReader(Reader);
+        return true;
+    }
+
+    // 等待的其他读取失败（例如被取消）时由自己重新读取一次
+    for (int32 Attempt = 0; Attempt < 2; ++Attempt)
+    {
+        bool bLoadedHere = false;
+        UXVDataCacheSubsystem::FTablePtr Table = Cache->FindOrLoad(FilePath, Reader->GetCacheOptionsKey(),
+            [Reader, &FilePath, &bLoadedHere]() -> UXVDataCacheSubsystem::FTablePtr
+            {
+                bLoadedHere = true;
+                if (!Reader->ReadFromFile(FilePath))
+                {
+                    return nullptr;
+                }
+
+                // 数据表从读取器移入共享引用，不复制
+                return MakeShared<FXVDataTable, ESPMode::ThreadSafe>(Reader->ReleaseDataTable());
+            });
+
+        if (Table.IsValid())
+        {
+            ActiveReader = nullptr;
+            SharedTable = MoveTemp(Table);
+            return true;
+        }
+        if (bLoadedHere)
+        {
+            LastError = Reader->GetLastError();
+            return false;
+        }
+    }
+
+    LastError = FString::Printf(TEXT("无法读取文件: %s"), *FilePath);
+    return false;
+}
+
+bool UXVDataManager::SaveToBinaryFile(const FString& FilePath)
+{
+    LastError.Empty();
+    const FXVDataTable* Table = GetLoadedTable();
+    if (!Table)
+    {
+        LastError = TEXT("未加载数据");
+        return false;
+    }
+
+    return FXVBinaryDataset::Write(*Table, FilePath, LastError);
+}
+
 bool UXVDataManager::LoadFromJsonString(const FString& JsonString)
 {
     LastError.Empty();
@@ -63,7 +157,7 @@ bool UXVDataManager::LoadFromJsonString(const FString& JsonString)
 
     if (JsonReader->ReadFromString(JsonString))
     {
-        ActiveReader = JsonReader;
+        SetActiveReader(JsonReader);
         return true;
     }
     else
@@ -84,7 +178,7 @@ bool UXVDataManager::LoadFromCsvString(const FString& CsvString)
 
     if (CsvReader->ReadFromString(CsvString))
     {
-        ActiveReader = CsvReader;
+        SetActiveReader(CsvReader);
         return true;
     }
     else
@@ -94,16 +188,56 @@ bool UXVDataManager::LoadFromCsvString(const FString& CsvString)
     }
 }
 
+void UXVDataManager::SetReadMonitor(const TFunction<void(float)>& InOnProgress, const TSharedPtr<FThreadSafeBool, ESPMode::ThreadSafe>& InCancelFlag)
+{
+    for (UXVDataReader* Reader : { static_cast<UXVDataReader*>(JsonReader), static_cast<UXVDataReader*>(CsvReader), static_cast<UXVDataReader*>(BinaryReader) })
+    {
+        if (Reader)
+        {
+            Reader->SetReadMonitor(InOnProgress, InCancelFlag);
+        }
+    }
+}
+
 const FXVDataTable& UXVDataManager::GetDataTable() const
 {
     static FXVDataTable EmptyTable;
     
-    if (ActiveReader)
+    const FXVDataTable* Table = GetLoadedTable();
+    return Table ? *Table : EmptyTable;
+}
+
+void UXVDataManager::SetActiveReader(UXVDataReader* Reader)
+{
+    ActiveReader = Reader;
+    SharedTable.Reset();
+}
+
+UXVDataReader* UXVDataManager::FindReaderForFile(const FString& FilePath) const
+{
+    const FString Extension = FPaths::GetExtension(FilePath);
+    if (Extension.Equals(TEXT("json"), ESearchCase::IgnoreCase))
     {
-        return ActiveReader->GetDataTable();
+        return JsonReader;
     }
-    
-    return EmptyTable;
+    if (Extension.Equals(TEXT("csv"), ESearchCase::IgnoreCase))
+    {
+        return CsvReader;
+    }
+    if (Extension.Equals(FXVBinaryDataset::FileExtension, ESearchCase::IgnoreCase))
+    {
+        return BinaryReader;
+    }
+    return nullptr;
+}
+
+const FXVDataTable* UXVDataManager::GetLoadedTable() const
+{
+    if (SharedTable.IsValid())
+    {
+        return SharedTable.Get();
+    }
+    return ActiveReader ? &ActiveReader->GetDataTable() : nullptr;
 }
 
 FString UXVDataManager::GetLastError() const
@@ -115,37 +249,101 @@ FString UXVDataManager::ConvertToBarChartData(const FString& XColumn, const FStr
 {
     LastError.Empty();
     
-    if (!ActiveReader)
+    const FXVDataTable* Table = GetLoadedTable();
+    if (!Table)
     {
         LastError = TEXT("未加载数据");
         return TEXT("");
     }
     
-    return UXVDataConverter::ConvertToBarChartFormat(ActiveReader->GetDataTable(), XColumn, YColumn, ZColumn);
+    return UXVDataConverter::ConvertToBarChartFormat(*Table, XColumn, YColumn, ZColumn);
 }
 
 FString UXVDataManager::ConvertToLineChartData(const FString& XColumn, const FString& YColumn, const FString& ZColumn)
 {
     LastError.Empty();
     
-    if (!ActiveReader)
+    const FXVDataTable* Table = GetLoadedTable();
+    if (!Table)
     {
         LastError = TEXT("未加载数据");
         return TEXT("");
     }
     
-    return UXVDataConverter::ConvertToLineChartFormat(ActiveReader->GetDataTable(), XColumn, YColumn, ZColumn);
+    return UXVDataConverter::ConvertToLineChartFormat(*Table, XColumn, YColumn, ZColumn);
 }
 
 TMap<FString, float> UXVDataManager::ConvertToPieChartData(const FString& LabelColumn, const FString& ValueColumn)
 {
     LastError.Empty();
     
-    if (!ActiveReader)
+    const FXVDataTable* Table = GetLoadedTable();
+    if (!Table)
     {
         LastError = TEXT("未加载数据");
         return TMap<FString, float>();
     }
     
-    return UXVDataConverter::ConvertToPieChartFormat(ActiveReader->GetDataTable(), LabelColumn, ValueColumn);
-} 
\ No newline at end of file
+    return UXVDataConverter::ConvertToPieChartFormat(*Table, LabelColumn, ValueColumn);
+} 
+
+bool UXVDataManager::ConvertToBarChartGrid(const FString& XColumn, const FString& YColumn, const FString& ZColumn, FXVChartGridData& OutGrid)
+{
+    LastError.Empty();
+    OutGrid.Reset();
+
+    const FXVDataTable* Table = GetLoadedTable();
+    if (!Table)
+    {
+        LastError = TEXT("未加载数据");
+        return false;
+    }
+
+    return UXVDataConverter::ConvertToBarChartGrid(*Table, XColumn, YColumn, ZColumn, OutGrid);
+}
+
+bool UXVDataManager::ConvertToLineChartGrid(const FString& XColumn, const FString& YColumn, const FString& ZColumn, FXVChartGridData& OutGrid)
+{
+    LastError.Empty();
+    OutGrid.Reset();
+
+    const FXVDataTable* Table = GetLoadedTable();
+    if (!Table)
+    {
+        LastError = TEXT("未加载数据");
+        return false;
+    }
+
+    return UXVDataConverter::ConvertToLineChartGrid(*Table, XColumn, YColumn, ZColumn, OutGrid);
+}
+
+bool UXVDataManager::ConvertToPieChartGrid(const FString& LabelColumn, const FString& ValueColumn, FXVChartGridData& OutGrid)
+{
+    LastError.Empty();
+    OutGrid.Reset();
+
+    const FXVDataTable* Table = GetLoadedTable();
+    if (!Table)
+    {
+        LastError = TEXT("未加载数据");
+        return false;
+    }
+
+    return UXVDataConverter::ConvertToPieChartGrid(*Table, LabelColumn, ValueColumn, OutGrid);
+}
+
+bool UXVDataManager::AggregateToGrid(const FString& XColumn, const FString& YColumn, const FString& ZColumn, EXVAggregation Aggregation,
+                                     float Percentile, FXVChartGridData& OutGrid)
+{
+    LastError.Empty();
+    OutGrid.Reset();
+
+    const FXVDataTable* Table = GetLoadedTable();
+    if (!Table)
+    {
+        LastError = TEXT("未加载数据");
+        return false;
+    }
+
+    return UXVDataConverter::AggregateToGrid(*Table, XColumn, YColumn, ZColumn, Aggregation, Percentile, OutGrid);
+}
@@ -18,4 +18,37 @@ bool UXVDataReader::ReadFromFile(const FString& FilePath)
         LastError = FString::Printf(TEXT("无法读取文件: %s"), *FilePath);
         return false;
     }
-} 
\ No newline at end of file
+}
+
+FString UXVDataReader::GetCacheOptionsKey() const
+{
+    return GetClass()->GetName();
+}
+
+FXVDataTable UXVDataReader::ReleaseDataTable()
+{
+    FXVDataTable Result = MoveTemp(DataTable);
+    DataTable.Clear();
+    return Result;
+}
+
+void UXVDataReader::SetReadMonitor(TFunction<void(float)> InOnProgress, TSharedPtr<FThreadSafeBool, ESPMode::ThreadSafe> InCancelFlag)
+{
+    OnProgress = MoveTemp(InOnProgress);
+    CancelFlag = MoveTemp(InCancelFlag);
+}
+
+bool UXVDataReader::ReportProgress(float Progress)
+{
+    if (IsReadCancelled())
+    {
+        LastError = TEXT("读取已取消");
+        return false;
+    }
+
+    if (OnProgress)
+    {
+        OnProgress(FMath::Clamp(Progress, 0.0f, 1.0f));
+    }
+    return true;
+}
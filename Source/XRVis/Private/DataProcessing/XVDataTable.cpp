@@ -0,0 +1,610 @@
+#include "DataProcessing/XVDataTable.h"
+#include "Async/ParallelFor.h"
+#include "Hash/CityHash.h"
+
+namespace XVDataTablePrivate
+{
+    /** 数字文本的最大长度，超过此长度直接视为字符串 */
+    constexpr int32 MaxScalarTextLength = 63;
+
+    bool TryParseInt64(FStringView Text, int64& OutValue)
+    {
+        int32 Index = 0;
+        bool bNegative = false;
+        if (Text[0] == TEXT('-') || Text[0] == TEXT('+'))
+        {
+            bNegative = Text[0] == TEXT('-');
+            ++Index;
+        }
+
+        // 超过18位数字可能溢出，交给浮点解析
+        const int32 NumDigits = Text.Len() - Index;
+        if (NumDigits <= 0 || NumDigits > 18)
+        {
+            return false;
+        }
+
+        int64 Value = 0;
+        for (; Index < Text.Len(); ++Index)
+        {
+            const TCHAR Char = Text[Index];
+            if (Char < TEXT('0') || Char > TEXT('9'))
+            {
+                return false;
+            }
+            Value = Value * 10 + (Char - TEXT('0'));
+        }
+
+        OutValue = bNegative ? -Value : Value;
+        return true;
+    }
+
+    bool TryParseDouble(FStringView Text, double& OutValue)
+    {
+        if (Text.Len() > MaxScalarTextLength)
+        {
+            return false;
+        }
+
+        // 先检查字符集，排除 inf/nan/十六进制 等Strtod能接受但不应视为数值的内容
+        bool bHasDigit = false;
+        TCHAR Buffer[MaxScalarTextLength + 1];
+        for (int32 Index = 0; Index < Text.Len(); ++Index)
+        {
+            const TCHAR Char = Text[Index];
+            if (Char >= TEXT('0') && Char <= TEXT('9'))
+            {
+                bHasDigit = true;
+            }
+            else if (Char != TEXT('.') && Char != TEXT('-') && Char != TEXT('+') && Char != TEXT('e') && Char != TEXT('E'))
+            {
+                return false;
+            }
+            Buffer[Index] = Char;
+        }
+        if (!bHasDigit)
+        {
+            return false;
+        }
+        Buffer[Text.Len()] = TEXT('\0');
+
+        TCHAR* End = nullptr;
+        OutValue = FCString::Strtod(Buffer, &End);
+        return End == Buffer + Text.Len();
+    }
+
+    /** 两种列类型合并后的类型 */
+    EXVColumnType UnifyTypes(EXVColumnType A, EXVColumnType B)
+    {
+        if (A == B || B == EXVColumnType::Empty)
+        {
+            return A;
+        }
+        if (A == EXVColumnType::Empty)
+        {
+            return B;
+        }
+        if ((A == EXVColumnType::Int64 && B == EXVColumnType::Double) || (A == EXVColumnType::Double && B == EXVColumnType::Int64))
+        {
+            return EXVColumnType::Double;
+        }
+        return EXVColumnType::String;
+    }
+}
+
+double FXVDataColumn::TimestampToUnixSeconds(int64 Ticks)
+{
+    return static_cast<double>(Ticks - FDateTime(1970, 1, 1).GetTicks()) / ETimespan::TicksPerSecond;
+}
+
+void FXVDataColumn::AppendString(FStringView Text)
+{
+    using namespace XVDataTablePrivate;
+
+    const FStringView Trimmed = Text.TrimStartAndEnd();
+    if (Trimmed.IsEmpty())
+    {
+        AppendNull();
+        return;
+    }
+
+    if (Type == EXVColumnType::String)
+    {
+        AppendStringValue(Text);
+        return;
+    }
+
+    if (Type == EXVColumnType::Empty || Type == EXVColumnType::Int64 || Type == EXVColumnType::Double)
+    {
+        int64 IntValue;
+        if (Type != EXVColumnType::Double && TryParseInt64(Trimmed, IntValue))
+        {
+            AppendInt64(IntValue);
+            return;
+        }
+
+        double DoubleValue;
+        if (TryParseDouble(Trimmed, DoubleValue))
+        {
+            if (Type != EXVColumnType::Double)
+            {
+                PromoteTo(EXVColumnType::Double);
+            }
+            DoubleValues.Add(DoubleValue);
+            Validity.Add(true);
+            return;
+        }
+    }
+
+    if (Type == EXVColumnType::Empty || Type == EXVColumnType::Timestamp)
+    {
+        int64 Ticks;
+        if (TimestampParser.Parse(Trimmed, Ticks))
+        {
+            if (Type == EXVColumnType::Empty)
+            {
+                PromoteTo(EXVColumnType::Timestamp);
+            }
+            Int64Values.Add(Ticks);
+            Validity.Add(true);
+            return;
+        }
+    }
+
+    PromoteTo(EXVColumnType::String);
+    AppendStringValue(Text);
+}
+
+void FXVDataColumn::AppendInt64(int64 Value)
+{
+    switch (Type)
+    {
+    case EXVColumnType::Empty:
+        PromoteTo(EXVColumnType::Int64);
+        [[fallthrough]];
+    case EXVColumnType::Int64:
+        Int64Values.Add(Value);
+        Validity.Add(true);
+        break;
+    case EXVColumnType::Double:
+        DoubleValues.Add(static_cast<double>(Value));
+        Validity.Add(true);
+        break;
+    default:
+        PromoteTo(EXVColumnType::String);
+        AppendStringValue(LexToString(Value));
+        break;
+    }
+}
+
+void FXVDataColumn::AppendNumber(double Value)
+{
+    const bool bIntegral = FMath::IsFinite(Value) && FMath::Abs(Value) < 1e18 && Value == FMath::FloorToDouble(Value);
+    if (bIntegral && (Type == EXVColumnType::Empty || Type == EXVColumnType::Int64))
+    {
+        AppendInt64(static_cast<int64>(Value));
+        return;
+    }
+
+    switch (Type)
+    {
+    case EXVColumnType::Empty:
+    case EXVColumnType::Int64:
+        PromoteTo(EXVColumnType::Double);
+        [[fallthrough]];
+    case EXVColumnType::Double:
+        DoubleValues.Add(Value);
+        Validity.Add(true);
+        break;
+    default:
+        PromoteTo(EXVColumnType::String);
+        AppendStringValue(FString::SanitizeFloat(Value, 0));
+        break;
+    }
+}
+
+void FXVDataColumn::AppendNull(int32 Count)
+{
+    if (Count <= 0)
+    {
+        return;
+    }
+
+    switch (Type)
+    {
+    case EXVColumnType::Int64:
+    case EXVColumnType::Timestamp:
+        Int64Values.AddZeroed(Count);
+        break;
+    case EXVColumnType::Double:
+        DoubleValues.AddZeroed(Count);
+        break;
+    case EXVColumnType::String:
+        for (int32 i = 0; i < Count; ++i)
+        {
+            StringCodes.Add(INDEX_NONE);
+        }
+        break;
+    default:
+        break;
+    }
+    Validity.Add(false, Count);
+}
+
+void FXVDataColumn::AppendColumn(const FXVDataColumn& Other)
+{
+    const int32 OtherNum = Other.Num();
+    if (OtherNum == 0)
+    {
+        return;
+    }
+
+    if (Other.Type == EXVColumnType::Empty)
+    {
+        AppendNull(OtherNum);
+        return;
+    }
+
+    const EXVColumnType TargetType = XVDataTablePrivate::UnifyTypes(Type, Other.Type);
+    PromoteTo(TargetType);
+
+    switch (TargetType)
+    {
+    case EXVColumnType::Int64:
+    case EXVColumnType::Timestamp:
+        Int64Values.Append(Other.Int64Values);
+        break;
+    case EXVColumnType::Double:
+        if (Other.Type == EXVColumnType::Double)
+        {
+            DoubleValues.Append(Other.DoubleValues);
+        }
+        else
+        {
+            DoubleValues.Reserve(DoubleValues.Num() + OtherNum);
+            for (int64 Value : Other.Int64Values)
+            {
+                DoubleValues.Add(static_cast<double>(Value));
+            }
+        }
+        break;
+    case EXVColumnType::String:
+        StringCodes.Reserve(StringCodes.Num() + OtherNum);
+        if (Other.Type == EXVColumnType::String)
+        {
+            // 每个字典项只重新映射一次
+            TArray<int32> Remap;
+            Remap.SetNumUninitialized(Other.Dictionary.Num());
+            for (int32 Code = 0; Code < Other.Dictionary.Num(); ++Code)
+            {
+                Remap[Code] = InternString(Other.Dictionary[Code]);
+            }
+            for (int32 Code : Other.StringCodes)
+            {
+                StringCodes.Add(Code == INDEX_NONE ? INDEX_NONE : Remap[Code]);
+            }
+        }
+        else
+        {
+            for (int32 RowIndex = 0; RowIndex < OtherNum; ++RowIndex)
+            {
+                StringCodes.Add(Other.Validity[RowIndex] ? InternString(Other.GetString(RowIndex)) : INDEX_NONE);
+            }
+        }
+        break;
+    default:
+        break;
+    }
+
+    Validity.AddRange(Other.Validity, OtherNum);
+}
+
+void FXVDataColumn::Reserve(int32 NumRows)
+{
+    Validity.Reserve(NumRows);
+    switch (Type)
+    {
+    case EXVColumnType::Int64:
+    case EXVColumnType::Timestamp:
+        Int64Values.Reserve(NumRows);
+        break;
+    case EXVColumnType::Double:
+        DoubleValues.Reserve(NumRows);
+        break;
+    case EXVColumnType::String:
+        StringCodes.Reserve(NumRows);
+        break;
+    default:
+        break;
+    }
+}
+
+FString FXVDataColumn::GetString(int32 RowIndex) const
+{
+    if (!Validity[RowIndex])
+    {
+        return FString();
+    }
+
+    switch (Type)
+    {
+    case EXVColumnType::Int64:
+        return LexToString(Int64Values[RowIndex]);
+    case EXVColumnType::Double:
+        return FString::SanitizeFloat(DoubleValues[RowIndex], 0);
+    case EXVColumnType::String:
+        return Dictionary[StringCodes[RowIndex]];
+    case EXVColumnType::Timestamp:
+        return FDateTime(Int64Values[RowIndex]).ToIso8601();
+    default:
+        return FString();
+    }
+}
+
+SIZE_T FXVDataColumn::GetAllocatedSize() const
+{
+    SIZE_T Size = Validity.GetAllocatedSize()
+        + Int64Values.GetAllocatedSize()
+        + DoubleValues.GetAllocatedSize()
+        + StringCodes.GetAllocatedSize()
+        + Dictionary.GetAllocatedSize()
+        + DictionaryNumbers.GetAllocatedSize()
+        + DictionaryHashHeads.GetAllocatedSize()
+        + DictionaryNext.GetAllocatedSize();
+    for (const FString& Entry : Dictionary)
+    {
+        Size += Entry.GetAllocatedSize();
+    }
+    return Size;
+}
+
+void FXVDataColumn::AssignBlocks(EXVColumnType InType, int32 NumRows, const uint32* ValidityWords, TConstArrayView<int64> InInt64Values,
+                                 TConstArrayView<double> InDoubleValues, TConstArrayView<int32> InStringCodes,
+                                 TArray<FString>&& InDictionary, TConstArrayView<double> InDictionaryNumbers)
+{
+    Type = InType;
+    Validity.Empty(NumRows);
+    Validity.AddRange(ValidityWords, NumRows);
+    Int64Values.Reset();
+    Int64Values.Append(InInt64Values.GetData(), InInt64Values.Num());
+    DoubleValues.Reset();
+    DoubleValues.Append(InDoubleValues.GetData(), InDoubleValues.Num());
+    StringCodes.Reset();
+    StringCodes.Append(InStringCodes.GetData(), InStringCodes.Num());
+    Dictionary = MoveTemp(InDictionary);
+    DictionaryNumbers.Reset();
+    DictionaryNumbers.Append(InDictionaryNumbers.GetData(), InDictionaryNumbers.Num());
+
+    // 重建字典查找用的哈希链表，之后追加的字符串仍能正确去重
+    DictionaryHashHeads.Empty(Dictionary.Num());
+    DictionaryNext.SetNumUninitialized(Dictionary.Num());
+    for (int32 Code = 0; Code < Dictionary.Num(); ++Code)
+    {
+        const FString& Entry = Dictionary[Code];
+        const uint32 Hash = CityHash32(reinterpret_cast<const char*>(*Entry), Entry.Len() * sizeof(TCHAR));
+        int32& Head = DictionaryHashHeads.FindOrAdd(Hash, INDEX_NONE);
+        DictionaryNext[Code] = Head;
+        Head = Code;
+    }
+}
+
+void FXVDataColumn::PromoteTo(EXVColumnType NewType)
+{
+    if (Type == NewType)
+    {
+        return;
+    }
+
+    const int32 NumRows = Num();
+    switch (NewType)
+    {
+    case EXVColumnType::Int64:
+    case EXVColumnType::Timestamp:
+        // 只可能从Empty提升，之前的都是空单元格
+        Int64Values.SetNumZeroed(NumRows);
+        break;
+    case EXVColumnType::Double:
+        DoubleValues.SetNumUninitialized(NumRows);
+        for (int32 RowIndex = 0; RowIndex < NumRows; ++RowIndex)
+        {
+            DoubleValues[RowIndex] = Type == EXVColumnType::Int64 ? static_cast<double>(Int64Values[RowIndex]) : 0.0;
+        }
+        Int64Values.Empty();
+        break;
+    case EXVColumnType::String:
+        // 原始文本已经不存在，已有的值按规范格式转换为字符串
+        StringCodes.SetNumUninitialized(NumRows);
+        for (int32 RowIndex = 0; RowIndex < NumRows; ++RowIndex)
+        {
+            StringCodes[RowIndex] = Validity[RowIndex] ? InternString(GetString(RowIndex)) : INDEX_NONE;
+        }
+        Int64Values.Empty();
+        DoubleValues.Empty();
+        break;
+    default:
+        break;
+    }
+
+    Type = NewType;
+}
+
+int32 FXVDataColumn::InternString(FStringView Text)
+{
+    const uint32 Hash = CityHash32(reinterpret_cast<const char*>(Text.GetData()), Text.Len() * sizeof(TCHAR));
+
+    const int32* HeadCode = DictionaryHashHeads.Find(Hash);
+    const int32 FirstCode = HeadCode ? *HeadCode : INDEX_NONE;
+    for (int32 Code = FirstCode; Code != INDEX_NONE; Code = DictionaryNext[Code])
+    {
+        if (Text.Equals(Dictionary[Code], ESearchCase::CaseSensitive))
+        {
+            return Code;
+        }
+    }
+
+    const int32 NewCode = Dictionary.Emplace(Text);
+    DictionaryNumbers.Add(FCString::Atod(*Dictionary[NewCode]));
+    DictionaryNext.Add(FirstCode);
+    DictionaryHashHeads.Add(Hash, NewCode);
+    return NewCode;
+}
+
+void FXVDataColumn::AppendStringValue(FStringView Text)
+{
+    StringCodes.Add(InternString(Text));
+    Validity.Add(true);
+}
+
+template <typename CellType>
+void FXVDataTable::AddRowInternal(TConstArrayView<CellType> Cells)
+{
+    EnsureColumns();
+
+    const int32 NumCells = FMath::Min(Cells.Num(), Columns.Num());
+    for (int32 ColumnIndex = 0; ColumnIndex < NumCells; ++ColumnIndex)
+    {
+        Columns[ColumnIndex].AppendString(FStringView(Cells[ColumnIndex]));
+    }
+    for (int32 ColumnIndex = NumCells; ColumnIndex < Columns.Num(); ++ColumnIndex)
+    {
+        Columns[ColumnIndex].AppendNull();
+    }
+    ++RowCount;
+}
+
+void FXVDataTable::AddRow(TConstArrayView<FString> Cells)
+{
+    AddRowInternal(Cells);
+}
+
+void FXVDataTable::AddRow(TConstArrayView<FStringView> Cells)
+{
+    AddRowInternal(Cells);
+}
+
+void FXVDataTable::CommitRow()
+{
+    EnsureColumns();
+    ++RowCount;
+
+#if DO_CHECK
+    for (const FXVDataColumn& Column : Columns)
+    {
+        checkf(Column.Num() == RowCount, TEXT("FXVDataTable::CommitRow: 每一列必须追加恰好一个值"));
+    }
+#endif
+}
+
+void FXVDataTable::AssignColumns(TArray<FString>&& InColumnNames, TArray<FXVDataColumn>&& InColumns)
+{
+    check(InColumnNames.Num() == InColumns.Num());
+    ColumnNames = MoveTemp(InColumnNames);
+    Columns = MoveTemp(InColumns);
+    RowCount = Columns.Num() > 0 ? Columns[0].Num() : 0;
+
+#if DO_CHECK
+    for (const FXVDataColumn& Column : Columns)
+    {
+        check(Column.Num() == RowCount);
+    }
+#endif
+}
+
+void FXVDataTable::AppendTable(FXVDataTable&& Other)
+{
+    if (Other.RowCount == 0)
+    {
+        return;
+    }
+
+    if (RowCount == 0 && Other.Columns.Num() == ColumnNames.Num())
+    {
+        // 本表没有行，直接接管另一张表的列
+        Columns = MoveTemp(Other.Columns);
+        RowCount = Other.RowCount;
+        Other.ResetRows();
+        return;
+    }
+
+    EnsureColumns();
+    for (int32 ColumnIndex = 0; ColumnIndex < Columns.Num(); ++ColumnIndex)
+    {
+        if (Other.Columns.IsValidIndex(ColumnIndex))
+        {
+            Columns[ColumnIndex].AppendColumn(Other.Columns[ColumnIndex]);
+        }
+        else
+        {
+            Columns[ColumnIndex].AppendNull(Other.RowCount);
+        }
+    }
+    RowCount += Other.RowCount;
+    Other.ResetRows();
+}
+
+void FXVDataTable::AppendTables(TArrayView<FXVDataTable> Others)
+{
+    EnsureColumns();
+
+    // 各列之间互不影响，按列并行合并
+    ParallelFor(Columns.Num(), [this, Others](int32 ColumnIndex)
+    {
+        FXVDataColumn& Column = Columns[ColumnIndex];
+        for (const FXVDataTable& Other : Others)
+        {
+            if (Other.Columns.IsValidIndex(ColumnIndex))
+            {
+                Column.AppendColumn(Other.Columns[ColumnIndex]);
+            }
+            else
+            {
+                Column.AppendNull(Other.RowCount);
+            }
+        }
+    });
+
+    for (FXVDataTable& Other : Others)
+    {
+        RowCount += Other.RowCount;
+        Other.ResetRows();
+    }
+}
+
+void FXVDataTable::Reserve(int32 NumRows)
+{
+    EnsureColumns();
+    for (FXVDataColumn& Column : Columns)
+    {
+        Column.Reserve(NumRows);
+    }
+}
+
+FString FXVDataTable::GetCellAsString(int32 RowIndex, int32 ColumnIndex) const
+{
+    const FXVDataColumn* Column = GetColumn(ColumnIndex);
+    return Column && RowIndex >= 0 && RowIndex < Column->Num() ? Column->GetString(RowIndex) : FString();
+}
+
+double FXVDataTable::GetNumber(int32 RowIndex, int32 ColumnIndex) const
+{
+    const FXVDataColumn* Column = GetColumn(ColumnIndex);
+    return Column && RowIndex >= 0 && RowIndex < Column->Num() ? Column->GetNumber(RowIndex) : 0.0;
+}
+
+SIZE_T FXVDataTable::GetAllocatedSize() const
+{
+    SIZE_T Size = ColumnNames.GetAllocatedSize() + Columns.GetAllocatedSize();
+    for (const FXVDataColumn& Column : Columns)
+    {
+        Size += Column.GetAllocatedSize();
+    }
+    return Size;
+}
+
+void FXVDataTable::EnsureColumns()
+{
+    while (Columns.Num() < ColumnNames.Num())
+    {
+        Columns.AddDefaulted_GetRef().AppendNull(RowCount);
+    }
+}
@@ -0,0 +1,119 @@
+#include "DataProcessing/XVDenseGrid.h"
+
+void FXVDenseGrid::Build(const FXVChartGridData& GridData, bool bTruncateValues)
+{
+    Reset();
+
+    // 第一遍确定网格尺寸
+    const int32 NumPoints = GridData.Num();
+    for (int32 i = 0; i < NumPoints; ++i)
+    {
+        if (GridData.YIndices[i] >= 0 && GridData.XIndices[i] >= 0)
+        {
+            NumRows = FMath::Max(NumRows, GridData.YIndices[i] + 1);
+            NumCols = FMath::Max(NumCols, GridData.XIndices[i] + 1);
+        }
+    }
+
+    const int64 NumCells = static_cast<int64>(NumRows) * NumCols;
+    if (NumCells == 0 || NumCells > MAX_int32)
+    {
+        NumRows = 0;
+        NumCols = 0;
+        return;
+    }
+
+    Values.SetNumZeroed(static_cast<int32>(NumCells));
+    Validity.Init(false, static_cast<int32>(NumCells));
+    RowLengths.SetNumZeroed(NumRows);
+
+    // 第二遍写入单元格
+    for (int32 i = 0; i < NumPoints; ++i)
+    {
+        const int32 Row = GridData.YIndices[i];
+        const int32 Col = GridData.XIndices[i];
+        if (Row < 0 || Col < 0)
+        {
+            continue;
+        }
+
+        const int32 CellIndex = GetCellIndex(Row, Col);
+        Values[CellIndex] = bTruncateValues ? static_cast<float>(static_cast<int32>(GridData.Values[i])) : GridData.Values[i];
+        if (!Validity[CellIndex])
+        {
+            Validity[CellIndex] = true;
+            RowLengths[Row] = FMath::Max(RowLengths[Row], Col + 1);
+            ++NumValid;
+        }
+    }
+
+    // 最小值和最大值按最终保留的值统计
+    RecomputeRange();
+}
+
+void FXVDenseGrid::SetValue(int32 Row, int32 Col, float Value)
+{
+    check(Contains(Row, Col));
+
+    const int32 CellIndex = GetCellIndex(Row, Col);
+    Values[CellIndex] = Value;
+    if (!Validity[CellIndex])
+    {
+        Validity[CellIndex] = true;
+        RowLengths[Row] = FMath::Max(RowLengths[Row], Col + 1);
+        ++NumValid;
+    }
+
+    MinValue = NumValid == 1 ? Value : FMath::Min(MinValue, Value);
+    MaxValue = NumValid == 1 ? Value : FMath::Max(MaxValue, Value);
+}
+
+void FXVDenseGrid::RecomputeRange()
+{
+    if (NumValid == 0)
+    {
+        MinValue = 0.0f;
+        MaxValue = 0.0f;
+        return;
+    }
+
+    MinValue = TNumericLimits<float>::Max();
+    MaxValue = TNumericLimits<float>::Lowest();
+    for (TConstSetBitIterator<> It(Validity); It; ++It)
+    {
+        const float Value = Values[It.GetIndex()];
+        MinValue = FMath::Min(MinValue, Value);
+        MaxValue = FMath::Max(MaxValue, Value);
+    }
+}
+
+void FXVDenseGrid::ToGridData(FXVChartGridData& OutGridData) const
+{
+    OutGridData.Reset();
+    OutGridData.Reserve(NumValid);
+    ForEachValid([&OutGridData](int32 Row, int32 Col, float Value)
+    {
+        OutGridData.Add(Row, Col, Value);
+    });
+}
+
+void FXVDenseGrid::Reset()
+{
+    NumRows = 0;
+    NumCols = 0;
+    NumValid = 0;
+    MinValue = 0.0f;
+    MaxValue = 0.0f;
+    Values.Reset();
+    Validity.Reset();
+    RowLengths.Reset();
+}
+
+void FXVDenseGrid::GetValidValues(TArray<float>& OutValues) const
+{
+    OutValues.Reset(NumValid);
+    for (TConstSetBitIterator<> It(Validity); It; ++It)
+    {
+        OutValues.Add(Values[It.GetIndex()]);
+    }
+}
@@ -0,0 +1,112 @@
+#include "DataProcessing/XVDownsampler.h"
+
+void FXVDownsampler::LargestTriangleThreeBuckets(TConstArrayView<float> Xs, TConstArrayView<float> Ys, int32 Threshold, TArray<int32>& OutIndices)
+{
+    check(Xs.Num() == Ys.Num());
+    const int32 NumPoints = Xs.Num();
+    if (Threshold >= NumPoints || Threshold < 3)
+    {
+        KeepAll(NumPoints, OutIndices);
+        return;
+    }
+
+    OutIndices.Reset(Threshold);
+    OutIndices.Add(0);
+
+    // 首尾两点之外的点均分到Threshold-2个桶中
+    const double BucketSize = static_cast<double>(NumPoints - 2) / (Threshold - 2);
+    int32 Selected = 0;
+    for (int32 Bucket = 0; Bucket < Threshold - 2; ++Bucket)
+    {
+        // 下一个桶的平均点，最后一个桶之后为终点
+        const int32 NextStart = static_cast<int32>((Bucket + 1) * BucketSize) + 1;
+        const int32 NextEnd = FMath::Min(static_cast<int32>((Bucket + 2) * BucketSize) + 1, NumPoints);
+        double AverageX = 0.0;
+        double AverageY = 0.0;
+        for (int32 i = NextStart; i < NextEnd; ++i)
+        {
+            AverageX += Xs[i];
+            AverageY += Ys[i];
+        }
+        const int32 NextCount = NextEnd - NextStart;
+        AverageX /= NextCount;
+        AverageY /= NextCount;
+
+        // 当前桶中与前一个保留点、下一个桶的平均点构成面积最大的点
+        const int32 Start = static_cast<int32>(Bucket * BucketSize) + 1;
+        const int32 End = NextStart;
+        const double PrevX = Xs[Selected];
+        const double PrevY = Ys[Selected];
+        double MaxArea = -1.0;
+        for (int32 i = Start; i < End; ++i)
+        {
+            // 省略了系数1/2，只比较大小
+            const double Area = FMath::Abs((PrevX - AverageX) * (Ys[i] - PrevY) - (PrevX - Xs[i]) * (AverageY - PrevY));
+            if (Area > MaxArea)
+            {
+                MaxArea = Area;
+                Selected = i;
+            }
+        }
+        OutIndices.Add(Selected);
+    }
+
+    OutIndices.Add(NumPoints - 1);
+}
+
+void FXVDownsampler::MinMaxBuckets(TConstArrayView<float> Ys, int32 Threshold, TArray<int32>& OutIndices)
+{
+    const int32 NumPoints = Ys.Num();
+    if (Threshold >= NumPoints || NumPoints <= 2)
+    {
+        KeepAll(NumPoints, OutIndices);
+        return;
+    }
+
+    // 每个桶最多保留两个点，首尾两点另外保留
+    const int32 NumBuckets = FMath::Max(1, (Threshold - 2) / 2);
+    const double BucketSize = static_cast<double>(NumPoints - 2) / NumBuckets;
+
+    OutIndices.Reset(NumBuckets * 2 + 2);
+    OutIndices.Add(0);
+    for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+    {
+        const int32 Start = static_cast<int32>(Bucket * BucketSize) + 1;
+        const int32 End = FMath::Min(static_cast<int32>((Bucket + 1) * BucketSize) + 1, NumPoints - 1);
+        if (Start >= End)
+        {
+            continue;
+        }
+
+        int32 MinIndex = Start;
+        int32 MaxIndex = Start;
+        for (int32 i = Start + 1; i < End; ++i)
+        {
+            if (Ys[i] < Ys[MinIndex])
+            {
+                MinIndex = i;
+            }
+            else if (Ys[i] > Ys[MaxIndex])
+            {
+                MaxIndex = i;
+            }
+        }
+
+        // 按原顺序输出，保持X递增
+        OutIndices.Add(FMath::Min(MinIndex, MaxIndex));
+        if (MinIndex != MaxIndex)
+        {
+            OutIndices.Add(FMath::Max(MinIndex, MaxIndex));
+        }
+    }
+    OutIndices.Add(NumPoints - 1);
+}
+
+void FXVDownsampler::KeepAll(int32 NumPoints, TArray<int32>& OutIndices)
+{
+    OutIndices.Reset(NumPoints);
+    for (int32 i = 0; i < NumPoints; ++i)
+    {
+        OutIndices.Add(i);
+    }
+}
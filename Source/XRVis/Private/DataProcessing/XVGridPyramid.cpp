@@ -0,0 +1,254 @@
+#include "DataProcessing/XVGridPyramid.h"
+
+void FXVGridPyramid::Build(const FXVDenseGrid& Grid, int32 InMaxBlockSize)
+{
+    Reset();
+    NumRows = Grid.GetNumRows();
+    NumCols = Grid.GetNumCols();
+    MaxBlockSize = InMaxBlockSize;
+    if (IsEmpty())
+    {
+        return;
+    }
+
+    // 分块的求和面积表
+    const int32 NumCells = NumRows * NumCols;
+    SumTable.SetNumUninitialized(NumCells);
+    CountTable.SetNumUninitialized(NumCells);
+    for (int32 TileRow = 0; TileRow < NumRows; TileRow += TileSize)
+    {
+        for (int32 TileCol = 0; TileCol < NumCols; TileCol += TileSize)
+        {
+            BuildSumTile(Grid, TileRow, TileCol);
+        }
+    }
+
+    // 最大值稀疏表，第 (0, 0) 级为单元格本身，缺失的单元格为最小值
+    const TConstArrayView<float> Values = Grid.GetValues();
+    const TBitArray<>& Validity = Grid.GetValidity();
+    NumLevels = FMath::FloorLog2(FMath::Max(MaxBlockSize, 1)) + 1;
+    MaxLevels.SetNum(NumLevels * NumLevels);
+
+    TArray<float>& BaseLevel = MaxLevels[0];
+    BaseLevel.SetNumUninitialized(NumCells);
+    for (int32 CellIndex = 0; CellIndex < NumCells; ++CellIndex)
+    {
+        BaseLevel[CellIndex] = Validity[CellIndex] ? Values[CellIndex] : TNumericLimits<float>::Lowest();
+    }
+
+    for (int32 LevelY = 0; LevelY < NumLevels; ++LevelY)
+    {
+        for (int32 LevelX = 0; LevelX < NumLevels; ++LevelX)
+        {
+            if (LevelY == 0 && LevelX == 0)
+            {
+                continue;
+            }
+
+            TArray<float>& Level = MaxLevels[LevelY * NumLevels + LevelX];
+            Level.SetNumUninitialized(NumCells);
+            for (int32 Row = 0; Row < NumRows; ++Row)
+            {
+                for (int32 Col = 0; Col < NumCols; ++Col)
+                {
+                    Level[Row * NumCols + Col] = ComputeLevelMax(LevelY, LevelX, Row, Col);
+                }
+            }
+        }
+    }
+}
+
+void FXVGridPyramid::UpdateCells(const FXVDenseGrid& Grid, const TBitArray<>& DirtyCells)
+{
+    if (Grid.GetNumRows() != NumRows || Grid.GetNumCols() != NumCols)
+    {
+        Build(Grid, MaxBlockSize);
+        return;
+    }
+    check(DirtyCells.Num() == NumRows * NumCols);
+
+    // 同一分块中的多个单元格只重建一次
+    const int32 NumTileCols = FMath::DivideAndRoundUp(NumCols, TileSize);
+    TBitArray<> DirtyTiles(false, FMath::DivideAndRoundUp(NumRows, TileSize) * NumTileCols);
+    const TConstArrayView<float> Values = Grid.GetValues();
+    const TBitArray<>& Validity = Grid.GetValidity();
+    for (TConstSetBitIterator<> It(DirtyCells); It; ++It)
+    {
+        const int32 CellIndex = It.GetIndex();
+        DirtyTiles[CellIndex / NumCols / TileSize * NumTileCols + CellIndex % NumCols / TileSize] = true;
+        MaxLevels[0][CellIndex] = Validity[CellIndex] ? Values[CellIndex] : TNumericLimits<float>::Lowest();
+    }
+    for (TConstSetBitIterator<> It(DirtyTiles); It; ++It)
+    {
+        BuildSumTile(Grid, It.GetIndex() / NumTileCols * TileSize, It.GetIndex() % NumTileCols * TileSize);
+    }
+
+    // 稀疏表中覆盖修改单元格的项位于其左上方 2^LevelY x 2^LevelX 的范围内，按建立时的顺序逐级更新
+    for (int32 LevelY = 0; LevelY < NumLevels; ++LevelY)
+    {
+        for (int32 LevelX = 0; LevelX < NumLevels; ++LevelX)
+        {
+            if (LevelY == 0 && LevelX == 0)
+            {
+                continue;
+            }
+
+            TArray<float>& Level = MaxLevels[LevelY * NumLevels + LevelX];
+            for (TConstSetBitIterator<> It(DirtyCells); It; ++It)
+            {
+                const int32 DirtyRow = It.GetIndex() / NumCols;
+                const int32 DirtyCol = It.GetIndex() % NumCols;
+                for (int32 Row = FMath::Max(DirtyRow - (1 << LevelY) + 1, 0); Row <= DirtyRow; ++Row)
+                {
+                    for (int32 Col = FMath::Max(DirtyCol - (1 << LevelX) + 1, 0); Col <= DirtyCol; ++Col)
+                    {
+                        Level[Row * NumCols + Col] = ComputeLevelMax(LevelY, LevelX, Row, Col);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void FXVGridPyramid::Reset()
+{
+    NumRows = 0;
+    NumCols = 0;
+    NumLevels = 0;
+    SumTable.Reset();
+    CountTable.Reset();
+    MaxLevels.Reset();
+}
+
+void FXVGridPyramid::BuildSumTile(const FXVDenseGrid& Grid, int32 TileRow, int32 TileCol)
+{
+    const TConstArrayView<float> Values = Grid.GetValues();
+    const TBitArray<>& Validity = Grid.GetValidity();
+    const int32 EndRow = FMath::Min(TileRow + TileSize, NumRows);
+    const int32 EndCol = FMath::Min(TileCol + TileSize, NumCols);
+    for (int32 Row = TileRow; Row < EndRow; ++Row)
+    {
+        double RowSum = 0.0;
+        int32 RowCount = 0;
+        for (int32 Col = TileCol; Col < EndCol; ++Col)
+        {
+            const int32 CellIndex = Row * NumCols + Col;
+            if (Validity[CellIndex])
+            {
+                RowSum += Values[CellIndex];
+                ++RowCount;
+            }
+            SumTable[CellIndex] = (Row > TileRow ? SumTable[CellIndex - NumCols] : 0.0) + RowSum;
+            CountTable[CellIndex] = (Row > TileRow ? CountTable[CellIndex - NumCols] : 0) + RowCount;
+        }
+    }
+}
+
+template <typename ValueType>
+ValueType FXVGridPyramid::SumTiles(const TArray<ValueType>& Table, int32 Row, int32 Col, int32 Height, int32 Width) const
+{
+    // 分块内从左上角开始的和，超出分块的行或列按0计
+    auto GetPrefix = [this, &Table](int32 CellRow, int32 CellCol, int32 TileRow, int32 TileCol)
+    {
+        return CellRow < TileRow || CellCol < TileCol ? ValueType(0) : Table[CellRow * NumCols + CellCol];
+    };
+
+    ValueType Result = 0;
+    const int32 EndRow = Row + Height;
+    const int32 EndCol = Col + Width;
+    for (int32 StartRow = Row; StartRow < EndRow;)
+    {
+        const int32 TileRow = StartRow / TileSize * TileSize;
+        const int32 LastRow = FMath::Min(TileRow + TileSize, EndRow) - 1;
+        for (int32 StartCol = Col; StartCol < EndCol;)
+        {
+            const int32 TileCol = StartCol / TileSize * TileSize;
+            const int32 LastCol = FMath::Min(TileCol + TileSize, EndCol) - 1;
+            Result += GetPrefix(LastRow, LastCol, TileRow, TileCol) - GetPrefix(StartRow - 1, LastCol, TileRow, TileCol)
+                - GetPrefix(LastRow, StartCol - 1, TileRow, TileCol) + GetPrefix(StartRow - 1, StartCol - 1, TileRow, TileCol);
+            StartCol = LastCol + 1;
+        }
+        StartRow = LastRow + 1;
+    }
+    return Result;
+}
+
+float FXVGridPyramid::ComputeLevelMax(int32 LevelY, int32 LevelX, int32 Row, int32 Col) const
+{
+    // 由X方向或Y方向上低一级的两个相邻矩形合并得到，超出网格的一半直接忽略
+    const bool bMergeX = LevelX > 0;
+    const TArray<float>& Source = bMergeX ? MaxLevels[LevelY * NumLevels + LevelX - 1] : MaxLevels[(LevelY - 1) * NumLevels + LevelX];
+    const int32 Half = 1 << ((bMergeX ? LevelX : LevelY) - 1);
+    const int32 CellIndex = Row * NumCols + Col;
+    float Value = Source[CellIndex];
+    if (bMergeX && Col + Half < NumCols)
+    {
+        Value = FMath::Max(Value, Source[CellIndex + Half]);
+    }
+    else if (!bMergeX && Row + Half < NumRows)
+    {
+        Value = FMath::Max(Value, Source[CellIndex + Half * NumCols]);
+    }
+    return Value;
+}
+
+bool FXVGridPyramid::ClipRect(int32& Row, int32& Col, int32& Height, int32& Width) const
+{
+    const int32 EndRow = FMath::Min(Row + Height, NumRows);
+    const int32 EndCol = FMath::Min(Col + Width, NumCols);
+    Row = FMath::Max(Row, 0);
+    Col = FMath::Max(Col, 0);
+    Height = EndRow - Row;
+    Width = EndCol - Col;
+    return Height > 0 && Width > 0;
+}
+
+double FXVGridPyramid::GetSum(int32 Row, int32 Col, int32 Height, int32 Width) const
+{
+    if (!ClipRect(Row, Col, Height, Width))
+    {
+        return 0.0;
+    }
+    return SumTiles(SumTable, Row, Col, Height, Width);
+}
+
+int32 FXVGridPyramid::GetValidCount(int32 Row, int32 Col, int32 Height, int32 Width) const
+{
+    if (!ClipRect(Row, Col, Height, Width))
+    {
+        return 0;
+    }
+    return SumTiles(CountTable, Row, Col, Height, Width);
+}
+
+float FXVGridPyramid::GetMax(int32 Row, int32 Col, int32 Height, int32 Width) const
+{
+    if (!ClipRect(Row, Col, Height, Width))
+    {
+        return TNumericLimits<float>::Lowest();
+    }
+
+    const int32 LevelY = FMath::FloorLog2(Height);
+    const int32 LevelX = FMath::FloorLog2(Width);
+    if (LevelY >= NumLevels || LevelX >= NumLevels)
+    {
+        const TArray<float>& BaseLevel = MaxLevels[0];
+        float Result = TNumericLimits<float>::Lowest();
+        for (int32 CellY = Row; CellY < Row + Height; ++CellY)
+        {
+            for (int32 CellX = Col; CellX < Col + Width; ++CellX)
+            {
+                Result = FMath::Max(Result, BaseLevel[CellY * NumCols + CellX]);
+            }
+        }
+        return Result;
+    }
+
+    // 四个 2^LevelY x 2^LevelX 的矩形从四个角覆盖整个查询区域，重叠部分不影响最大值
+    const TArray<float>& Level = MaxLevels[LevelY * NumLevels + LevelX];
+    const int32 LastRow = Row + Height - (1 << LevelY);
+    const int32 LastCol = Col + Width - (1 << LevelX);
+    return FMath::Max(
+        FMath::Max(Level[Row * NumCols + Col], Level[Row * NumCols + LastCol]),
+        FMath::Max(Level[LastRow * NumCols + Col], Level[LastRow * NumCols + LastCol]));
+}
@@ -1,12 +1,203 @@
 #include "DataProcessing/XVJsonDataReader.h"
+#include "DataProcessing/XVTimestampParser.h"
+#include "XVCategoryEncoder.h"
+#include "XVJsonPullParser.h"
+#include "XVUtf8FileReader.h"
 #include "JsonObjectConverter.h"
+#include "Misc/FileHelper.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 
+namespace XVJsonDataReaderPrivate
+{
+    /** 每读取多少个顶层元素报告一次进度 */
+    constexpr int32 ProgressInterval = 4096;
+
+    /** 解析一行时暂存的单元格 */
+    struct FCell
+    {
+        enum class EKind : uint8
+        {
+            Null,
+            Int64,
+            Number,
+            String
+        };
+
+        EKind Kind = EKind::Null;
+        int64 IntValue = 0;
+        double NumberValue = 0.0;
+        FString Text;
+    };
+
+    /** 读取以Token开始的值，数组和对象会被跳过并作为空值 */
+    bool ReadCell(FXVJsonPullParser& Parser, EXVJsonToken Token, FCell& OutCell)
+    {
+        switch (Token)
+        {
+        case EXVJsonToken::Number:
+            if (Parser.TryGetInt64(OutCell.IntValue))
+            {
+                OutCell.Kind = FCell::EKind::Int64;
+            }
+            else
+            {
+                OutCell.Kind = FCell::EKind::Number;
+                OutCell.NumberValue = Parser.GetNumber();
+            }
+            return true;
+
+        case EXVJsonToken::String:
+            OutCell.Kind = FCell::EKind::String;
+            OutCell.Text.Reset();
+            OutCell.Text.Append(Parser.GetString());
+            return true;
+
+        case EXVJsonToken::True:
+        case EXVJsonToken::False:
+            OutCell.Kind = FCell::EKind::String;
+            OutCell.Text = Token == EXVJsonToken::True ? TEXT("true") : TEXT("false");
+            return true;
+
+        case EXVJsonToken::Null:
+            OutCell.Kind = FCell::EKind::Null;
+            return true;
+
+        case EXVJsonToken::ArrayStart:
+        case EXVJsonToken::ObjectStart:
+            OutCell.Kind = FCell::EKind::Null;
+            return Parser.SkipValue(Token);
+
+        default:
+            return false;
+        }
+    }
+
+    /** 将单元格追加到列 */
+    void AppendCell(FXVDataColumn& Column, const FCell& Cell)
+    {
+        switch (Cell.Kind)
+        {
+        case FCell::EKind::Int64:
+            Column.AppendInt64(Cell.IntValue);
+            break;
+        case FCell::EKind::Number:
+            Column.AppendNumber(Cell.NumberValue);
+            break;
+        case FCell::EKind::String:
+            Column.AppendString(Cell.Text);
+            break;
+        default:
+            Column.AppendNull();
+            break;
+        }
+    }
+
+    /** 读取数值，数字字符串也按数值处理 */
+    bool TryReadNumber(const FXVJsonPullParser& Parser, EXVJsonToken Token, double& OutValue)
+    {
+        if (Token == EXVJsonToken::Number)
+        {
+            OutValue = Parser.GetNumber();
+            return true;
+        }
+        if (Token == EXVJsonToken::String)
+        {
+            const FString Text(Parser.GetString());
+            if (Text.IsNumeric())
+            {
+                OutValue = FCString::Atod(*Text);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /** 读取时间值：数值、数值字符串或时间戳字符串（转换为Unix秒） */
+    bool TryReadTime(const FXVJsonPullParser& Parser, EXVJsonToken Token, FXVTimestampParser& TimeParser, double& OutValue)
+    {
+        if (TryReadNumber(Parser, Token, OutValue))
+        {
+            return true;
+        }
+
+        int64 Ticks;
+        if (Token == EXVJsonToken::String && TimeParser.Parse(Parser.GetString().TrimStartAndEnd(), Ticks))
+        {
+            OutValue = FXVDataColumn::TimestampToUnixSeconds(Ticks);
+            return true;
+        }
+        return false;
+    }
+
+    /** 编码作为分类键的值，与FJsonValue::TryGetString的结果保持一致；无法作为键时返回INDEX_NONE */
+    int32 EncodeKeyValue(const FXVJsonPullParser& Parser, EXVJsonToken Token, FXVCategoryEncoder& Encoder, FString& Scratch)
+    {
+        switch (Token)
+        {
+        case EXVJsonToken::String:
+            Scratch.Reset();
+            Scratch.Append(Parser.GetString());
+            return Encoder.Encode(Scratch);
+        case EXVJsonToken::Number:
+            return Encoder.EncodeNumber(Parser.GetNumber());
+        case EXVJsonToken::True:
+            return Encoder.Encode(TEXT("true"));
+        case EXVJsonToken::False:
+            return Encoder.Encode(TEXT("false"));
+        default:
+            return INDEX_NONE;
+        }
+    }
+}
+
 UXVJsonDataReader::UXVJsonDataReader()
 {
     bFlattenObjectKeys = true;
     KeySeparator = TEXT(".");
+    StreamChunkSize = 1024 * 1024;
+}
+
+FString UXVJsonDataReader::GetCacheOptionsKey() const
+{
+    return FString::Printf(TEXT("%s|%d|%s"), *Super::GetCacheOptionsKey(), bFlattenObjectKeys, *KeySeparator);
+}
+
+bool UXVJsonDataReader::ReadFromFile(const FString& FilePath)
+{
+    // 清除之前的数据
+    DataTable.Clear();
+    LastError.Empty();
+
+    FXVUtf8FileReader FileReader;
+    if (!FileReader.Open(FilePath, StreamChunkSize))
+    {
+        LastError = FString::Printf(TEXT("无法读取文件: %s"), *FilePath);
+        return false;
+    }
+
+    if (FileReader.IsUtf16())
+    {
+        // UTF-16文件无法按UTF-8分块解码，回退到整体读取
+        return Super::ReadFromFile(FilePath);
+    }
+
+    FXVJsonPullParser Parser(FileReader);
+    const EXVJsonToken Token = Parser.Next();
+    if (Token == EXVJsonToken::ArrayStart)
+    {
+        return ReadArrayFromParser(Parser);
+    }
+    if (Token == EXVJsonToken::ObjectStart)
+    {
+        // 对象型JSON的扁平化需要完整的对象，回退到整体读取
+        return Super::ReadFromFile(FilePath);
+    }
+
+    LastError = Token == EXVJsonToken::Error
+        ? FString::Printf(TEXT("JSON解析失败: %s"), *Parser.GetErrorMessage())
+        : TEXT("不支持的JSON格式，必须是数组或对象");
+    return false;
 }
 
 bool UXVJsonDataReader::ReadFromString(const FString& Content)
@@ -21,6 +212,375 @@ bool UXVJsonDataReader::ReadFromString(const FString& Content)
         return false;
     }
 
+    FXVJsonPullParser Parser(Content);
+    const EXVJsonToken Token = Parser.Next();
+    if (Token == EXVJsonToken::ArrayStart)
+    {
+        return ReadArrayFromParser(Parser);
+    }
+
+    // 对象型或无法识别的内容按DOM方式处理，保持原有的错误信息
+    return ReadFromStringDom(Content);
+}
+
+bool UXVJsonDataReader::ReadChartGridFromFile(const FString& FilePath, const FString& XProperty, const FString& YProperty, const FString& ZProperty,
+                                              const FString& TimeProperty, FXVChartGridData& OutGrid)
+{
+    LastError.Empty();
+    OutGrid.Reset();
+
+    FXVUtf8FileReader FileReader;
+    if (!FileReader.Open(FilePath, StreamChunkSize))
+    {
+        LastError = FString::Printf(TEXT("无法读取文件: %s"), *FilePath);
+        return false;
+    }
+
+    if (FileReader.IsUtf16())
+    {
+        FString FileContent;
+        if (!FFileHelper::LoadFileToString(FileContent, *FilePath))
+        {
+            LastError = FString::Printf(TEXT("无法读取文件: %s"), *FilePath);
+            return false;
+        }
+        return ReadChartGridFromString(FileContent, XProperty, YProperty, ZProperty, TimeProperty, OutGrid);
+    }
+
+    FXVJsonPullParser Parser(FileReader);
+    if (Parser.Next() != EXVJsonToken::ArrayStart)
+    {
+        LastError = TEXT("图表数据必须是JSON数组");
+        return false;
+    }
+    return ReadGridFromParser(Parser, XProperty, YProperty, ZProperty, TimeProperty, OutGrid);
+}
+
+bool UXVJsonDataReader::ReadChartGridFromString(const FString& Content, const FString& XProperty, const FString& YProperty, const FString& ZProperty,
+                                                const FString& TimeProperty, FXVChartGridData& OutGrid)
+{
+    LastError.Empty();
+    OutGrid.Reset();
+
+    FXVJsonPullParser Parser(Content);
+    if (Parser.Next() != EXVJsonToken::ArrayStart)
+    {
+        LastError = TEXT("图表数据必须是JSON数组");
+        return false;
+    }
+    return ReadGridFromParser(Parser, XProperty, YProperty, ZProperty, TimeProperty, OutGrid);
+}
+
+bool UXVJsonDataReader::ReadArrayFromParser(FXVJsonPullParser& Parser)
+{
+    using namespace XVJsonDataReaderPrivate;
+
+    // 第一个元素决定列名：数组行生成默认列名（列索引），对象行使用其键
+    TArray<FCell> RowCells;
+    TMap<FString, int32> HeaderIndices;
+    FString Key;
+    bool bHeadersFixed = false;
+    int32 NumElements = 0;
+
+    EXVJsonToken Token = Parser.Next();
+    if (Token == EXVJsonToken::ArrayEnd)
+    {
+        LastError = TEXT("JSON数组为空");
+        return false;
+    }
+
+    while (Token != EXVJsonToken::ArrayEnd && Token != EXVJsonToken::Error)
+    {
+        for (FCell& Cell : RowCells)
+        {
+            Cell.Kind = FCell::EKind::Null;
+        }
+
+        bool bIsRow = true;
+        if (Token == EXVJsonToken::ArrayStart)
+        {
+            // 处理数组格式的行，超出列数的单元格被忽略
+            int32 CellIndex = 0;
+            for (Token = Parser.Next(); Token != EXVJsonToken::ArrayEnd && Token != EXVJsonToken::Error; Token = Parser.Next(), ++CellIndex)
+            {
+                if (!bHeadersFixed)
+                {
+                    DataTable.ColumnNames.Add(FString::Printf(TEXT("Column%d"), CellIndex));
+                    RowCells.AddDefaulted();
+                }
+
+                const bool bRead = RowCells.IsValidIndex(CellIndex) ? ReadCell(Parser, Token, RowCells[CellIndex]) : Parser.SkipValue(Token);
+                if (!bRead)
+                {
+                    Token = EXVJsonToken::Error;
+                    break;
+                }
+            }
+        }
+        else if (Token == EXVJsonToken::ObjectStart)
+        {
+            // 处理对象格式的行，按键名匹配列
+            for (Token = Parser.Next(); Token == EXVJsonToken::Key; Token = Parser.Next())
+            {
+                Key.Reset();
+                Key.Append(Parser.GetString());
+
+                const int32* ColumnIndex = HeaderIndices.Find(Key);
+                if (!ColumnIndex && !bHeadersFixed)
+                {
+                    const int32 NewIndex = DataTable.ColumnNames.Add(Key);
+                    RowCells.AddDefaulted();
+                    ColumnIndex = &HeaderIndices.Add(Key, NewIndex);
+                }
+
+                const EXVJsonToken ValueToken = Parser.Next();
+                const bool bRead = ColumnIndex ? ReadCell(Parser, ValueToken, RowCells[*ColumnIndex]) : Parser.SkipValue(ValueToken);
+                if (!bRead)
+                {
+                    Token = EXVJsonToken::Error;
+                    break;
+                }
+            }
+        }
+        else
+        {
+            // 标量元素不构成行
+            bIsRow = false;
+            if (!Parser.SkipValue(Token))
+            {
+                Token = EXVJsonToken::Error;
+            }
+        }
+
+        if (Token == EXVJsonToken::Error)
+        {
+            break;
+        }
+
+        if (!bHeadersFixed)
+        {
+            bHeadersFixed = true;
+            if (HeaderIndices.Num() == 0)
+            {
+                // 数组行也允许对象行按默认列名取值
+                for (int32 ColumnIndex = 0; ColumnIndex < DataTable.ColumnNames.Num(); ++ColumnIndex)
+                {
+                    HeaderIndices.Add(DataTable.ColumnNames[ColumnIndex], ColumnIndex);
+                }
+            }
+        }
+
+        if (bIsRow && DataTable.ColumnNames.Num() > 0)
+        {
+            for (int32 ColumnIndex = 0; ColumnIndex < RowCells.Num(); ++ColumnIndex)
+            {
+                AppendCell(DataTable.GetMutableColumn(ColumnIndex), RowCells[ColumnIndex]);
+            }
+            DataTable.CommitRow();
+        }
+
+        if (++NumElements % ProgressInterval == 0 && !ReportProgress(Parser.GetProgress()))
+        {
+            DataTable.Clear();
+            return false;
+        }
+
+        Token = Parser.Next();
+    }
+
+    if (Token != EXVJsonToken::Error)
+    {
+        Token = Parser.Next();
+    }
+    if (Token != EXVJsonToken::End)
+    {
+        LastError = FString::Printf(TEXT("JSON解析失败: %s"), *Parser.GetErrorMessage());
+        DataTable.Clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool UXVJsonDataReader::ReadGridFromParser(FXVJsonPullParser& Parser, const FString& XProperty, const FString& YProperty, const FString& ZProperty,
+                                           const FString& TimeProperty, FXVChartGridData& OutGrid)
+{
+    using namespace XVJsonDataReaderPrivate;
+
+    // 命名对象的X/Y取值先按出现顺序编号，读取完成后排序并重新映射
+    FXVCategoryEncoder XEncoder;
+    FXVCategoryEncoder YEncoder;
+    FString Label;
+
+    FXVTimestampParser TimeParser;
+    bool bHasTime = false;
+    bool bNamed = false;
+    int32 NumElements = 0;
+    EXVJsonToken Token = Parser.Next();
+
+    if (Token == EXVJsonToken::ObjectStart)
+    {
+        bNamed = true;
+        if (XProperty.IsEmpty() || YProperty.IsEmpty() || ZProperty.IsEmpty())
+        {
+            LastError = TEXT("缺少必要的属性映射，请设置XProperty、YProperty和ZProperty");
+            return false;
+        }
+    }
+
+    while (Token != EXVJsonToken::ArrayEnd && Token != EXVJsonToken::Error)
+    {
+        // 没有时间值时使用数据点序号作为默认时间
+        double Values[4] = { 0.0, 0.0, 0.0, static_cast<double>(OutGrid.Num()) };
+
+        if (!bNamed && Token == EXVJsonToken::ArrayStart)
+        {
+            // 原始格式 [y, x, z(, time)]
+            int32 NumValues = 0;
+            for (Token = Parser.Next(); Token != EXVJsonToken::ArrayEnd && Token != EXVJsonToken::Error; Token = Parser.Next())
+            {
+                const bool bRead = NumValues < 3 ? TryReadNumber(Parser, Token, Values[NumValues])
+                    : NumValues == 3 && TryReadTime(Parser, Token, TimeParser, Values[3]);
+                if (bRead)
+                {
+                    bHasTime |= NumValues == 3;
+                    ++NumValues;
+                }
+                else if (NumValues < 3 || !Parser.SkipValue(Token))
+                {
+                    // 前三个值必须是数值
+                    LastError = TEXT("数据项格式错误，应为[y,x,z]或[y,x,z,time]");
+                    return false;
+                }
+            }
+            if (Token == EXVJsonToken::Error)
+            {
+                break;
+            }
+            if (NumValues < 3)
+            {
+                LastError = TEXT("数据项格式错误，应为[y,x,z]或[y,x,z,time]");
+                return false;
+            }
+
+            OutGrid.Add(static_cast<int32>(Values[0]), static_cast<int32>(Values[1]), static_cast<float>(Values[2]), Values[3]);
+        }
+        else if (bNamed && Token == EXVJsonToken::ObjectStart)
+        {
+            // 命名格式 {"x": ..., "y": ..., "z": ..., "time": ...}
+            int32 XId = INDEX_NONE;
+            int32 YId = INDEX_NONE;
+            bool bHasX = false;
+            bool bHasY = false;
+            bool bHasZ = false;
+
+            for (Token = Parser.Next(); Token == EXVJsonToken::Key; Token = Parser.Next())
+            {
+                const FStringView Key = Parser.GetString();
+                const bool bIsX = Key.Equals(XProperty, ESearchCase::IgnoreCase);
+                const bool bIsY = Key.Equals(YProperty, ESearchCase::IgnoreCase);
+                const bool bIsZ = Key.Equals(ZProperty, ESearchCase::IgnoreCase);
+                const bool bIsTime = !TimeProperty.IsEmpty() && Key.Equals(TimeProperty, ESearchCase::IgnoreCase);
+
+                const EXVJsonToken ValueToken = Parser.Next();
+                if (bIsX || bIsY)
+                {
+                    // 字段存在即参与数据点，无法作为标签的值映射到索引0
+                    if (bIsX)
+                    {
+                        XId = EncodeKeyValue(Parser, ValueToken, XEncoder, Label);
+                    }
+                    if (bIsY)
+                    {
+                        YId = EncodeKeyValue(Parser, ValueToken, YEncoder, Label);
+                    }
+                    bHasX |= bIsX;
+                    bHasY |= bIsY;
+                }
+                if (bIsZ)
+                {
+                    TryReadNumber(Parser, ValueToken, Values[2]);
+                    bHasZ = true;
+                }
+                if (bIsTime)
+                {
+                    TryReadTime(Parser, ValueToken, TimeParser, Values[3]);
+                    bHasTime = true;
+                }
+                if (!Parser.SkipValue(ValueToken))
+                {
+                    Token = EXVJsonToken::Error;
+                    break;
+                }
+            }
+            if (Token != EXVJsonToken::ObjectEnd)
+            {
+                break;
+            }
+
+            if (bHasX && bHasY && bHasZ)
+            {
+                OutGrid.Add(YId, XId, static_cast<float>(Values[2]), Values[3]);
+            }
+        }
+        else if (!Parser.SkipValue(Token))
+        {
+            // 与第一个元素格式不一致的元素被忽略
+            break;
+        }
+
+        if (++NumElements % ProgressInterval == 0 && !ReportProgress(Parser.GetProgress()))
+        {
+            OutGrid.Reset();
+            return false;
+        }
+
+        Token = Parser.Next();
+    }
+
+    if (Token != EXVJsonToken::Error)
+    {
+        Token = Parser.Next();
+    }
+    if (Token != EXVJsonToken::End)
+    {
+        LastError = FString::Printf(TEXT("JSON解析失败: %s"), *Parser.GetErrorMessage());
+        OutGrid.Reset();
+        return false;
+    }
+
+    if (!bHasTime)
+    {
+        OutGrid.Times.Reset();
+    }
+
+    if (bNamed)
+    {
+        // 排序轴标签并把出现顺序编号映射为排序后的索引
+        XEncoder.Finalize(OutGrid.XLabels, OutGrid.XIndices);
+        YEncoder.Finalize(OutGrid.YLabels, OutGrid.YIndices);
+    }
+
+    if (OutGrid.Num() == 0)
+    {
+        LastError = TEXT("没有有效的数据点");
+        return false;
+    }
+    return true;
+}
+
+bool UXVJsonDataReader::ReadFromStringDom(const FString& Content)
+{
+    // 清除之前的数据
+    DataTable.Clear();
+    LastError.Empty();
+
+    if (Content.IsEmpty())
+    {
+        LastError = TEXT("JSON内容为空");
+        return false;
+    }
+
     // 尝试解析JSON
     TSharedPtr<FJsonValue> JsonValue;
     TSharedRef<TJsonReader<>> JsonReader = TJsonReaderFactory<>::Create(Content);
@@ -113,44 +673,44 @@ bool UXVJsonDataReader::ReadFromJsonArray(const TArray<TSharedPtr<FJsonValue>>&
         {
             // 处理数组格式的行
             TArray<TSharedPtr<FJsonValue>> Row = JsonArray[i]->AsArray();
-            FXVDataRow RowData;
+            TArray<FString> RowCells;
             
             for (int32 j = 0; j < Row.Num(); ++j)
             {
                 if (j < Headers.Num())
                 {
-                    RowData.Cells.Add(Row[j]->AsString());
+                    RowCells.Add(Row[j]->AsString());
                 }
             }
             
             // 如果行长度小于标题数，用空字符串填充
-            while (RowData.Cells.Num() < Headers.Num())
+            while (RowCells.Num() < Headers.Num())
             {
-                RowData.Cells.Add(TEXT(""));
+                RowCells.Add(TEXT(""));
             }
             
-            DataTable.Rows.Add(RowData);
+            DataTable.AddRow(RowCells);
         }
         else if (JsonArray[i]->Type == EJson::Object)
         {
             // 处理对象格式的行
             TSharedPtr<FJsonObject> RowObj = JsonArray[i]->AsObject();
-            FXVDataRow RowData;
+            TArray<FString> RowCells;
             
             for (const FString& Header : Headers)
             {
                 if (RowObj->HasField(Header))
                 {
                     TSharedPtr<FJsonValue> Value = RowObj->Values.FindRef(Header);
-                    RowData.Cells.Add(Value->AsString());
+                    RowCells.Add(Value->AsString());
                 }
                 else
                 {
-                    RowData.Cells.Add(TEXT(""));
+                    RowCells.Add(TEXT(""));
                 }
             }
             
-            DataTable.Rows.Add(RowData);
+            DataTable.AddRow(RowCells);
         }
     }
     
@@ -279,21 +839,21 @@ bool UXVJsonDataReader::ReadFromJsonObject(const TSharedPtr<FJsonObject>& JsonOb
         // 构建行数据
         for (const TMap<FString, FString>& Row : FlattenedRows)
         {
-            FXVDataRow RowData;
+            TArray<FString> RowCells;
             
             for (const FString& Key : DataTable.ColumnNames)
             {
                 if (Row.Contains(Key))
                 {
-                    RowData.Cells.Add(Row.FindRef(Key));
+                    RowCells.Add(Row.FindRef(Key));
                 }
                 else
                 {
-                    RowData.Cells.Add(TEXT(""));
+                    RowCells.Add(TEXT(""));
                 }
             }
             
-            DataTable.Rows.Add(RowData);
+            DataTable.AddRow(RowCells);
         }
     }
     else
@@ -305,15 +865,15 @@ bool UXVJsonDataReader::ReadFromJsonObject(const TSharedPtr<FJsonObject>& JsonOb
         DataTable.ColumnNames = Keys;
         
         // 只创建一行数据
-        FXVDataRow RowData;
+        TArray<FString> RowCells;
         
         for (const FString& Key : Keys)
         {
             TSharedPtr<FJsonValue> Value = JsonObject->Values.FindRef(Key);
-            RowData.Cells.Add(Value->AsString());
+            RowCells.Add(Value->AsString());
         }
         
-        DataTable.Rows.Add(RowData);
+        DataTable.AddRow(RowCells);
     }
     
     return true;
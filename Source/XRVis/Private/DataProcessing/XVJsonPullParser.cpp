@@ -0,0 +1,483 @@
+#include "XVJsonPullParser.h"
+#include "XVCsvScanner.h"
+#include "XVUtf8FileReader.h"
+
+FXVJsonPullParser::FXVJsonPullParser(FStringView Text)
+    : Data(Text.GetData())
+    , DataLen(Text.Len())
+{
+}
+
+FXVJsonPullParser::FXVJsonPullParser(FXVUtf8FileReader& InFileReader)
+    : FileReader(&InFileReader)
+{
+}
+
+EXVJsonToken FXVJsonPullParser::Next()
+{
+    if (!ErrorMessage.IsEmpty())
+    {
+        return EXVJsonToken::Error;
+    }
+
+    StringValue.Reset();
+    TokenStart = Pos;
+
+    if (!SkipWhitespace())
+    {
+        if (!ErrorMessage.IsEmpty())
+        {
+            return EXVJsonToken::Error;
+        }
+        if (ContainerStack.Num() == 0 && bRootParsed)
+        {
+            return EXVJsonToken::End;
+        }
+        return SetError(TEXT("意外的结尾"));
+    }
+
+    TCHAR Char = Data[Pos];
+
+    if (Expect == EExpect::CommaOrEnd)
+    {
+        if (ContainerStack.Num() == 0)
+        {
+            return SetError(TEXT("顶层值之后存在多余的内容"));
+        }
+
+        const bool bInObject = ContainerStack.Last();
+        if (Char == TEXT(','))
+        {
+            ++Pos;
+            Expect = bInObject ? EExpect::Key : EExpect::Value;
+            if (!SkipWhitespace())
+            {
+                return ErrorMessage.IsEmpty() ? SetError(TEXT("意外的结尾")) : EXVJsonToken::Error;
+            }
+            Char = Data[Pos];
+        }
+        else if (Char == (bInObject ? TEXT('}') : TEXT(']')))
+        {
+            ++Pos;
+            ContainerStack.Pop();
+            OnValueEnd();
+            return bInObject ? EXVJsonToken::ObjectEnd : EXVJsonToken::ArrayEnd;
+        }
+        else
+        {
+            return SetError(bInObject ? TEXT("缺少逗号或右花括号") : TEXT("缺少逗号或右方括号"));
+        }
+    }
+
+    TokenStart = Pos;
+
+    if (Expect == EExpect::Key || Expect == EExpect::KeyOrObjectEnd)
+    {
+        if (Char == TEXT('}') && Expect == EExpect::KeyOrObjectEnd)
+        {
+            ++Pos;
+            ContainerStack.Pop();
+            OnValueEnd();
+            return EXVJsonToken::ObjectEnd;
+        }
+        if (Char != TEXT('"'))
+        {
+            return SetError(TEXT("对象的键必须是字符串"));
+        }
+        if (!ParseString())
+        {
+            return EXVJsonToken::Error;
+        }
+
+        // 键的内容保存为相对TokenStart的位置，跳过空白时不能丢弃
+        const bool bKeyInBuffer = !bStringUnescaped;
+        const int32 KeyOffset = bKeyInBuffer ? static_cast<int32>(StringValue.GetData() - (Data + TokenStart)) : 0;
+        const int32 KeyLen = StringValue.Len();
+
+        while (true)
+        {
+            if (!EnsureAvailable(1))
+            {
+                return ErrorMessage.IsEmpty() ? SetError(TEXT("缺少冒号")) : EXVJsonToken::Error;
+            }
+            if (!FChar::IsWhitespace(Data[Pos]))
+            {
+                break;
+            }
+            ++Pos;
+        }
+        if (Data[Pos] != TEXT(':'))
+        {
+            return SetError(TEXT("缺少冒号"));
+        }
+        ++Pos;
+
+        StringValue = bKeyInBuffer ? FStringView(Data + TokenStart + KeyOffset, KeyLen) : FStringView(UnescapedString);
+        Expect = EExpect::Value;
+        return EXVJsonToken::Key;
+    }
+
+    if (Char == TEXT(']') && Expect == EExpect::ValueOrArrayEnd)
+    {
+        ++Pos;
+        ContainerStack.Pop();
+        OnValueEnd();
+        return EXVJsonToken::ArrayEnd;
+    }
+
+    switch (Char)
+    {
+    case TEXT('['):
+        ++Pos;
+        ContainerStack.Push(false);
+        Expect = EExpect::ValueOrArrayEnd;
+        bRootParsed = true;
+        return EXVJsonToken::ArrayStart;
+
+    case TEXT('{'):
+        ++Pos;
+        ContainerStack.Push(true);
+        Expect = EExpect::KeyOrObjectEnd;
+        bRootParsed = true;
+        return EXVJsonToken::ObjectStart;
+
+    case TEXT('"'):
+        if (!ParseString())
+        {
+            return EXVJsonToken::Error;
+        }
+        OnValueEnd();
+        return EXVJsonToken::String;
+
+    case TEXT('t'):
+        if (!ParseLiteral(TEXT("true"), 4))
+        {
+            return EXVJsonToken::Error;
+        }
+        OnValueEnd();
+        return EXVJsonToken::True;
+
+    case TEXT('f'):
+        if (!ParseLiteral(TEXT("false"), 5))
+        {
+            return EXVJsonToken::Error;
+        }
+        OnValueEnd();
+        return EXVJsonToken::False;
+
+    case TEXT('n'):
+        if (!ParseLiteral(TEXT("null"), 4))
+        {
+            return EXVJsonToken::Error;
+        }
+        OnValueEnd();
+        return EXVJsonToken::Null;
+
+    default:
+        if (Char == TEXT('-') || FChar::IsDigit(Char))
+        {
+            if (!ParseNumber())
+            {
+                return EXVJsonToken::Error;
+            }
+            OnValueEnd();
+            return EXVJsonToken::Number;
+        }
+        return SetError(TEXT("无效的字符"));
+    }
+}
+
+double FXVJsonPullParser::GetNumber() const
+{
+    // Atod需要以0结尾的字符串
+    TCHAR Digits[64];
+    if (StringValue.Len() < UE_ARRAY_COUNT(Digits))
+    {
+        FMemory::Memcpy(Digits, StringValue.GetData(), StringValue.Len() * sizeof(TCHAR));
+        Digits[StringValue.Len()] = 0;
+        return FCString::Atod(Digits);
+    }
+    return FCString::Atod(*FString(StringValue));
+}
+
+bool FXVJsonPullParser::TryGetInt64(int64& OutValue) const
+{
+    const TCHAR* Text = StringValue.GetData();
+    const int32 Len = StringValue.Len();
+    const bool bNegative = Len > 0 && Text[0] == TEXT('-');
+    const int32 Start = bNegative ? 1 : 0;
+
+    // 18位以内的十进制整数不会溢出
+    if (Len == Start || Len - Start > 18)
+    {
+        return false;
+    }
+
+    int64 Value = 0;
+    for (int32 Index = Start; Index < Len; ++Index)
+    {
+        if (!FChar::IsDigit(Text[Index]))
+        {
+            return false;
+        }
+        Value = Value * 10 + (Text[Index] - TEXT('0'));
+    }
+    OutValue = bNegative ? -Value : Value;
+    return true;
+}
+
+float FXVJsonPullParser::GetProgress() const
+{
+    if (FileReader)
+    {
+        return FileReader->GetProgress();
+    }
+    return DataLen > 0 ? static_cast<float>(Pos) / DataLen : 1.0f;
+}
+
+bool FXVJsonPullParser::SkipValue(EXVJsonToken Token)
+{
+    if (Token == EXVJsonToken::Error)
+    {
+        return false;
+    }
+    if (Token != EXVJsonToken::ArrayStart && Token != EXVJsonToken::ObjectStart)
+    {
+        return true;
+    }
+
+    const int32 TargetDepth = GetDepth() - 1;
+    while (GetDepth() > TargetDepth)
+    {
+        if (Next() == EXVJsonToken::Error)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool FXVJsonPullParser::EnsureAvailable(int32 Count)
+{
+    while (Pos + Count > DataLen)
+    {
+        if (!FileReader || FileReader->IsEnd())
+        {
+            return false;
+        }
+
+        // 丢弃当前记号之前已经处理过的内容
+        if (TokenStart > 0)
+        {
+            Buffer.RemoveAt(0, TokenStart);
+            DiscardedChars += TokenStart;
+            Pos -= TokenStart;
+            TokenStart = 0;
+        }
+
+        if (!FileReader->ReadChunk(Buffer))
+        {
+            SetError(TEXT("读取文件失败"));
+            return false;
+        }
+        Data = Buffer.GetData();
+        DataLen = Buffer.Num();
+    }
+    return true;
+}
+
+bool FXVJsonPullParser::SkipWhitespace()
+{
+    while (true)
+    {
+        // 空白不属于任何记号，可以随时丢弃
+        TokenStart = Pos;
+        if (!EnsureAvailable(1))
+        {
+            return false;
+        }
+        while (Pos < DataLen && FChar::IsWhitespace(Data[Pos]))
+        {
+            ++Pos;
+        }
+        if (Pos < DataLen)
+        {
+            return true;
+        }
+    }
+}
+
+bool FXVJsonPullParser::ParseString()
+{
+    // TokenStart指向起始引号，内容的位置以相对TokenStart的偏移保存，读取新分块后仍然有效
+    const int32 ContentOffset = Pos + 1 - TokenStart;
+    ++Pos;
+
+    bool bHasEscape = false;
+    while (true)
+    {
+        if (!EnsureAvailable(1))
+        {
+            if (ErrorMessage.IsEmpty())
+            {
+                SetError(TEXT("字符串没有结束"));
+            }
+            return false;
+        }
+
+        // 按块查找引号和反斜杠
+        const int32 Count = FMath::Min(XVCsvScanner::BlockSize, DataLen - Pos);
+        const XVCsvScanner::FBlock Block(Data + Pos, Count);
+        const uint64 Mask = (Block.Match(TEXT('"')) | Block.Match(TEXT('\\'))) & XVCsvScanner::LowBitsMask(Count);
+        if (Mask == 0)
+        {
+            Pos += Count;
+            continue;
+        }
+
+        Pos += static_cast<int32>(FMath::CountTrailingZeros64(Mask));
+        if (Data[Pos] == TEXT('"'))
+        {
+            break;
+        }
+
+        // 反斜杠及其后的一个字符作为整体跳过，\uXXXX中的十六进制数字不会是引号或反斜杠
+        bHasEscape = true;
+        if (!EnsureAvailable(2))
+        {
+            if (ErrorMessage.IsEmpty())
+            {
+                SetError(TEXT("字符串没有结束"));
+            }
+            return false;
+        }
+        Pos += 2;
+    }
+
+    const TCHAR* Content = Data + TokenStart + ContentOffset;
+    const int32 ContentLen = Pos - (TokenStart + ContentOffset);
+    ++Pos;
+
+    bStringUnescaped = bHasEscape;
+    if (!bHasEscape)
+    {
+        StringValue = FStringView(Content, ContentLen);
+        return true;
+    }
+
+    UnescapedString.Reset(ContentLen);
+    for (int32 Index = 0; Index < ContentLen; ++Index)
+    {
+        TCHAR Char = Content[Index];
+        if (Char != TEXT('\\'))
+        {
+            UnescapedString.AppendChar(Char);
+            continue;
+        }
+
+        Char = Content[++Index];
+        switch (Char)
+        {
+        case TEXT('"'):
+        case TEXT('\\'):
+        case TEXT('/'):
+            UnescapedString.AppendChar(Char);
+            break;
+        case TEXT('b'):
+            UnescapedString.AppendChar(TEXT('\b'));
+            break;
+        case TEXT('f'):
+            UnescapedString.AppendChar(TEXT('\f'));
+            break;
+        case TEXT('n'):
+            UnescapedString.AppendChar(TEXT('\n'));
+            break;
+        case TEXT('r'):
+            UnescapedString.AppendChar(TEXT('\r'));
+            break;
+        case TEXT('t'):
+            UnescapedString.AppendChar(TEXT('\t'));
+            break;
+        case TEXT('u'):
+            {
+                if (Index + 4 >= ContentLen)
+                {
+                    SetError(TEXT("无效的\\u转义"));
+                    return false;
+                }
+                uint32 CodeUnit = 0;
+                for (int32 Digit = 1; Digit <= 4; ++Digit)
+                {
+                    const TCHAR Hex = Content[Index + Digit];
+                    if (!FChar::IsHexDigit(Hex))
+                    {
+                        SetError(TEXT("无效的\\u转义"));
+                        return false;
+                    }
+                    CodeUnit = (CodeUnit << 4) | FParse::HexDigit(Hex);
+                }
+                // TCHAR为UTF-16，代理对按两个码元依次追加即可
+                UnescapedString.AppendChar(static_cast<TCHAR>(CodeUnit));
+                Index += 4;
+            }
+            break;
+        default:
+            SetError(TEXT("无效的转义字符"));
+            return false;
+        }
+    }
+
+    StringValue = FStringView(UnescapedString);
+    return true;
+}
+
+bool FXVJsonPullParser::ParseNumber()
+{
+    while (EnsureAvailable(1))
+    {
+        const TCHAR Char = Data[Pos];
+        if (!FChar::IsDigit(Char) && Char != TEXT('-') && Char != TEXT('+') && Char != TEXT('.') && Char != TEXT('e') && Char != TEXT('E'))
+        {
+            break;
+        }
+        ++Pos;
+    }
+    if (!ErrorMessage.IsEmpty())
+    {
+        return false;
+    }
+
+    StringValue = FStringView(Data + TokenStart, Pos - TokenStart);
+    if (StringValue.Len() == 1 && StringValue[0] == TEXT('-'))
+    {
+        SetError(TEXT("无效的数字"));
+        return false;
+    }
+    return true;
+}
+
+bool FXVJsonPullParser::ParseLiteral(const TCHAR* Literal, int32 Len)
+{
+    if (!EnsureAvailable(Len) || FCString::Strncmp(Data + Pos, Literal, Len) != 0)
+    {
+        if (ErrorMessage.IsEmpty())
+        {
+            SetError(TEXT("无效的字面量"));
+        }
+        return false;
+    }
+    Pos += Len;
+    return true;
+}
+
+void FXVJsonPullParser::OnValueEnd()
+{
+    Expect = EExpect::CommaOrEnd;
+    bRootParsed = true;
+}
+
+EXVJsonToken FXVJsonPullParser::SetError(const TCHAR* Message)
+{
+    ErrorMessage = FString::Printf(TEXT("第%lld个字符处: %s"), DiscardedChars + Pos, Message);
+    return EXVJsonToken::Error;
+}
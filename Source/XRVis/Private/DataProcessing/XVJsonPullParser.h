@@ -0,0 +1,132 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FXVUtf8FileReader;
+
+/** JSON拉取式解析器返回的记号 */
+enum class EXVJsonToken : uint8
+{
+    ArrayStart,
+    ArrayEnd,
+    ObjectStart,
+    ObjectEnd,
+    /** 对象的键，冒号已被消费 */
+    Key,
+    String,
+    Number,
+    True,
+    False,
+    Null,
+    /** 文档结束 */
+    End,
+    /** 语法错误，错误信息见GetErrorMessage */
+    Error
+};
+
+/**
+ * 拉取式（SAX风格）JSON解析器
+ * 每次调用Next返回一个记号，不构建DOM；字符串在不含转义时直接以视图返回，不会为每个值分配内存。
+ * 从文件读取时按块解码，缓冲区只保留当前记号，内存占用与文件大小无关。
+ */
+class FXVJsonPullParser
+{
+public:
+    /** 解析内存中的文本，Text在解析期间必须保持有效 */
+    explicit FXVJsonPullParser(FStringView Text);
+
+    /** 从已打开的UTF-8文件中按块读取并解析 */
+    explicit FXVJsonPullParser(FXVUtf8FileReader& InFileReader);
+
+    /** 读取下一个记号，同时校验逗号、冒号和括号是否匹配 */
+    EXVJsonToken Next();
+
+    /** 当前Key/String记号的内容，在下一次调用Next前有效 */
+    FStringView GetString() const { return StringValue; }
+
+    /** 当前Number记号的原始文本，在下一次调用Next前有效 */
+    FStringView GetNumberText() const { return StringValue; }
+
+    /** 当前Number记号的数值 */
+    double GetNumber() const;
+
+    /** 当前Number记号为不超出范围的整数时返回true */
+    bool TryGetInt64(int64& OutValue) const;
+
+    /** 跳过以Token开始的值，数组和对象会跳过到匹配的结束符；遇到错误时返回false */
+    bool SkipValue(EXVJsonToken Token);
+
+    /** 已解析内容占全部内容的比例，文件模式下按已读取的字节数估算 */
+    float GetProgress() const;
+
+    /** 当前嵌套深度，顶层值之外为0 */
+    int32 GetDepth() const { return ContainerStack.Num(); }
+
+    /** 最后一次错误信息 */
+    const FString& GetErrorMessage() const { return ErrorMessage; }
+
+private:
+    /** 下一个记号之前期望的语法成分 */
+    enum class EExpect : uint8
+    {
+        Value,
+        ValueOrArrayEnd,
+        Key,
+        KeyOrObjectEnd,
+        CommaOrEnd
+    };
+
+    /** 确保从Pos开始至少有Count个字符可读，文件模式下会读取后续分块；到达结尾时返回false */
+    bool EnsureAvailable(int32 Count);
+
+    /** 跳过空白字符，返回是否还有内容 */
+    bool SkipWhitespace();
+
+    /** 解析以引号开始的字符串，结果写入StringValue */
+    bool ParseString();
+
+    /** 解析数字，原始文本写入StringValue */
+    bool ParseNumber();
+
+    /** 解析 true / false / null */
+    bool ParseLiteral(const TCHAR* Literal, int32 Len);
+
+    /** 一个值结束后更新期望的语法成分 */
+    void OnValueEnd();
+
+    EXVJsonToken SetError(const TCHAR* Message);
+
+    /** 文件模式下的读取器，为空表示内存模式 */
+    FXVUtf8FileReader* FileReader = nullptr;
+
+    /** 文件模式下的解码缓冲区 */
+    TArray<TCHAR> Buffer;
+
+    /** 当前可读的文本及读取位置 */
+    const TCHAR* Data = nullptr;
+    int32 DataLen = 0;
+    int32 Pos = 0;
+
+    /** 当前记号在Data中的起点，读取新分块时只保留此位置之后的内容 */
+    int32 TokenStart = 0;
+
+    /** 已经从缓冲区丢弃的字符数，用于错误信息中的位置 */
+    int64 DiscardedChars = 0;
+
+    /** 容器栈，true为对象，false为数组 */
+    TArray<bool> ContainerStack;
+
+    EExpect Expect = EExpect::Value;
+    bool bRootParsed = false;
+
+    /** 当前记号的文本，指向Data或UnescapedString */
+    FStringView StringValue;
+
+    /** 含转义字符的字符串解码后的内容 */
+    FString UnescapedString;
+
+    /** 最近一次解析的字符串是否含转义字符（内容在UnescapedString中） */
+    bool bStringUnescaped = false;
+
+    FString ErrorMessage;
+};
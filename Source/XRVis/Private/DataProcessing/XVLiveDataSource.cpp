@@ -0,0 +1,480 @@
+#include "DataProcessing/XVLiveDataSource.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/RunnableThread.h"
+#include "IPAddress.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+#if PLATFORM_WINDOWS
+#include "Windows/AllowWindowsPlatformTypes.h"
+#include <windows.h>
+#include "Windows/HideWindowsPlatformTypes.h"
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+#include <cerrno>
+#include <cstdlib>
+
+namespace
+{
+    /** 整个字段都是整数时解析成功，允许首尾空白 */
+    bool ParseIntField(const ANSICHAR* Field, int32& OutValue)
+    {
+        ANSICHAR* End = nullptr;
+        errno = 0;
+        const long Value = strtol(Field, &End, 10);
+        while (End != Field && FCharAnsi::IsWhitespace(*End))
+        {
+            ++End;
+        }
+        if (End == Field || *End != '\0' || errno == ERANGE || Value < MIN_int32 || Value > MAX_int32)
+        {
+            return false;
+        }
+        OutValue = static_cast<int32>(Value);
+        return true;
+    }
+
+    /** 整个字段都是浮点数时解析成功，允许首尾空白 */
+    bool ParseDoubleField(const ANSICHAR* Field, double& OutValue)
+    {
+        ANSICHAR* End = nullptr;
+        OutValue = strtod(Field, &End);
+        while (End != Field && FCharAnsi::IsWhitespace(*End))
+        {
+            ++End;
+        }
+        return End != Field && *End == '\0' && FMath::IsFinite(OutValue);
+    }
+
+    /** 解析以'\0'结尾的一行 Row,Col,Value[,Time]，字段数不符时返回false */
+    bool ParseSampleLine(ANSICHAR* Line, FXVLiveSample& OutSample)
+    {
+        ANSICHAR* Fields[4];
+        int32 NumFields = 0;
+        ANSICHAR* FieldStart = Line;
+        for (ANSICHAR* Cursor = Line;; ++Cursor)
+        {
+            if (*Cursor == ',' || *Cursor == '\0')
+            {
+                if (NumFields == UE_ARRAY_COUNT(Fields))
+                {
+                    return false;
+                }
+                const bool bEnd = *Cursor == '\0';
+                *Cursor = '\0';
+                Fields[NumFields++] = FieldStart;
+                if (bEnd)
+                {
+                    break;
+                }
+                FieldStart = Cursor + 1;
+            }
+        }
+
+        // 表头或任何字段不是完整数字的行被忽略，列字段不能为空；时间字段为空时视为不带时间
+        double Value = 0.0;
+        if (NumFields < 3 || !ParseIntField(Fields[0], OutSample.Row) || !ParseIntField(Fields[1], OutSample.Col) ||
+            !ParseDoubleField(Fields[2], Value))
+        {
+            return false;
+        }
+        OutSample.Value = static_cast<float>(Value);
+        OutSample.bHasTime = NumFields == 4 && *Fields[3] != '\0';
+        OutSample.Time = 0.0;
+        return !OutSample.bHasTime || ParseDoubleField(Fields[3], OutSample.Time);
+    }
+}
+
+FXVLineLiveDataSource::~FXVLineLiveDataSource()
+{
+    // 子类应在自己的析构函数中调用Stop，这里只是兜底
+    Stop();
+}
+
+bool FXVLineLiveDataSource::Start()
+{
+    if (Thread)
+    {
+        return true;
+    }
+
+    bStopRequested = false;
+    Thread = FRunnableThread::Create(this, *FString::Printf(TEXT("XVLiveData %s"), *GetDescription()), 0, TPri_BelowNormal);
+    return Thread != nullptr;
+}
+
+void FXVLineLiveDataSource::Stop()
+{
+    if (!Thread)
+    {
+        return;
+    }
+
+    bStopRequested = true;
+    Thread->WaitForCompletion();
+    delete Thread;
+    Thread = nullptr;
+}
+
+uint32 FXVLineLiveDataSource::Run()
+{
+    TArray<uint8> Buffer;
+    Buffer.SetNumUninitialized(64 * 1024);
+
+    bool bOpened = false;
+    while (!bStopRequested)
+    {
+        if (!bOpened)
+        {
+            bOpened = Open();
+            if (!bOpened)
+            {
+                // 分段等待，使Stop不必等待整个重试间隔
+                for (float Waited = 0.f; Waited < RetryInterval && !bStopRequested; Waited += 0.05f)
+                {
+                    FPlatformProcess::Sleep(0.05f);
+                }
+                continue;
+            }
+            Pending.Reset();
+            bDiscardingLine = false;
+        }
+
+        const int32 BytesRead = Read(Buffer.GetData(), Buffer.Num());
+        if (BytesRead < 0)
+        {
+            UE_LOG(LogTemp, Log, TEXT("Live data source disconnected: %s"), *GetDescription());
+            Close();
+            bOpened = false;
+            continue;
+        }
+        if (BytesRead == 0)
+        {
+            FPlatformProcess::Sleep(PollInterval);
+            continue;
+        }
+
+        Pending.Append(reinterpret_cast<const ANSICHAR*>(Buffer.GetData()), BytesRead);
+        ParseLines();
+    }
+
+    if (bOpened)
+    {
+        Close();
+    }
+    return 0;
+}
+
+void FXVLineLiveDataSource::ParseLines()
+{
+    // 跳过超长行的剩余部分
+    if (bDiscardingLine)
+    {
+        const int32 LineEnd = Pending.Find('\n');
+        if (LineEnd == INDEX_NONE)
+        {
+            Pending.Reset();
+            return;
+        }
+        Pending.RemoveAt(0, LineEnd + 1);
+        bDiscardingLine = false;
+    }
+
+    int32 LineStart = 0;
+    for (int32 Index = 0; Index < Pending.Num(); ++Index)
+    {
+        if (Pending[Index] != '\n')
+        {
+            continue;
+        }
+
+        Pending[Index] = '\0';
+        if (Index > LineStart && Pending[Index - 1] == '\r')
+        {
+            Pending[Index - 1] = '\0';
+        }
+
+        FXVLiveSample Sample;
+        if (ParseSampleLine(Pending.GetData() + LineStart, Sample))
+        {
+            Queue.Enqueue(Sample);
+        }
+        LineStart = Index + 1;
+    }
+
+    Pending.RemoveAt(0, LineStart);
+
+    if (Pending.Num() > MaxLineLength)
+    {
+        if (!bWarnedLongLine)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Live data source %s: line exceeds %d bytes without a newline and was dropped"),
+                   *GetDescription(), MaxLineLength);
+            bWarnedLongLine = true;
+        }
+        Pending.Reset();
+        bDiscardingLine = true;
+    }
+}
+
+FXVFileTailLiveDataSource::FXVFileTailLiveDataSource(const FString& InFilePath, bool bInStartAtEnd)
+    : FilePath(InFilePath)
+    , bStartAtEnd(bInStartAtEnd)
+{
+}
+
+FXVFileTailLiveDataSource::~FXVFileTailLiveDataSource()
+{
+    Stop();
+}
+
+FString FXVFileTailLiveDataSource::GetDescription() const
+{
+    return FString::Printf(TEXT("file %s"), *FilePath);
+}
+
+bool FXVFileTailLiveDataSource::Open()
+{
+    // 允许写入方继续写入文件
+    FileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath, true));
+    if (!FileHandle)
+    {
+        return false;
+    }
+
+    ReadPosition = bStartAtEnd ? FileHandle->Size() : 0;
+    bStartAtEnd = false;
+    return true;
+}
+
+int32 FXVFileTailLiveDataSource::Read(uint8* Buffer, int32 BufferSize)
+{
+    const int64 Size = FileHandle->Size();
+    if (Size < 0)
+    {
+        return -1;
+    }
+    if (Size < ReadPosition)
+    {
+        // 文件被截断或重写
+        ReadPosition = 0;
+    }
+
+    const int64 Available = Size - ReadPosition;
+    if (Available == 0)
+    {
+        return 0;
+    }
+
+    const int32 BytesToRead = static_cast<int32>(FMath::Min<int64>(Available, BufferSize));
+    if (!FileHandle->Seek(ReadPosition) || !FileHandle->Read(Buffer, BytesToRead))
+    {
+        return -1;
+    }
+    ReadPosition += BytesToRead;
+    return BytesToRead;
+}
+
+void FXVFileTailLiveDataSource::Close()
+{
+    FileHandle.Reset();
+}
+
+FXVNamedPipeLiveDataSource::FXVNamedPipeLiveDataSource(const FString& InPipeName)
+    : PipeName(InPipeName)
+{
+}
+
+FXVNamedPipeLiveDataSource::~FXVNamedPipeLiveDataSource()
+{
+    Stop();
+}
+
+FString FXVNamedPipeLiveDataSource::GetDescription() const
+{
+    return FString::Printf(TEXT("pipe %s"), *PipeName);
+}
+
+#if PLATFORM_WINDOWS
+
+bool FXVNamedPipeLiveDataSource::Open()
+{
+    const FString FullName = FString::Printf(TEXT("\\\\.\\pipe\\%s"), *PipeName);
+    HANDLE Handle = ::CreateFileW(*FullName, GENERIC_READ, 0, nullptr, OPEN_EXISTING, 0, nullptr);
+    if (Handle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    PipeHandle = Handle;
+    return true;
+}
+
+int32 FXVNamedPipeLiveDataSource::Read(uint8* Buffer, int32 BufferSize)
+{
+    // 先查询可读字节数，避免ReadFile阻塞工作线程
+    DWORD Available = 0;
+    if (!::PeekNamedPipe(PipeHandle, nullptr, 0, nullptr, &Available, nullptr))
+    {
+        return -1;
+    }
+    if (Available == 0)
+    {
+        return 0;
+    }
+
+    DWORD BytesRead = 0;
+    if (!::ReadFile(PipeHandle, Buffer, FMath::Min<DWORD>(Available, BufferSize), &BytesRead, nullptr))
+    {
+        return -1;
+    }
+    return static_cast<int32>(BytesRead);
+}
+
+void FXVNamedPipeLiveDataSource::Close()
+{
+    if (PipeHandle)
+    {
+        ::CloseHandle(PipeHandle);
+        PipeHandle = nullptr;
+    }
+}
+
+#else
+
+bool FXVNamedPipeLiveDataSource::Open()
+{
+    const FTCHARToUTF8 Path(*PipeName);
+    struct stat StatData;
+    if (stat(Path.Get(), &StatData) != 0)
+    {
+        return false;
+    }
+
+    bIsSocket = S_ISSOCK(StatData.st_mode);
+    if (bIsSocket)
+    {
+        sockaddr_un Address = {};
+        if (Path.Length() >= static_cast<int32>(sizeof(Address.sun_path)))
+        {
+            return false;
+        }
+        Address.sun_family = AF_UNIX;
+        FCStringAnsi::Strncpy(Address.sun_path, Path.Get(), sizeof(Address.sun_path));
+
+        PipeDescriptor = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (PipeDescriptor < 0)
+        {
+            return false;
+        }
+        if (connect(PipeDescriptor, reinterpret_cast<sockaddr*>(&Address), sizeof(Address)) != 0)
+        {
+            Close();
+            return false;
+        }
+        fcntl(PipeDescriptor, F_SETFL, fcntl(PipeDescriptor, F_GETFL) | O_NONBLOCK);
+    }
+    else
+    {
+        PipeDescriptor = open(Path.Get(), O_RDONLY | O_NONBLOCK);
+    }
+    return PipeDescriptor >= 0;
+}
+
+int32 FXVNamedPipeLiveDataSource::Read(uint8* Buffer, int32 BufferSize)
+{
+    const ssize_t BytesRead = read(PipeDescriptor, Buffer, BufferSize);
+    if (BytesRead > 0)
+    {
+        return static_cast<int32>(BytesRead);
+    }
+    if (BytesRead == 0)
+    {
+        // 套接字返回0表示对端已关闭；FIFO没有写入方时也返回0，此时继续等待新的写入方
+        return bIsSocket ? -1 : 0;
+    }
+    return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+}
+
+void FXVNamedPipeLiveDataSource::Close()
+{
+    if (PipeDescriptor >= 0)
+    {
+        close(PipeDescriptor);
+        PipeDescriptor = -1;
+    }
+}
+
+#endif
+
+FXVTcpLiveDataSource::FXVTcpLiveDataSource(int32 InPort)
+    : Port(InPort)
+{
+}
+
+FXVTcpLiveDataSource::~FXVTcpLiveDataSource()
+{
+    Stop();
+}
+
+FString FXVTcpLiveDataSource::GetDescription() const
+{
+    return FString::Printf(TEXT("tcp 127.0.0.1:%d"), Port);
+}
+
+bool FXVTcpLiveDataSource::Open()
+{
+    ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+    if (!SocketSubsystem)
+    {
+        return false;
+    }
+
+    const TSharedRef<FInternetAddr> Address = SocketSubsystem->CreateInternetAddr();
+    Address->SetLoopbackAddress();
+    Address->SetPort(Port);
+
+    Socket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("XRVis live data"), Address->GetProtocolType());
+    if (!Socket)
+    {
+        return false;
+    }
+    if (!Socket->Connect(*Address))
+    {
+        Close();
+        return false;
+    }
+    return true;
+}
+
+int32 FXVTcpLiveDataSource::Read(uint8* Buffer, int32 BufferSize)
+{
+    // 限时等待，使工作线程能及时响应Stop
+    if (!Socket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromMilliseconds(10)))
+    {
+        return Socket->GetConnectionState() == SCS_ConnectionError ? -1 : 0;
+    }
+
+    int32 BytesRead = 0;
+    if (!Socket->Recv(Buffer, BufferSize, BytesRead))
+    {
+        return -1;
+    }
+    // 可读但读不到数据表示对端已关闭连接
+    return BytesRead > 0 ? BytesRead : -1;
+}
+
+void FXVTcpLiveDataSource::Close()
+{
+    if (Socket)
+    {
+        Socket->Close();
+        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+        Socket = nullptr;
+    }
+}
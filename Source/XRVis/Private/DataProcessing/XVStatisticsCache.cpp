@@ -0,0 +1,276 @@
+#include "DataProcessing/XVStatisticsCache.h"
+#include <algorithm>
+
+void FXVStatisticsCache::Build(TConstArrayView<float> Values)
+{
+    Reset();
+    Count = Values.Num();
+    if (Count == 0)
+    {
+        return;
+    }
+
+    // 一次遍历统计总和、最小值和最大值及其出现次数
+    MinValue = Values[0];
+    MaxValue = Values[0];
+    for (const float Value : Values)
+    {
+        Sum += Value;
+        if (Value < MinValue)
+        {
+            MinValue = Value;
+            MinCount = 1;
+        }
+        else if (Value == MinValue)
+        {
+            ++MinCount;
+        }
+        if (Value > MaxValue)
+        {
+            MaxValue = Value;
+            MaxCount = 1;
+        }
+        else if (Value == MaxValue)
+        {
+            ++MaxCount;
+        }
+    }
+
+    // 按中位数位置划分后分别建堆，总体为O(n)
+    LowerCount = (Count + 1) / 2;
+    UpperCount = Count - LowerCount;
+    TArray<float> Sorted(Values.GetData(), Count);
+    std::nth_element(Sorted.GetData(), Sorted.GetData() + LowerCount - 1, Sorted.GetData() + Count);
+    LowerHeap.Append(Sorted.GetData(), LowerCount);
+    UpperHeap.Append(Sorted.GetData() + LowerCount, UpperCount);
+    LowerHeap.Heapify(TGreater<float>());
+    UpperHeap.Heapify(TLess<float>());
+}
+
+void FXVStatisticsCache::Reset()
+{
+    LowerHeap.Reset();
+    UpperHeap.Reset();
+    PendingRemovals.Reset();
+    NumPendingRemovals = 0;
+    LowerCount = 0;
+    UpperCount = 0;
+    Count = 0;
+    Sum = 0.0;
+    MinValue = 0.f;
+    MaxValue = 0.f;
+    MinCount = 0;
+    MaxCount = 0;
+}
+
+void FXVStatisticsCache::Add(float Value)
+{
+    if (Count == 0 || Value < MinValue)
+    {
+        MinValue = Value;
+        MinCount = 1;
+    }
+    else if (Value == MinValue)
+    {
+        ++MinCount;
+    }
+    if (Count == 0 || Value > MaxValue)
+    {
+        MaxValue = Value;
+        MaxCount = 1;
+    }
+    else if (Value == MaxValue)
+    {
+        ++MaxCount;
+    }
+
+    ++Count;
+    Sum += Value;
+
+    if (LowerCount == 0 || Value <= LowerHeap.HeapTop())
+    {
+        LowerHeap.HeapPush(Value, TGreater<float>());
+        ++LowerCount;
+    }
+    else
+    {
+        UpperHeap.HeapPush(Value, TLess<float>());
+        ++UpperCount;
+    }
+    Rebalance();
+}
+
+void FXVStatisticsCache::Remove(float Value)
+{
+    if (Count == 0)
+    {
+        return;
+    }
+    if (Count == 1)
+    {
+        Reset();
+        return;
+    }
+
+    --Count;
+    Sum -= Value;
+
+    ++PendingRemovals.FindOrAdd(Value);
+    ++NumPendingRemovals;
+
+    // 较大一半中的值都不小于LowerHeap的堆顶，因此不大于堆顶的值一定在较小的一半中
+    if (Value <= LowerHeap.HeapTop())
+    {
+        --LowerCount;
+        PruneHeap(LowerHeap, TGreater<float>());
+    }
+    else
+    {
+        --UpperCount;
+        PruneHeap(UpperHeap, TLess<float>());
+    }
+    Rebalance();
+
+    const bool bRemovedLastMin = Value == MinValue && --MinCount == 0;
+    const bool bRemovedLastMax = Value == MaxValue && --MaxCount == 0;
+    if (bRemovedLastMin || bRemovedLastMax)
+    {
+        RecomputeRange();
+    }
+
+    CompactIfNeeded();
+}
+
+void FXVStatisticsCache::Replace(float OldValue, float NewValue)
+{
+    if (OldValue == NewValue)
+    {
+        return;
+    }
+    // 先加入再移除，避免只有一个值时缓存被清空
+    Add(NewValue);
+    Remove(OldValue);
+}
+
+float FXVStatisticsCache::GetMedian() const
+{
+    if (Count == 0)
+    {
+        return 0.f;
+    }
+    if (Count % 2 == 1)
+    {
+        return LowerHeap.HeapTop();
+    }
+    return (LowerHeap.HeapTop() + UpperHeap.HeapTop()) / 2.0f;
+}
+
+template <typename PredicateType>
+void FXVStatisticsCache::PruneHeap(TArray<float>& Heap, const PredicateType& Predicate)
+{
+    while (Heap.Num() > 0)
+    {
+        int32* Pending = PendingRemovals.Find(Heap.HeapTop());
+        if (!Pending)
+        {
+            break;
+        }
+        if (--*Pending == 0)
+        {
+            PendingRemovals.Remove(Heap.HeapTop());
+        }
+        --NumPendingRemovals;
+        Heap.HeapPopDiscard(Predicate);
+    }
+}
+
+void FXVStatisticsCache::Rebalance()
+{
+    if (LowerCount > UpperCount + 1)
+    {
+        UpperHeap.HeapPush(LowerHeap.HeapTop(), TLess<float>());
+        LowerHeap.HeapPopDiscard(TGreater<float>());
+        --LowerCount;
+        ++UpperCount;
+        PruneHeap(LowerHeap, TGreater<float>());
+    }
+    else if (LowerCount < UpperCount)
+    {
+        LowerHeap.HeapPush(UpperHeap.HeapTop(), TGreater<float>());
+        UpperHeap.HeapPopDiscard(TLess<float>());
+        ++LowerCount;
+        --UpperCount;
+        PruneHeap(UpperHeap, TLess<float>());
+    }
+}
+
+void FXVStatisticsCache::RecomputeRange()
+{
+    // 跳过延迟删除的值，每个待删除的值只跳过对应的次数
+    TMap<float, int32> Skipped = PendingRemovals;
+    MinCount = 0;
+    MaxCount = 0;
+    auto Visit = [this, &Skipped](float Value)
+    {
+        if (int32* Pending = Skipped.Find(Value))
+        {
+            if (*Pending > 0)
+            {
+                --*Pending;
+                return;
+            }
+        }
+        if (MinCount == 0 || Value < MinValue)
+        {
+            MinValue = Value;
+            MinCount = 1;
+        }
+        else if (Value == MinValue)
+        {
+            ++MinCount;
+        }
+        if (MaxCount == 0 || Value > MaxValue)
+        {
+            MaxValue = Value;
+            MaxCount = 1;
+        }
+        else if (Value == MaxValue)
+        {
+            ++MaxCount;
+        }
+    };
+    for (const float Value : LowerHeap)
+    {
+        Visit(Value);
+    }
+    for (const float Value : UpperHeap)
+    {
+        Visit(Value);
+    }
+}
+
+void FXVStatisticsCache::CompactIfNeeded()
+{
+    if (NumPendingRemovals <= FMath::Max(1024, Count))
+    {
+        return;
+    }
+
+    TArray<float> Values;
+    Values.Reserve(Count);
+    TMap<float, int32> Skipped = MoveTemp(PendingRemovals);
+    for (const TArray<float>* Heap : {&LowerHeap, &UpperHeap})
+    {
+        for (const float Value : *Heap)
+        {
+            int32* Pending = Skipped.Find(Value);
+            if (Pending && *Pending > 0)
+            {
+                --*Pending;
+                continue;
+            }
+            Values.Add(Value);
+        }
+    }
+    Build(Values);
+}
@@ -0,0 +1,275 @@
+#include "DataProcessing/XVTimestampParser.h"
+
+namespace XVTimestampParserPrivate
+{
+    /** 解析出的各字段 */
+    struct FFields
+    {
+        int32 Year = 0;
+        int32 Month = 0;
+        int32 Day = 0;
+        int32 Hour = 0;
+        int32 Minute = 0;
+        int32 Second = 0;
+        int64 FractionTicks = 0;
+
+        /** 时区相对UTC的偏移 */
+        int64 OffsetTicks = 0;
+    };
+
+    bool IsDigit(TCHAR Char)
+    {
+        return Char >= TEXT('0') && Char <= TEXT('9');
+    }
+
+    /** 从Pos开始读取MinDigits到MaxDigits位数字，返回实际读取的位数，不足MinDigits时返回0 */
+    int32 ReadDigits(FStringView Text, int32& Pos, int32 MinDigits, int32 MaxDigits, int32& OutValue)
+    {
+        int32 NumDigits = 0;
+        OutValue = 0;
+        while (NumDigits < MaxDigits && Pos < Text.Len() && IsDigit(Text[Pos]))
+        {
+            OutValue = OutValue * 10 + (Text[Pos] - TEXT('0'));
+            ++Pos;
+            ++NumDigits;
+        }
+        return NumDigits >= MinDigits ? NumDigits : 0;
+    }
+
+    /** 读取固定位置上的两位数字 */
+    bool ReadTwoDigits(FStringView Text, int32 Pos, int32& OutValue)
+    {
+        if (!IsDigit(Text[Pos]) || !IsDigit(Text[Pos + 1]))
+        {
+            return false;
+        }
+        OutValue = (Text[Pos] - TEXT('0')) * 10 + (Text[Pos + 1] - TEXT('0'));
+        return true;
+    }
+
+    /** 读取小数秒，超过7位（100纳秒）的部分被忽略 */
+    int32 ReadFraction(FStringView Text, int32& Pos, int64& OutTicks)
+    {
+        int32 NumDigits = 0;
+        int64 Scale = ETimespan::TicksPerSecond;
+        OutTicks = 0;
+        while (Pos < Text.Len() && IsDigit(Text[Pos]))
+        {
+            Scale /= 10;
+            OutTicks += (Text[Pos] - TEXT('0')) * Scale;
+            ++Pos;
+            ++NumDigits;
+        }
+        return NumDigits;
+    }
+
+    /** 从Pos开始解析到结尾的时区后缀，返回后缀长度；没有后缀时返回0，格式错误时返回INDEX_NONE */
+    int32 ReadZone(FStringView Text, int32 Pos, int64& OutOffsetTicks)
+    {
+        OutOffsetTicks = 0;
+        const int32 Length = Text.Len() - Pos;
+        if (Length == 0)
+        {
+            return 0;
+        }
+        if (Length == 1 && (Text[Pos] == TEXT('Z') || Text[Pos] == TEXT('z')))
+        {
+            return 1;
+        }
+        if ((Length != 5 && Length != 6) || (Text[Pos] != TEXT('+') && Text[Pos] != TEXT('-')))
+        {
+            return INDEX_NONE;
+        }
+
+        int32 Hours;
+        int32 Minutes;
+        const int32 MinutePos = Length == 6 ? Pos + 4 : Pos + 3;
+        if (!ReadTwoDigits(Text, Pos + 1, Hours) || (Length == 6 && Text[Pos + 3] != TEXT(':')) || !ReadTwoDigits(Text, MinutePos, Minutes)
+            || Hours > 23 || Minutes > 59)
+        {
+            return INDEX_NONE;
+        }
+
+        OutOffsetTicks = Hours * ETimespan::TicksPerHour + Minutes * ETimespan::TicksPerMinute;
+        if (Text[Pos] == TEXT('-'))
+        {
+            OutOffsetTicks = -OutOffsetTicks;
+        }
+        return Length;
+    }
+
+    /** 校验各字段并换算为UTC的Ticks */
+    bool MakeTicks(const FFields& Fields, int64& OutTicks)
+    {
+        if (Fields.Year < 1 || Fields.Year > 9999 || Fields.Month < 1 || Fields.Month > 12
+            || Fields.Day < 1 || Fields.Day > FDateTime::DaysInMonth(Fields.Year, Fields.Month)
+            || Fields.Hour > 23 || Fields.Minute > 59 || Fields.Second > 59)
+        {
+            return false;
+        }
+
+        OutTicks = FDateTime(Fields.Year, Fields.Month, Fields.Day).GetTicks()
+            + Fields.Hour * ETimespan::TicksPerHour
+            + Fields.Minute * ETimespan::TicksPerMinute
+            + Fields.Second * ETimespan::TicksPerSecond
+            + Fields.FractionTicks
+            - Fields.OffsetTicks;
+        return true;
+    }
+}
+
+bool FXVTimestampParser::Parse(FStringView Text, int64& OutTicks)
+{
+    if (Format.Length > 0 && ParseFixed(Text, OutTicks))
+    {
+        return true;
+    }
+
+    FFormat SampleFormat;
+    if (!ParseGeneric(Text, OutTicks, SampleFormat))
+    {
+        return false;
+    }
+
+    // 只用第一个成功解析的值作为样本
+    if (!bDetected)
+    {
+        Format = SampleFormat;
+        bDetected = true;
+    }
+    return true;
+}
+
+void FXVTimestampParser::Reset()
+{
+    Format = FFormat();
+    bDetected = false;
+}
+
+bool FXVTimestampParser::TryParse(FStringView Text, int64& OutTicks)
+{
+    FFormat UnusedFormat;
+    return ParseGeneric(Text, OutTicks, UnusedFormat);
+}
+
+bool FXVTimestampParser::ParseGeneric(FStringView Text, int64& OutTicks, FFormat& OutFormat)
+{
+    using namespace XVTimestampParserPrivate;
+
+    // 年份固定4位，之后必须是日期分隔符
+    if (Text.Len() < 8 || (Text[4] != TEXT('-') && Text[4] != TEXT('/') && Text[4] != TEXT('.')))
+    {
+        return false;
+    }
+
+    FFields Fields;
+    int32 Pos = 0;
+    const TCHAR DateSeparator = Text[4];
+    if (!ReadDigits(Text, Pos, 4, 4, Fields.Year) || Text[Pos++] != DateSeparator)
+    {
+        return false;
+    }
+    const int32 MonthDigits = ReadDigits(Text, Pos, 1, 2, Fields.Month);
+    if (!MonthDigits || Pos >= Text.Len() || Text[Pos++] != DateSeparator)
+    {
+        return false;
+    }
+    const int32 DayDigits = ReadDigits(Text, Pos, 1, 2, Fields.Day);
+    if (!DayDigits)
+    {
+        return false;
+    }
+
+    FFormat TextFormat;
+    TextFormat.DateSeparator = DateSeparator;
+    bool bFixedWidth = MonthDigits == 2 && DayDigits == 2;
+
+    if (Pos < Text.Len() && (Text[Pos] == TEXT(' ') || Text[Pos] == TEXT('T')))
+    {
+        TextFormat.TimeSeparator = Text[Pos++];
+        const int32 HourDigits = ReadDigits(Text, Pos, 1, 2, Fields.Hour);
+        if (!HourDigits || Pos >= Text.Len() || Text[Pos++] != TEXT(':') || !ReadDigits(Text, Pos, 2, 2, Fields.Minute))
+        {
+            return false;
+        }
+        bFixedWidth &= HourDigits == 2;
+
+        if (Pos < Text.Len() && Text[Pos] == TEXT(':'))
+        {
+            ++Pos;
+            if (!ReadDigits(Text, Pos, 2, 2, Fields.Second))
+            {
+                return false;
+            }
+            TextFormat.bHasSeconds = true;
+
+            if (Pos < Text.Len() && Text[Pos] == TEXT('.'))
+            {
+                ++Pos;
+                TextFormat.FractionDigits = ReadFraction(Text, Pos, Fields.FractionTicks);
+                if (TextFormat.FractionDigits == 0)
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    TextFormat.ZoneLength = ReadZone(Text, Pos, Fields.OffsetTicks);
+    if (TextFormat.ZoneLength == INDEX_NONE || !MakeTicks(Fields, OutTicks))
+    {
+        return false;
+    }
+
+    TextFormat.Length = bFixedWidth ? Text.Len() : 0;
+    OutFormat = TextFormat;
+    return true;
+}
+
+bool FXVTimestampParser::ParseFixed(FStringView Text, int64& OutTicks) const
+{
+    using namespace XVTimestampParserPrivate;
+
+    if (Text.Len() != Format.Length || Text[4] != Format.DateSeparator || Text[7] != Format.DateSeparator)
+    {
+        return false;
+    }
+
+    // 各字段位于固定位置：YYYY?MM?DD?HH:MM:SS.fff
+    FFields Fields;
+    int32 Pos = 0;
+    if (!ReadDigits(Text, Pos, 4, 4, Fields.Year) || !ReadTwoDigits(Text, 5, Fields.Month) || !ReadTwoDigits(Text, 8, Fields.Day))
+    {
+        return false;
+    }
+
+    Pos = 10;
+    if (Format.TimeSeparator)
+    {
+        if (Text[10] != Format.TimeSeparator || Text[13] != TEXT(':') || !ReadTwoDigits(Text, 11, Fields.Hour) || !ReadTwoDigits(Text, 14, Fields.Minute))
+        {
+            return false;
+        }
+        Pos = 16;
+
+        if (Format.bHasSeconds)
+        {
+            if (Text[16] != TEXT(':') || !ReadTwoDigits(Text, 17, Fields.Second))
+            {
+                return false;
+            }
+            Pos = 19;
+
+            if (Format.FractionDigits > 0)
+            {
+                ++Pos;
+                if (Text[19] != TEXT('.') || ReadFraction(Text, Pos, Fields.FractionTicks) != Format.FractionDigits)
+                {
+                    return false;
+                }
+            }
+        }
+    }
+
+    return ReadZone(Text, Pos, Fields.OffsetTicks) == Format.ZoneLength && MakeTicks(Fields, OutTicks);
+}
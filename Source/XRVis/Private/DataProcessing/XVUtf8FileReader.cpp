@@ -0,0 +1,107 @@
+#include "XVUtf8FileReader.h"
+#include "HAL/PlatformFileManager.h"
+
+int32 XVUtf8::FindSafeLength(const uint8* Bytes, int32 Num)
+{
+    for (int32 Back = 1; Back <= 3 && Back <= Num; ++Back)
+    {
+        const uint8 Byte = Bytes[Num - Back];
+        if ((Byte & 0xC0) == 0x80)
+        {
+            // 后续字节，继续向前寻找起始字节
+            continue;
+        }
+
+        int32 SequenceLength = 1;
+        if ((Byte & 0xE0) == 0xC0)
+        {
+            SequenceLength = 2;
+        }
+        else if ((Byte & 0xF0) == 0xE0)
+        {
+            SequenceLength = 3;
+        }
+        else if ((Byte & 0xF8) == 0xF0)
+        {
+            SequenceLength = 4;
+        }
+        return SequenceLength > Back ? Num - Back : Num;
+    }
+    return Num;
+}
+
+bool FXVUtf8FileReader::Open(const FString& FilePath, int32 InChunkSize)
+{
+    FileHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenRead(*FilePath));
+    if (!FileHandle)
+    {
+        return false;
+    }
+
+    FileSize = FileHandle->Size();
+    RemainingBytes = FileSize;
+    ChunkSize = FMath::Max(InChunkSize, 4096);
+    CarriedBytes = 0;
+    bUtf16 = false;
+
+    // 预留3个字节用于保存上一块末尾被截断的UTF-8序列
+    Buffer.SetNumUninitialized(ChunkSize + 3);
+
+    // 先读取开头的字节检查BOM
+    const int32 HeadBytes = static_cast<int32>(FMath::Min<int64>(RemainingBytes, 3));
+    if (HeadBytes > 0)
+    {
+        if (!FileHandle->Read(Buffer.GetData(), HeadBytes))
+        {
+            return false;
+        }
+        RemainingBytes -= HeadBytes;
+        CarriedBytes = HeadBytes;
+
+        const uint8* Head = Buffer.GetData();
+        if (HeadBytes >= 2 && ((Head[0] == 0xFF && Head[1] == 0xFE) || (Head[0] == 0xFE && Head[1] == 0xFF)))
+        {
+            bUtf16 = true;
+        }
+        else if (HeadBytes == 3 && Head[0] == 0xEF && Head[1] == 0xBB && Head[2] == 0xBF)
+        {
+            // 跳过UTF-8 BOM
+            CarriedBytes = 0;
+        }
+    }
+    return true;
+}
+
+bool FXVUtf8FileReader::ReadChunk(TArray<TCHAR>& Out)
+{
+    if (!FileHandle)
+    {
+        return false;
+    }
+
+    const int32 BytesToRead = static_cast<int32>(FMath::Min<int64>(RemainingBytes, ChunkSize));
+    if (BytesToRead > 0)
+    {
+        if (!FileHandle->Read(Buffer.GetData() + CarriedBytes, BytesToRead))
+        {
+            return false;
+        }
+        RemainingBytes -= BytesToRead;
+    }
+
+    const int32 ChunkBytes = CarriedBytes + BytesToRead;
+    const int32 SafeBytes = RemainingBytes > 0 ? XVUtf8::FindSafeLength(Buffer.GetData(), ChunkBytes) : ChunkBytes;
+    if (SafeBytes > 0)
+    {
+        FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Buffer.GetData()), SafeBytes);
+        Out.Append(Converter.Get(), Converter.Length());
+    }
+
+    // 将未解码的尾部字节移动到缓冲区开头
+    CarriedBytes = ChunkBytes - SafeBytes;
+    if (CarriedBytes > 0)
+    {
+        FMemory::Memmove(Buffer.GetData(), Buffer.GetData() + SafeBytes, CarriedBytes);
+    }
+    return true;
+}
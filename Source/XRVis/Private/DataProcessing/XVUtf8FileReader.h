@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+
+namespace XVUtf8
+{
+    /** 返回缓冲区中可以安全解码的字节数，末尾被截断的UTF-8多字节序列留到下一块 */
+    int32 FindSafeLength(const uint8* Bytes, int32 Num);
+}
+
+/**
+ * 按固定大小分块读取UTF-8文本文件，并解码为TCHAR
+ * 自动跳过UTF-8 BOM，跨块截断的多字节序列会保留到下一块再解码
+ */
+class FXVUtf8FileReader
+{
+public:
+    /** 打开文件，ChunkSize为每次读取的字节数 */
+    bool Open(const FString& FilePath, int32 InChunkSize);
+
+    /** 文件是否以UTF-16 BOM开头，这种文件无法按UTF-8分块解码 */
+    bool IsUtf16() const { return bUtf16; }
+
+    /** 是否已经读完全部内容 */
+    bool IsEnd() const { return RemainingBytes <= 0 && CarriedBytes == 0; }
+
+    /** 文件总字节数 */
+    int64 GetFileSize() const { return FileSize; }
+
+    /** 已读取的字节数占文件大小的比例 */
+    float GetProgress() const { return FileSize > 0 ? static_cast<float>(FileSize - RemainingBytes) / FileSize : 1.0f; }
+
+    /** 读取下一块并解码，结果追加到Out末尾；读取出错时返回false */
+    bool ReadChunk(TArray<TCHAR>& Out);
+
+private:
+    TUniquePtr<IFileHandle> FileHandle;
+
+    /** 读取缓冲区，开头CarriedBytes个字节为上一块遗留的未解码字节 */
+    TArray<uint8> Buffer;
+
+    int32 ChunkSize = 0;
+    int32 CarriedBytes = 0;
+    int64 RemainingBytes = 0;
+    int64 FileSize = 0;
+    bool bUtf16 = false;
+};
@@ -58,7 +58,7 @@ void UXVDataVisWidget::OnLoadFileClicked()
             TEXT("选择数据文件"),
             DefaultPath,
             TEXT(""),
-            TEXT("文本文件|*.json|CSV文件|*.csv|所有文件|*.*"),
+            TEXT("文本文件|*.json|CSV文件|*.csv|二进制数据集|*.xvb|所有文件|*.*"),
             EFileDialogFlags::None,
             OutFilenames
         );
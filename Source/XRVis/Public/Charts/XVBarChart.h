@@ -4,10 +4,14 @@
 
 #include "CoreMinimal.h"
 #include "XVChartBase.h"
+#include "DataProcessing/XVDenseGrid.h"
+#include "DataProcessing/XVGridPyramid.h"
 #include "GameFramework/Actor.h"
 #include "XVBarChart.generated.h"
 
 class AXVChartAxis;
+class UInstancedStaticMeshComponent;
+class UStaticMesh;
 
 USTRUCT()
 struct FBarChartSectionInfo
@@ -39,6 +43,42 @@ enum class EHistogramChartStyle : uint8
 	Dynamic2
 };
 
+/* 柱状图的渲染方式 */
+UENUM(BlueprintType)
+enum class EBarChartRenderMode : uint8
+{
+	/* 每个柱体是ProceduralMesh的一个网格段，有独立的材质槽 */
+	ProceduralMesh,
+	/* 每级LOD一个实例化静态网格组件，柱体为单位立方体的实例，每级LOD只有一次绘制调用 */
+	Instanced
+};
+
+/* 实例化柱体的PerInstanceCustomData布局，InstancedMaterial按此读取 */
+namespace XVBarInstanceData
+{
+	/* 调整后的高度 */
+	constexpr int32 Height = 0;
+	/* 柱体颜色RGB，占3个值 */
+	constexpr int32 Color = 1;
+	/* 发光颜色RGB，占3个值 */
+	constexpr int32 EmissiveColor = 4;
+	/* 发光强度，悬停或高亮时不为0 */
+	constexpr int32 EmissiveIntensity = 7;
+	constexpr int32 NumFloats = 8;
+}
+
+/* LOD合并柱体的高度计算方式 */
+UENUM(BlueprintType)
+enum class EBarChartLODAggregation : uint8
+{
+	/* 块内有效单元格的平均值 */
+	Mean,
+	/* 块内有效单元格的最大值 */
+	Max,
+	/* 块内有效单元格的和 */
+	Sum
+};
+
 UCLASS(Blueprintable)
 class XRVIS_API AXVBarChart : public AXVChartBase
 {
@@ -83,10 +123,24 @@ public:
 	UPROPERTY(VisibleAnywhere, Category="Chart Property | Style")
 	EHistogramChartShape HistogramChartShape;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Chart Property | LOD", meta=(ToolTip="LOD合并柱体的高度计算方式"))
+	EBarChartLODAggregation LODAggregation = EBarChartLODAggregation::Mean;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Chart Property | Render", meta=(ToolTip="柱体的渲染方式，修改后需要重新生成网格"))
+	EBarChartRenderMode RenderMode = EBarChartRenderMode::ProceduralMesh;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Chart Property | Render", meta=(EditCondition="RenderMode == EBarChartRenderMode::Instanced", ToolTip="实例化模式使用的网格，需为以原点为中心、边长100的立方体"))
+	UStaticMesh* InstanceMesh;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category="Chart Property | Render", meta=(EditCondition="RenderMode == EBarChartRenderMode::Instanced", ToolTip="实例化模式使用的材质，通过PerInstanceCustomData读取高度、颜色和发光，布局见XVBarInstanceData"))
+	UMaterialInterface* InstancedMaterial;
+
 protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void OnDataLoadFinished(bool bSuccess) override;
+
 	UFUNCTION(BlueprintCallable)
 	void Create3DHistogramChart(const FString& Data,EHistogramChartStyle InHistogramChartStyle, EHistogramChartShape InHistogramChartShape);
 
@@ -111,11 +165,32 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Chart Property | Data")
 	virtual void SetValue(const FString& InValue) override;
 
+	virtual void SetValueFromGrid(const FXVChartGridData& GridData) override;
+
+	/**
+	 * 增量更新单元格的值：只标记受影响的柱体，在下一次Tick时重建这些柱体及包含它们的LOD合并柱体
+	 * 新增单元格、超出网格范围、超出当前最大值或使最大值变小的更新会立即触发一次完整重建
+	 * 注意：此方法不暴露给蓝图，蓝图请使用UpdateCellValues
+	 */
+	void UpdateValues(TConstArrayView<FXVCellUpdate> Updates);
+
+	/**
+	 * 增量更新单元格的值，见UpdateValues
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Chart Property | Data")
+	void UpdateCellValues(const TArray<FXVCellUpdate>& Updates);
+
 	virtual void GenerateAllMeshInfo() override;
 
 	virtual void DrawWithGPU() override;
 
 	virtual void GenerateLOD() override;
+
+	virtual void DrawMeshLOD(int LODLevel) override;
+
+	virtual void SetEnableReferenceHighlight(bool bEnable) override;
+
+	virtual void SetEnableValueTriggers(bool bEnable) override;
 	
 	/**
 	 * 应用参考值高亮到柱状图
@@ -143,8 +218,72 @@ public:
 	void CreateStatisticalLine(const FXVStatisticalLine& LineInfo);
 	
 private:
+	/* 计算从 (IndexOfY, IndexOfX) 开始的LOD合并柱体的原始高度，块内没有有效单元格时返回false */
+	bool ComputeMergedHeight(int32 LODIndex, int32 IndexOfY, int32 IndexOfX, float& OutRawHeight) const;
+
+	/* 生成一个柱体的几何数据并追加到OutSectionInfos[SectionIndex]，返回调整后的高度 */
+	float BuildBarSection(TArray<FXVChartSectionInfo>& OutSectionInfos, int32 SectionIndex, int32 LODIndex, int32 IndexOfY, int32 IndexOfX, float RawHeight);
+
+	/* 计算一个柱体实例的变换和自定义数据，发光为默认值，返回调整后的高度 */
+	float ComputeBarInstance(int32 LODIndex, int32 IndexOfY, int32 IndexOfX, float RawHeight, FTransform& OutTransform, TArrayView<float> OutCustomData) const;
+
+	/* 按原始高度相对最大值的比例选取柱体颜色 */
+	FColor GetBarColor(float RawHeight) const;
+
+	/* 是否使用实例化组件渲染 */
+	bool IsInstanced() const { return RenderMode == EBarChartRenderMode::Instanced && InstanceMesh && !bEnableGPU; }
+
+	/* 确保每级LOD都有一个实例化组件 */
+	void EnsureInstanceComponents();
+
+	/* 设置LOD0中一个柱体的发光颜色和强度，实例化模式写入自定义数据，合并网格段模式写入状态纹理，否则写入材质实例 */
+	void SetBarEmissive(int32 Index, const FLinearColor& Color, float Intensity);
+
+	/* 只设置LOD0中一个柱体的发光强度 */
+	void SetBarEmissiveIntensity(int32 Index, float Intensity);
+
+	/* 恢复所有柱体的默认发光 */
+	void ResetBarEmissive();
+
+	/* 按参考值更新一个柱体的发光效果 */
+	void UpdateReferenceHighlight(int32 Index, float RawValue);
+
+	/* 按触发条件更新一个柱体的发光效果 */
+	void UpdateValueTrigger(int32 Index, float RawValue);
+
+	/* 重建被标记的柱体并重新上传 */
+	void FlushDirtyCells();
+
+	/* 按新的数据完整重建图表并重新绘制 */
+	void RebuildFromGrid(const FXVChartGridData& GridData);
 	
-	TMap<int, TMap<int, float>> XYZs;
+	/* 按行优先顺序保存的柱体高度 */
+	FXVDenseGrid ValueGrid;
+
+	/* ValueGrid的求和面积表和最大值稀疏表，用于O(1)计算LOD合并柱体的高度 */
+	FXVGridPyramid ValuePyramid;
+
+	/* 每级LOD中每个合并块对应的柱体在该级中的序号，按块的行优先顺序排列，没有生成柱体的块为INDEX_NONE
+	 * 加上该级的LODOffset即为网格段下标；实例化模式下即为实例下标；合并网格段模式下整级LOD为一个网格段 */
+	TArray<TArray<int32>> LODSectionIndices;
+
+	/* 单元格在LOD0中对应的柱体序号，超出网格、缺失的单元格或尚未生成柱体时返回INDEX_NONE */
+	int32 GetCellBarIndex(int32 Row, int32 Col) const;
+
+	/* 合并网格段模式下每级LOD中各柱体的第一个顶点在网格段中的位置，按柱体序号索引 */
+	TArray<TArray<int32>> LODVertexStarts;
+
+	/* 实例化模式下每级LOD的实例化组件，只有当前LOD可见 */
+	UPROPERTY()
+	TArray<UInstancedStaticMeshComponent*> InstanceComponents;
+
+	/* 自上次重建后值被修改的单元格 */
+	TBitArray<> DirtyCells;
+
+	bool bHasDirtyCells = false;
+
+	/* 每个单元格在HeightValues中的下标，用于GPU模式下的增量更新 */
+	TArray<int32> HeightValueIndices;
 	
 	int MaxX, MinX, MaxY,MinY;
 	float MaxZ, MinZ;
@@ -5,10 +5,19 @@
 #include "ProceduralMeshComponent.h"
 #include "XVChartUtils.h"
 #include "DataProcessing/XVDataManager.h"
+#include "DataProcessing/XVStatisticsCache.h"
 #include "Rendering/XRVisGeometryRenderer.h"
+#include "Rendering/XRVisChartMeshComponent.h"
 #include "XVChartBase.generated.h"
 
 class FXRVisSceneViewExtension;
+class UTexture2D;
+
+/* 异步加载数据的进度（0~1） */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FXVOnDataLoadProgress, float, Progress);
+
+/* 异步加载数据完成，被取消的加载不会触发 */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FXVOnDataLoadCompleted, bool, bSuccess);
 
 UENUM(BlueprintType)
 enum EReferenceComparisonType
@@ -121,6 +130,14 @@ struct FXVChartPropertyMapping
 	/** 时间属性名称（时间轴播放） */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chart Property | Data Mapping", meta=(ToolTip="时间维度属性名称，用于时间轴播放功能"))
 	FString TimeProperty = "time";
+
+	/** 柱状图/折线图的聚合方式，不为None时按X/Y属性分组聚合Z属性，可以直接读取未经汇总的原始记录 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chart Property | Data Mapping", meta=(ToolTip="按X/Y分组聚合Z值的方式"))
+	EXVAggregation Aggregation = EXVAggregation::None;
+
+	/** 聚合方式为百分位数时使用的百分位（0-100） */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chart Property | Data Mapping", meta=(ClampMin="0", ClampMax="100", EditCondition="Aggregation==EXVAggregation::Percentile", EditConditionHides))
+	float AggregationPercentile = 50.0f;
 };
 
 // 添加值范围触发条件枚举
@@ -215,6 +232,22 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Chart Property | Data", meta=(ToolTip="是否自动加载数据"))
 	bool bAutoLoadData;
 
+	/* 自动加载数据时是否在后台线程读取，避免大文件阻塞游戏线程 */
+	UPROPERTY(EditAnywhere, Category = "Chart Property | Data", meta=(ToolTip="自动加载数据时是否在后台线程读取", EditCondition="bAutoLoadData"))
+	bool bLoadDataAsync = true;
+
+	/* 是否通过进程级的数据缓存读取文件，多个图表使用同一数据文件时只解析一次 */
+	UPROPERTY(EditAnywhere, Category = "Chart Property | Data", meta=(ToolTip="多个图表使用同一数据文件时共享解析结果"))
+	bool bUseDataCache = true;
+
+	/* 异步加载数据的进度 */
+	UPROPERTY(BlueprintAssignable, Category = "Chart Property | Data")
+	FXVOnDataLoadProgress OnDataLoadProgress;
+
+	/* 异步加载数据完成 */
+	UPROPERTY(BlueprintAssignable, Category = "Chart Property | Data")
+	FXVOnDataLoadCompleted OnDataLoadCompleted;
+
 	/* Z轴控制 */
 	UPROPERTY(EditAnywhere, Category = "Chart Property | Z-Axis", meta=(ToolTip="是否强制Z轴从0开始"))
 	bool bForceZeroBase = true;
@@ -268,6 +301,18 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Chart Property | LOD", meta=(ToolTip="LOD相机更新大小"))
 	TArray<float> LODSwitchSize;
 
+	/* 每级LOD的所有图元合并为一个网格段 */
+	UPROPERTY(EditAnywhere, Category = "Chart Property | Render", meta=(ToolTip="每级LOD的所有图元合并为一个网格段，悬停、高亮和触发颜色写入按图元索引的状态纹理，修改后需要重新生成网格"))
+	bool bMergeSections = false;
+
+	/* 合并网格段使用的材质 */
+	UPROPERTY(EditAnywhere, Category = "Chart Property | Render", meta=(EditCondition="bMergeSections", ToolTip="合并网格段使用的材质，用UV1采样SectionStateTexture：RGB为发光颜色，A为发光强度，A小于0表示隐藏"))
+	UMaterialInterface* MergedSectionMaterial = nullptr;
+
+	/* 使用图表网格组件代替程序化网格组件绘制网格段 */
+	UPROPERTY(EditAnywhere, Category = "Chart Property | Render", meta=(ToolTip="网格段以紧凑顶点格式上传到图表网格组件，不保留CPU副本，更新时只写入修改的顶点范围，碰撞使用网格段的包围盒，修改后需要重新生成网格"))
+	bool bUseChartMeshComponent = false;
+
 	/* 触发条件列表 */
 	UPROPERTY(EditAnywhere, Category = "Chart Property | Trigger Conditions", meta=(ToolTip="值触发条件列表"))
 	TArray<FValueTriggerCondition> ValueTriggerConditions;
@@ -313,7 +358,7 @@ public:
 	void PrepareMeshSections();
 
 	UFUNCTION(BlueprintCallable)
-	void DrawMeshLOD(int LODLevel);
+	virtual void DrawMeshLOD(int LODLevel);
 
 	virtual void SetValue(const FString& InValue);
 	virtual void SetStyle();
@@ -325,6 +370,19 @@ public:
 	virtual void DrawMeshSection(int SectionIndex, bool bCreateCollision = true);
 	virtual void UpdateMeshSection(int SectionIndex, bool bSRGBConversion = false);
 
+	/* 只更新网格段中从FirstVertex开始的NumVertices个顶点，使用程序化网格组件时更新整个网格段 */
+	void UpdateMeshSectionRange(int SectionIndex, int32 FirstVertex, int32 NumVertices, bool bSRGBConversion = false);
+
+	/* 清除绘制的网格段，不修改SectionInfos */
+	void ClearMeshSection(int SectionIndex);
+	void ClearAllMeshSections();
+
+	/* 是否使用图表网格组件绘制网格段 */
+	bool IsUsingChartMeshComponent() const { return bUseChartMeshComponent && !bEnableGPU; }
+
+	/* 绘制网格段的组件，网格段的材质设置在该组件上 */
+	UMeshComponent* GetSectionMeshComponent() const;
+
 
 	virtual void DrawWithGPU();
 
@@ -351,6 +409,19 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Chart Property | Data")
 	virtual bool LoadDataFromFile(const FString& FilePath);
 
+	/* 在后台线程读取文件并生成类型化数据，完成后在游戏线程上交给图表
+	 * 进度和结果通过OnDataLoadProgress和OnDataLoadCompleted通知，开始新的加载会取消仍在进行的加载 */
+	UFUNCTION(BlueprintCallable, Category = "Chart Property | Data")
+	virtual bool LoadDataFromFileAsync(const FString& FilePath);
+
+	/* 取消正在进行的异步加载，被取消的加载结果会被丢弃 */
+	UFUNCTION(BlueprintCallable, Category = "Chart Property | Data")
+	void CancelDataLoad();
+
+	/* 是否有正在进行的异步加载 */
+	UFUNCTION(BlueprintPure, Category = "Chart Property | Data")
+	bool IsLoadingData() const { return bIsLoadingData; }
+
 	UFUNCTION(BlueprintCallable, Category = "Chart Property | Data")
 	virtual bool LoadDataFromString(const FString& Content, const FString& FileExtension);
 
@@ -367,6 +438,10 @@ public:
 	// 从命名数据设置图表值（使用现有的PropertyMapping）
 	virtual void SetValueFromNamedData(const TArray<TSharedPtr<FJsonObject>>& NamedData);
 
+	// 从类型化数据设置图表值，数据转换器的结果可直接传入，无需经过JSON字符串
+	UFUNCTION(BlueprintCallable, Category = "Chart Property | Data")
+	virtual void SetValueFromGrid(const FXVChartGridData& GridData);
+
 	/**
 	 * 应用参考值高亮到图表
 	 */
@@ -577,14 +652,85 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	virtual void BackupVertices();
 
+	/* 应用依赖数据的效果（参考值高亮、触发条件、统计轴线） */
+	void ApplyDataDrivenEffects();
+
+	/* 获取统计缓存，缓存失效时由GetAllDataValues重建 */
+	const FXVStatisticsCache& GetStatistics() const;
+
+	/* 数据整体改变后调用，下一次读取统计值时重建缓存 */
+	void InvalidateStatistics() { bStatisticsValid = false; }
+
+	/* 单个值改变后调用，缓存有效时增量更新 */
+	void UpdateStatistics(float OldValue, float NewValue);
+
+	/* 异步加载结束后在游戏线程调用，成功时数据已经交给图表 */
+	virtual void OnDataLoadFinished(bool bSuccess);
+
 	/* 根据文件扩展名自动选择合适的加载方法 */
 	virtual bool LoadDataByFileExtension(const FString& FilePath);
 
 	/* 根据图表类型和属性映射转换数据为合适的格式 */
 	virtual FString FormatDataByChartType();
 
+	/* 根据图表类型和属性映射将已加载的数据转换为类型化数据 */
+	virtual bool FormatGridByChartType(FXVChartGridData& OutGrid);
+
+	/* 以下静态方法不访问图表状态，可以在后台线程调用 */
+
+	/* 使用指定的数据管理器按文件扩展名读取数据表 */
+	static bool LoadTableByFileExtension(UXVDataManager* DataManager, const FString& FilePath);
+
+	/* 按图表类型（类名）和属性映射将数据表转换为类型化数据 */
+	static bool FormatGridFromTable(const FString& ChartClassName, const FXVChartPropertyMapping& Mapping, const FXVDataTable& DataTable,
+	                                FXVChartGridData& OutGrid);
+
+	/* 读取文件并生成类型化数据
+	 * 使用缓存时通过数据缓存读取数据表再转换；否则JSON文件先尝试直接读取为图表数据，失败时读取为数据表再转换 */
+	static bool LoadGridFromFile(UXVDataManager* DataManager, const FString& FilePath, const FString& ChartClassName,
+	                             const FXVChartPropertyMapping& Mapping, bool bUseCache, FXVChartGridData& OutGrid);
+
+	/* 将 [[Y, X, Z(, Time)], ...] 形式的JSON数组解析为类型化数据，元素不足3个时返回false */
+	static bool ParseGridFromJsonArray(const TArray<TSharedPtr<FJsonValue>>& JsonArray, FXVChartGridData& OutGrid);
+
+	/* 以下方法用于合并网格段模式：每级LOD的图元（柱体或折线的数据点）写入同一个网格段，
+	 * 顶点的UV1指向状态纹理中该图元的纹素，改变图元颜色只修改纹理，不更新几何 */
+
+	/* 是否按合并网格段模式生成网格 */
+	bool IsMergingSections() const { return bMergeSections && !bEnableGPU; }
+
+	/* 当前网格是否以合并网格段模式生成 */
+	bool HasSectionStates() const { return SectionStateTexture != nullptr; }
+
+	/* 为NumIds个图元创建状态纹理和合并材质实例，未设置MergedSectionMaterial时使用FallbackMaterial
+	 * ID为NumIds的纹素保留给不参与交互的顶点，始终为默认状态 */
+	void InitSectionStates(int32 NumIds, UMaterialInterface* FallbackMaterial);
+
+	/* 释放状态纹理，按逐图元网格段生成时调用 */
+	void ReleaseSectionStates();
+
+	/* 设置一个图元的发光颜色和强度 */
+	void SetSectionState(int32 Id, const FLinearColor& Color, float Intensity);
+
+	/* 只设置一个图元的发光强度 */
+	void SetSectionStateIntensity(int32 Id, float Intensity);
+
+	/* 显示或隐藏一个图元，不改变其发光状态 */
+	void SetSectionStateVisible(int32 Id, bool bVisible);
+
+	/* 恢复所有图元的默认发光，不改变可见性 */
+	void ResetSectionStates();
+
+	/* 上传自上一次上传后修改过的纹理行，由Tick调用 */
+	void FlushSectionStates();
+
+	/* 将Section中从FirstVertex开始的顶点指向图元Id的纹素 */
+	void AssignSectionId(FXVChartSectionInfo& Section, int32 FirstVertex, int32 Id) const;
+
 public:
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
@@ -594,6 +740,10 @@ protected:
 	UPROPERTY(VisibleAnywhere, meta=(AllowPrivateAccess= true))
 	UProceduralMeshComponent* ProceduralMeshComponent;
 
+	/* 图表网格组件，bUseChartMeshComponent为true时绘制网格段 */
+	UPROPERTY(VisibleAnywhere, meta=(AllowPrivateAccess= true))
+	UXRVisChartMeshComponent* ChartMeshComponent;
+
 	/* 存储所有信息的数组 */
 	UPROPERTY(EditAnywhere, Category="Chart Property | Debugging", meta=(AllowPrivateAccess = true))
 	TArray<FXVChartSectionInfo> SectionInfos;
@@ -655,4 +805,43 @@ protected:
 	TSharedPtr<FXRVisSceneViewExtension, ESPMode::ThreadSafe> SceneViewExtension;
 	FXRVisGeometryGenerator* GeometryGenerator;
 	FXRVisGeometryRenderer* GeometryRenderer;
+
+	/* 合并网格段使用的材质实例，只在合并网格段模式下有效 */
+	UPROPERTY()
+	UMaterialInstanceDynamic* MergedSectionMaterialInstance = nullptr;
+
+private:
+	/* 合并网格段模式下按图元ID保存状态的纹理，每行SectionStateTextureWidth个纹素 */
+	UPROPERTY()
+	UTexture2D* SectionStateTexture = nullptr;
+
+	/* 各图元的发光颜色（RGB）和强度（A） */
+	TArray<FLinearColor> SectionStates;
+
+	/* 被隐藏的图元，上传时写入A为-1的纹素 */
+	TBitArray<> HiddenSectionIds;
+
+	int32 SectionStateTextureHeight = 0;
+
+	/* 待上传的纹理行范围，Begin大于End表示没有修改 */
+	int32 DirtyStateRowBegin = MAX_int32;
+	int32 DirtyStateRowEnd = INDEX_NONE;
+
+	/* 标记图元所在的纹理行需要上传 */
+	void MarkSectionStateDirty(int32 Id);
+
+	/* 在游戏线程上完成异步加载：交换数据管理器并把数据交给图表 */
+	void FinishDataLoad(UXVDataManager* LoadedManager, bool bSuccess, FXVChartGridData&& GridData);
+
+	/* 当前异步加载的取消标志 */
+	TSharedPtr<FThreadSafeBool, ESPMode::ThreadSafe> DataLoadCancelFlag;
+
+	/* 每次开始或取消加载时递增，用于丢弃过期的加载结果 */
+	int32 DataLoadGeneration = 0;
+
+	bool bIsLoadingData = false;
+
+	/* 统计缓存，由GetStatistics按需重建 */
+	mutable FXVStatisticsCache StatisticsCache;
+	mutable bool bStatisticsValid = false;
 };
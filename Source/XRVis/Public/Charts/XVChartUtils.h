@@ -27,6 +27,9 @@ struct FXVChartSectionInfo
 	TArray<FVector2D> UVs;
 	TArray<FProcMeshTangent> Tangents;
 	TArray<FLinearColor> VertexColors;
+
+	/* 合并网格段模式下顶点所属图元在状态纹理中的采样坐标，其他模式为空 */
+	TArray<FVector2D> UV1;
 };
 
 /**
@@ -50,6 +53,80 @@ struct FXVPlaneInfo
 	FVector FarBottomVertexPosition;
 };
 
+/**
+ * 网格段构建器
+ * 构造时按图元预先算好的顶点数和索引数一次性扩展网格段的各个数组，之后通过指针顺序写入，不再逐个追加
+ * 析构时检查写入的数量与预留的数量一致
+ */
+class XRVIS_API FXVMeshBuilder
+{
+public:
+	/* 三角形不共用顶点，顶点数与索引数相同 */
+	static constexpr int32 NumTriangleVertices = 3;
+	static constexpr int32 NumQuadVertices = 2 * NumTriangleVertices;
+	static constexpr int32 NumBoxVertices = 6 * NumQuadVertices;
+
+	/**
+	 * 计算球体的顶点数和索引数，切片和堆栈数按CreateSphere的规则取最小值
+	 */
+	static void GetSphereCounts(int32 NumSphereSlices, int32 NumSphereStacks, int32& OutNumVertices, int32& OutNumIndices);
+
+	FXVMeshBuilder(FXVChartSectionInfo& InSection, int32 InNumVertices, int32 InNumIndices);
+	~FXVMeshBuilder();
+
+	FXVMeshBuilder(const FXVMeshBuilder&) = delete;
+	FXVMeshBuilder& operator=(const FXVMeshBuilder&) = delete;
+
+	/**
+	 * 添加三角形，UV限制在0到1之间
+	 */
+	void AddTriangle(const FVector& InFirstPoint, const FVector& InSecondPoint, const FVector& InThirdPoint,
+	                 const FVector& InFirstNormal, const FVector& InSecondNormal, const FVector& InThirdNormal,
+	                 const FVector2D& InFirstUV, const FVector2D& InSecondUV, const FVector2D& InThirdUV,
+	                 const FProcMeshTangent& Tangent, const FColor& TriangleColor);
+
+	/**
+	 * 添加平面，拆分为两个三角形
+	 */
+	void AddQuad(const FVector& InFirstPoint, const FVector& InSecondPoint, const FVector& InThirdPoint, const FVector& InFouthPoint,
+	             const FVector& InQuadNormal,
+	             const FVector2D& InFirstUV, const FVector2D& InSecondUV, const FVector2D& InThirdUV, const FVector2D& InFouthUV,
+	             const FProcMeshTangent& Tangent, const FColor& TriangleColor);
+
+	/**
+	 * 添加长方体，顶面从InHeight过渡到InNextHeight
+	 */
+	void AddBox(const FVector& InPosition, float InLength, float InWidth, float InHeight, float InNextHeight, const FColor& InColor);
+
+	/**
+	 * 添加球体
+	 */
+	void AddSphere(const FVector& InPosition, float SphereRadius, int32 NumSphereSlices, int32 NumSphereStacks, const FColor& InColor);
+
+private:
+	/* 写入一个顶点的所有属性，返回其在网格段中的索引 */
+	int32 WriteVertex(const FVector& Position, const FVector& Normal, const FVector2D& UV, const FProcMeshTangent& Tangent, const FLinearColor& Color);
+
+	void WriteIndex(int32 Index);
+
+	FXVChartSectionInfo& Section;
+
+	/* 构造前网格段中已有的顶点数 */
+	int32 FirstVertex;
+
+	int32 NumVertices;
+	int32 NumIndices;
+	int32 NumWrittenVertices = 0;
+	int32 NumWrittenIndices = 0;
+
+	FVector* Vertices;
+	FVector* Normals;
+	FVector2D* UVs;
+	FProcMeshTangent* Tangents;
+	FLinearColor* VertexColors;
+	int32* Indices;
+};
+
 /**
  * 图表工具类
  */
@@ -114,6 +191,12 @@ public:
 						  const int& SectionIndex, const FVector& InPosition,
 						  const float& SphereRadius, const int& NumSphereSlices, const int& NumSphereStacks, const FColor& InColor);
 
+	/**
+	 * 把各部分的网格数据按顺序拼接为一个网格段，索引偏移到拼接后的位置
+	 * 先计算各部分的起点，再并行复制；OutVertexStarts不为空时返回各部分第一个顶点的位置
+	 */
+	static void MergeSectionInfos(TConstArrayView<FXVChartSectionInfo> Parts, FXVChartSectionInfo& OutMerged, TArray<int32>* OutVertexStarts = nullptr);
+
 	/**
 	 * 创建文本渲染组件
 	 */
@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "XVChartBase.h"
+#include "DataProcessing/XVDenseGrid.h"
+#include "DataProcessing/XVRingBuffer.h"
 #include "GameFramework/Actor.h"
 #include "XVLineChart.generated.h"
 
@@ -24,8 +26,8 @@ struct FXVTimeDataPoint
 	// 数据值
 	float Value;
 	
-	// 实际时间值（从数据中解析）
-	float TimeValue;
+	// 实际时间值（从数据中解析，时间戳为Unix秒）
+	double TimeValue;
 	
 	// 用于排序的键值
 	int32 SortKey;
@@ -40,6 +42,20 @@ enum class ELineChartStyle : uint8
 	Point
 };
 
+/**
+ * 折线图较粗LOD的降采样方法
+ */
+UENUM()
+enum class ELineChartLODMethod : uint8
+{
+	/* 按固定步长抽取，第N级LOD每N+1列取一个点 */
+	Stride,
+	/* 最大三角形三桶法，保持折线的整体形状 */
+	LTTB,
+	/* 每个桶保留最小值和最大值，峰值和尖刺一定不会丢失 */
+	MinMax
+};
+
 UCLASS()
 class XRVIS_API AXVLineChart : public AXVChartBase
 {
@@ -56,6 +72,8 @@ public:
 
 	virtual void SetValue(const FString& InValue) override;
 
+	virtual void SetValueFromGrid(const FXVChartGridData& GridData) override;
+
 	virtual void ConstructMesh(double Rate = 1) override;
 
 	virtual void GenerateAllMeshInfo() override;
@@ -99,7 +117,7 @@ public:
 	void CreateStatisticalLine(const FXVStatisticalLine& LineInfo);
 	
 	/**
-	 * 根据时间轴进度更新折线图
+	 * 根据时间轴进度更新折线图，只显示或隐藏与上一次进度之间变化的数据点
 	 * @param Progress - 时间轴进度，范围0-1
 	 */
 	void UpdateMeshBasedOnTimeProgress(double Progress);
@@ -109,6 +127,21 @@ public:
 	 * @param NamedData - 命名属性数据数组
 	 */
 	void ParseNamedDataWithTime(const TArray<TSharedPtr<FJsonObject>>& NamedData);
+
+	/**
+	 * 流式追加一条序列的采样点
+	 * 每条序列保存最近StreamingCapacity个采样点，超出后最旧的采样点被覆盖；
+	 * 每个新采样点只重建一个线段并平移流式网格，不会重建整个图表
+	 * @param Series - 序列索引，对应Y轴上的一行
+	 * @param Timestamps - 采样时间（秒），同一序列内应单调递增
+	 * @param Values - 采样值，数量需与Timestamps相同
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Chart Property | Streaming")
+	void AppendSamples(int32 Series, const TArray<double>& Timestamps, const TArray<float>& Values);
+
+	/** 清空所有流式序列及其网格 */
+	UFUNCTION(BlueprintCallable, Category = "Chart Property | Streaming")
+	void ResetStreaming();
 	
 protected:
 	// Called when the game starts or when spawned
@@ -170,6 +203,22 @@ public:
 	UPROPERTY(EditAnywhere, Category = "Chart Property | Style")
 	ELineChartStyle LineChartStyle;
 
+	/** 生成较粗LOD时的降采样方法 */
+	UPROPERTY(EditAnywhere, Category = "Chart Property | LOD")
+	ELineChartLODMethod LODMethod;
+
+	/** 相邻两级LOD之间点数的缩减比例，第N级LOD保留约 点数/比例^N 个点 */
+	UPROPERTY(EditAnywhere, Category = "Chart Property | LOD", meta=(ClampMin="1.1", EditCondition="LODMethod!=ELineChartLODMethod::Stride"))
+	float LODReductionFactor;
+
+	/** 流式模式下每条序列保留的采样点数，修改后下一次追加时清空已有序列 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chart Property | Streaming", meta=(ClampMin="2"))
+	int32 StreamingCapacity;
+
+	/** 流式模式下每秒对应的X轴长度 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Chart Property | Streaming", meta=(ClampMin="0.001"))
+	float StreamingTimeScale;
+
 private:
 
 	UPROPERTY(VisibleDefaultsOnly,Category = "Chart Property | Material", meta=(AllowPrivateAccess = true))
@@ -180,9 +229,15 @@ private:
 	TArray<bool> LineSelection;
 	TArray<bool> TotalSelection;
 	
-	TMap<int, TMap<int, int>> XYZs;
+	/* 按行优先顺序保存的数据点，值按整数保存 */
+	FXVDenseGrid ValueGrid;
+
+	/* 按降采样方法计算每级LOD中每条折线保留的列号，各条折线并行计算 */
+	void BuildLODColumns();
+
+	/* 每级LOD中每条折线保留的列号，按[LOD][行]索引 */
+	TArray<TArray<TArray<int32>>> LODColumns;
 	int MaxX, MinX, MaxY,MinY, MaxZ, MinZ;
-	int CurColCount;
 	int RowCounts, ColCounts;
 
 	int HoveredIndex = -1;
@@ -196,5 +251,75 @@ private:
 	
 	// 时间轴数据
 	TArray<FXVTimeDataPoint> TimeData;
+
+	/* LOD0中每个单元格对应的网格段，缺失的单元格为INDEX_NONE，较粗的LOD共用该单元格的材质实例 */
+	TArray<int32> CellSections;
+
+	/* 单元格在LOD0中对应的网格段，超出网格或缺失的单元格返回INDEX_NONE */
+	int32 GetCellSection(int32 Row, int32 Col) const;
+
+	/* 由TimeData建立时间轴索引 */
+	void BuildTimelineIndex();
+
+	/* 显示或隐藏时间轴上的一个LOD0网格段 */
+	void SetTimelineSectionVisible(int32 SectionIndex, bool bVisible);
+
+	/* 设置LOD0中一个数据点的发光颜色和强度，合并网格段模式写入状态纹理，否则写入材质实例 */
+	void SetPointEmissive(int32 Index, const FLinearColor& Color, float Intensity);
+
+	/* 只设置LOD0中一个数据点的发光强度 */
+	void SetPointEmissiveIntensity(int32 Index, float Intensity);
+
+	/* 按首次出现的时间排序的LOD0网格段，时间轴进度对应其中的一个前缀 */
+	TArray<int32> TimelineSections;
+
+	/* TimelineSections中各网格段首次出现的时间，单调不减，用于二分查找进度对应的前缀 */
+	TArray<double> TimelineTimes;
+
+	/* 当前已显示的TimelineSections前缀长度，INDEX_NONE表示下一次需要完整同步 */
+	int32 TimelineVisibleCount = INDEX_NONE;
+
+	/* 流式模式的一个采样点 */
+	struct FStreamSample
+	{
+		double Time;
+		float Value;
+	};
+
+	/* 流式模式下的一条序列，线段与其起点采样点共用存储位置 */
+	struct FStreamSeries
+	{
+		TXVRingBuffer<FStreamSample> Samples;
+
+		/* 各存储位置上的线段是否已经创建过网格段 */
+		TBitArray<> CreatedSegments;
+	};
+
+	/* 确保序列及流式网格组件存在 */
+	void EnsureStreamSeries(int32 Series);
+
+	/* 追加一个采样点：隐藏被覆盖的最旧线段，并在新线段的位置重建一个网格段 */
+	void AppendStreamSample(int32 Series, double Time, float Value);
+
+	/* 以存储位置StartSlot上的采样点为起点重建一个线段 */
+	void WriteStreamSegment(int32 Series, int32 StartSlot);
+
+	/* 平移流式网格，使最旧的采样点对齐到原点；坐标过大时重新选取时间原点 */
+	void UpdateStreamScroll();
+
+	int32 GetStreamSectionIndex(int32 Series, int32 Slot) const { return Series * StreamingCapacity + Slot; }
+
+	TArray<FStreamSeries> StreamSeries;
+
+	/* 流式序列使用独立的网格组件，滚动时只修改其相对位置 */
+	UPROPERTY()
+	UProceduralMeshComponent* StreamMeshComponent = nullptr;
+
+	/* 流式网格X坐标对应的时间原点 */
+	double StreamTimeOrigin = 0;
+	bool bHasStreamTimeOrigin = false;
+
+	/* 生成单个线段时复用的网格数据 */
+	TArray<FXVChartSectionInfo> StreamSectionScratch;
 	
 };
@@ -0,0 +1,83 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "DataProcessing/XVChartData.h"
+#include "DataProcessing/XVLiveDataSource.h"
+#include "XVLiveDataComponent.generated.h"
+
+/**
+ * 将实时数据源接入所属图表的组件
+ * 数据源在各自的工作线程上读取数据，组件每帧在游戏线程上取出所有更新并合并：
+ * 同一单元格在一帧内的多次更新只保留最后一次；同一序列的采样点全部保留，每帧一次性追加，因此高频数据源每帧最多触发一次图表更新。
+ * 单元格更新交给柱状图的UpdateValues，序列采样交给折线图的AppendSamples。
+ */
+UCLASS(ClassGroup = (XRVis), meta = (BlueprintSpawnableComponent))
+class XRVIS_API UXVLiveDataComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UXVLiveDataComponent();
+
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+	/**
+	 * 添加数据源并启动其工作线程
+	 * 注意：此方法不暴露给蓝图
+	 */
+	void AddSource(TUniquePtr<IXVLiveDataSource> Source);
+
+	/** 跟踪只追加写入的文本文件 */
+	UFUNCTION(BlueprintCallable, Category = "Chart Property | Live Data")
+	void AddFileTailSource(const FString& FilePath, bool bStartAtEnd = true);
+
+	/** 读取本地命名管道，非Windows平台上PipeName为FIFO或Unix域套接字的路径 */
+	UFUNCTION(BlueprintCallable, Category = "Chart Property | Live Data")
+	void AddNamedPipeSource(const FString& PipeName);
+
+	/** 连接本机回环地址上的TCP服务 */
+	UFUNCTION(BlueprintCallable, Category = "Chart Property | Live Data")
+	void AddTcpSource(int32 Port);
+
+	/** 停止并移除所有数据源，尚未应用的更新被丢弃 */
+	UFUNCTION(BlueprintCallable, Category = "Chart Property | Live Data")
+	void RemoveAllSources();
+
+	UFUNCTION(BlueprintCallable, Category = "Chart Property | Live Data")
+	int32 GetNumSources() const { return Sources.Num(); }
+
+private:
+	/* 取出所有数据源的更新并按单元格和序列合并 */
+	void DrainSources();
+
+	/* 将合并后的更新应用到所属图表 */
+	void ApplyPendingUpdates();
+
+	TArray<TUniquePtr<IXVLiveDataSource>> Sources;
+
+	/* 一帧内合并后的单元格更新，键为行列组合 */
+	TMap<uint64, float> PendingCells;
+
+	/* 一帧内某条序列的所有采样点 */
+	struct FPendingSeries
+	{
+		TArray<double> Times;
+		TArray<float> Values;
+	};
+
+	/* 一帧内按序列收集的采样点，应用后只清空数组，保留各序列的容量 */
+	TMap<int32, FPendingSeries> PendingSeries;
+
+	/* PendingSeries中尚未应用的采样点数量 */
+	int32 NumPendingSamples = 0;
+
+	/* 应用单元格更新时复用的数组 */
+	TArray<FXVCellUpdate> CellUpdates;
+
+	bool bWarnedUnsupportedOwner = false;
+};
@@ -129,6 +129,11 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void Set3DPieChart(EPieChartStyle ChartStyle, const TArray<FColor>& PieChartColor, EPieShape Shape);
 
+	/**
+	 * 从类型化数据创建饼状图，XLabels为类别名称，使用当前的样式、颜色和形状。
+	 */
+	virtual void SetValueFromGrid(const FXVChartGridData& GridData) override;
+
 	/**
 	 * 修改区块颜色
 	 */
@@ -0,0 +1,34 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "DataProcessing/XVDataReader.h"
+#include "DataProcessing/XVBinaryDataset.h"
+#include "XVBinaryDataReader.generated.h"
+
+/**
+ * 用于读取二进制图表数据集（.xvb）的读取器
+ * 文件以内存映射方式打开，数据块整体复制到数据表，不解析文本
+ */
+UCLASS(BlueprintType)
+class XRVIS_API UXVBinaryDataReader : public UXVDataReader
+{
+    GENERATED_BODY()
+
+public:
+    /** 从二进制文件读取数据 */
+    virtual bool ReadFromFile(const FString& FilePath) override;
+
+    /** 二进制数据集不支持从字符串读取 */
+    virtual bool ReadFromString(const FString& Content) override;
+
+    /** 将数据表写入二进制文件 */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data|Binary")
+    bool WriteToFile(const FXVDataTable& InDataTable, const FString& FilePath);
+
+    /** 最近一次打开的数据集，其数据视图直接指向映射的内存，可在不复制的情况下读取
+     * 注意：此方法不暴露给蓝图 */
+    const FXVBinaryDataset& GetDataset() const { return Dataset; }
+
+private:
+    FXVBinaryDataset Dataset;
+};
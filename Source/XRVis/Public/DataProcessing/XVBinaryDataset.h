@@ -0,0 +1,99 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "DataProcessing/XVDataTable.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+/**
+ * 二进制图表数据集（.xvb）
+ * 文件由文件头、列描述表和按8字节对齐的数据块组成，所有数值均为小端序：
+ *   文件头   - 魔数、版本、列数、行数
+ *   列描述   - 列类型，以及列名、有效性位图、值数组、字典、字典数值各数据块的偏移
+ *   数据块   - 有效性位图(uint32)、与列类型对应的值数组(int64/double/int32编码)、
+ *              字符串字典(各项字节长度 + UTF-8内容)、字典数值(double)
+ * 读取时通过内存映射直接访问各数据块，不需要解析文本
+ */
+class XRVIS_API FXVBinaryDataset
+{
+public:
+    FXVBinaryDataset();
+    ~FXVBinaryDataset();
+
+    FXVBinaryDataset(const FXVBinaryDataset&) = delete;
+    FXVBinaryDataset& operator=(const FXVBinaryDataset&) = delete;
+
+    /** 二进制数据集的文件扩展名（不含点） */
+    static const TCHAR* FileExtension;
+
+    /** 将数据表写入二进制文件 */
+    static bool Write(const FXVDataTable& DataTable, const FString& FilePath, FString& OutError);
+
+    /** 以内存映射方式打开二进制文件并校验结构，平台不支持映射时整体读入内存 */
+    bool Open(const FString& FilePath, FString& OutError);
+
+    /** 关闭文件，之前获取的数据视图全部失效 */
+    void Close();
+
+    bool IsOpen() const { return Data != nullptr; }
+
+    int32 GetRowCount() const { return RowCount; }
+
+    int32 GetColumnCount() const { return Columns.Num(); }
+
+    const FString& GetColumnName(int32 ColumnIndex) const { return Columns[ColumnIndex].Name; }
+
+    EXVColumnType GetColumnType(int32 ColumnIndex) const { return Columns[ColumnIndex].Type; }
+
+    /** 以下数据视图直接指向映射的内存，在Close之前有效 */
+
+    /** 有效性位图，共GetRowCount()位 */
+    const uint32* GetValidityWords(int32 ColumnIndex) const { return Columns[ColumnIndex].ValidityWords; }
+
+    /** 整数列的值，时间戳列中为Ticks */
+    TConstArrayView<int64> GetInt64Values(int32 ColumnIndex) const { return Columns[ColumnIndex].Int64Values; }
+
+    /** 浮点列的值 */
+    TConstArrayView<double> GetDoubleValues(int32 ColumnIndex) const { return Columns[ColumnIndex].DoubleValues; }
+
+    /** 字符串列的字典编码，空单元格为INDEX_NONE */
+    TConstArrayView<int32> GetStringCodes(int32 ColumnIndex) const { return Columns[ColumnIndex].StringCodes; }
+
+    /** 字符串列的字典，打开文件时解码 */
+    TConstArrayView<FString> GetDictionary(int32 ColumnIndex) const { return Columns[ColumnIndex].Dictionary; }
+
+    /** 字典项的数值 */
+    TConstArrayView<double> GetDictionaryNumbers(int32 ColumnIndex) const { return Columns[ColumnIndex].DictionaryNumbers; }
+
+    /** 将数据集复制到数据表，每个数据块整体复制，各列并行处理 */
+    void CopyToDataTable(FXVDataTable& OutTable) const;
+
+private:
+    struct FColumnView
+    {
+        FString Name;
+        EXVColumnType Type = EXVColumnType::Empty;
+        const uint32* ValidityWords = nullptr;
+        TConstArrayView<int64> Int64Values;
+        TConstArrayView<double> DoubleValues;
+        TConstArrayView<int32> StringCodes;
+        TArray<FString> Dictionary;
+        TConstArrayView<double> DictionaryNumbers;
+    };
+
+    /** 解析并校验文件头和各列的数据块 */
+    bool ParseLayout(FString& OutError);
+
+    TUniquePtr<IMappedFileHandle> MappedFile;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+
+    /** 平台不支持内存映射时读入的文件内容 */
+    TArray<uint8> FallbackData;
+
+    const uint8* Data = nullptr;
+    int64 DataSize = 0;
+
+    TArray<FColumnView> Columns;
+    int32 RowCount = 0;
+};
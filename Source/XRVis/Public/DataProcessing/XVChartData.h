@@ -0,0 +1,123 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "XVChartData.generated.h"
+
+/**
+ * 分组聚合的方式，用于将原始记录按X/Y分组汇总为图表数据
+ */
+UENUM(BlueprintType)
+enum class EXVAggregation : uint8
+{
+    /** 不聚合，列值直接作为行列索引 */
+    None UMETA(DisplayName="不聚合"),
+    Sum UMETA(DisplayName="求和"),
+    Mean UMETA(DisplayName="平均值"),
+    /** 分组中的记录数，不需要值列 */
+    Count UMETA(DisplayName="计数"),
+    Min UMETA(DisplayName="最小值"),
+    Max UMETA(DisplayName="最大值"),
+    /** 百分位数，按线性插值计算 */
+    Percentile UMETA(DisplayName="百分位数")
+};
+
+/**
+ * 图表数据的类型化交接格式（结构数组）
+ * 由数据转换器直接填充，图表通过SetValueFromGrid读取，整个过程不经过JSON文本
+ * 柱状图/折线图：每个数据点为 (YIndices[i], XIndices[i], Values[i])，Times不为空时为对应的时间值
+ * 饼图：XIndices[i]为类别在XLabels中的索引，Values[i]为该类别的数值
+ */
+USTRUCT(BlueprintType)
+struct XRVIS_API FXVChartGridData
+{
+    GENERATED_BODY()
+
+    /** 数据点的行索引 */
+    UPROPERTY(BlueprintReadWrite, Category = "XRVis|Data")
+    TArray<int32> YIndices;
+
+    /** 数据点的列索引 */
+    UPROPERTY(BlueprintReadWrite, Category = "XRVis|Data")
+    TArray<int32> XIndices;
+
+    /** 数据点的值 */
+    UPROPERTY(BlueprintReadWrite, Category = "XRVis|Data")
+    TArray<float> Values;
+
+    /** 数据点的时间值，为空表示数据不含时间维度，否则与Values等长；时间戳列为Unix秒 */
+    UPROPERTY(BlueprintReadWrite, Category = "XRVis|Data")
+    TArray<double> Times;
+
+    /** X轴标签（饼图为类别名称），为空时图表保留原有标签 */
+    UPROPERTY(BlueprintReadWrite, Category = "XRVis|Data")
+    TArray<FString> XLabels;
+
+    /** Y轴标签，为空时图表保留原有标签 */
+    UPROPERTY(BlueprintReadWrite, Category = "XRVis|Data")
+    TArray<FString> YLabels;
+
+    /** 获取数据点数量 */
+    int32 Num() const { return Values.Num(); }
+
+    /** 是否包含时间维度 */
+    bool HasTime() const { return Times.Num() > 0 && Times.Num() == Values.Num(); }
+
+    /** 预分配空间 */
+    void Reserve(int32 NumPoints, bool bWithTime = false)
+    {
+        YIndices.Reserve(NumPoints);
+        XIndices.Reserve(NumPoints);
+        Values.Reserve(NumPoints);
+        if (bWithTime)
+        {
+            Times.Reserve(NumPoints);
+        }
+    }
+
+    /** 添加一个数据点 */
+    void Add(int32 Y, int32 X, float Value)
+    {
+        YIndices.Add(Y);
+        XIndices.Add(X);
+        Values.Add(Value);
+    }
+
+    /** 添加一个带时间值的数据点 */
+    void Add(int32 Y, int32 X, float Value, double Time)
+    {
+        Add(Y, X, Value);
+        Times.Add(Time);
+    }
+
+    /** 清空数据 */
+    void Reset()
+    {
+        YIndices.Reset();
+        XIndices.Reset();
+        Values.Reset();
+        Times.Reset();
+        XLabels.Reset();
+        YLabels.Reset();
+    }
+};
+
+/**
+ * 单个单元格的数值更新，用于图表的增量更新
+ */
+USTRUCT(BlueprintType)
+struct XRVIS_API FXVCellUpdate
+{
+    GENERATED_BODY()
+
+    /** 行索引（Y） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "XRVis|Data")
+    int32 Row = 0;
+
+    /** 列索引（X） */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "XRVis|Data")
+    int32 Col = 0;
+
+    /** 新的值 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "XRVis|Data")
+    float Value = 0.0f;
+};
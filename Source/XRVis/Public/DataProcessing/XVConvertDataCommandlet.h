@@ -0,0 +1,21 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "XVConvertDataCommandlet.generated.h"
+
+/**
+ * 将CSV/JSON数据文件转换为二进制数据集（.xvb）的命令行工具
+ * 用法：UnrealEditor-Cmd <Project>.uproject -run=XVConvertData [-Source=<目录或文件>] [-Output=<目录>] [-Recursive]
+ * 默认转换插件Data目录下的文件，输出文件与源文件同名并放在同一目录
+ */
+UCLASS()
+class XRVIS_API UXVConvertDataCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+    UXVConvertDataCommandlet();
+
+    virtual int32 Main(const FString& Params) override;
+};
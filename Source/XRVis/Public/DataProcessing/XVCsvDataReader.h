@@ -15,9 +15,20 @@ class XRVIS_API UXVCsvDataReader : public UXVDataReader
 public:
     UXVCsvDataReader();
 
+    /** 从文件读取CSV数据 - 按块流式读取，不会将整个文件加载为字符串 */
+    virtual bool ReadFromFile(const FString& FilePath) override;
+
     /** 从字符串读取CSV数据 */
     virtual bool ReadFromString(const FString& Content) override;
 
+    virtual FString GetCacheOptionsKey() const override;
+
+    /** 以固定大小的UTF-8分块流式读取CSV文件，每解析出一批行调用一次回调
+     * 回调参数中的表格只包含当前批次的行，回调返回false时停止读取
+     * 读取期间DataTable只保存列名，峰值内存由StreamChunkSize和StreamBatchRowCount决定
+     * 注意：此方法不暴露给蓝图 */
+    bool ReadFromFileStreaming(const FString& FilePath, TFunctionRef<bool(const FXVDataTable& RowBatch)> OnRowBatch);
+
     /** 分隔符 */
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "XRVis|Data|CSV")
     FString Delimiter;
@@ -30,10 +41,62 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "XRVis|Data|CSV")
     bool bAutoDetectDelimiter;
 
+    /** 流式读取时每次从文件读取的字节数 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "XRVis|Data|CSV", meta = (ClampMin = "4096"))
+    int32 StreamChunkSize;
+
+    /** 流式读取时每批回调包含的最大行数 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "XRVis|Data|CSV", meta = (ClampMin = "1"))
+    int32 StreamBatchRowCount;
+
+    /** 是否使用多线程解析，开启后ReadFromFile会将整个文件读入内存再分段并行解析 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "XRVis|Data|CSV")
+    bool bParallelParse;
+
+    /** 多线程解析时每个分段的最小字符数，内容不足两个分段时仍使用单线程解析 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "XRVis|Data|CSV", meta = (ClampMin = "1024", EditCondition = "bParallelParse"))
+    int32 ParallelMinSegmentSize;
+
 private:
-    /** 分析CSV行内容 */
-    void ParseCSVRow(const FString& InRow, TArray<FString>& OutRow);
+    /** 跨分块保留的解析状态 */
+    struct FCsvStreamState
+    {
+        /** 上一个分块末尾尚未结束的记录 */
+        FString PendingRecord;
+
+        /** 当前是否处于引号内 */
+        bool bInQuotes = false;
+
+        /** 是否已经处理过第一条记录（标题行或用于生成默认列名的行） */
+        bool bFirstRecordHandled = false;
+
+        /** 本次解析实际使用的分隔符 */
+        FString ActiveDelimiter;
+
+        /** 解析单条记录时复用的字段视图和转义字段缓冲区 */
+        TArray<FStringView> FieldViews;
+        TArray<FString> UnescapedFields;
+    };
+
+    /** 将一段文本切分为记录（引号内的换行不作为记录结尾），完整的记录交给OnRecord处理 */
+    void ConsumeText(const TCHAR* Text, int32 Len, FCsvStreamState& State, TFunctionRef<void(FStringView Record)> OnRecord);
+
+    /** 处理最后一条没有换行结尾的记录 */
+    void FinishText(FCsvStreamState& State, TFunctionRef<void(FStringView Record)> OnRecord);
+
+    /** 处理单条记录：第一条记录生成列名，其余记录添加到OutTable */
+    void HandleRecord(FStringView Record, FCsvStreamState& State, FXVDataTable& OutTable);
+
+    /** 在引号外的换行处将内容分段，并行解析各段后按原顺序合并到DataTable */
+    void ParseParallel(FStringView Content, FCsvStreamState& State);
+
+    /** 按块读取文件并解析，每满一批行调用一次OnRowBatch（批次中的行可以被移走） */
+    bool StreamFile(const FString& FilePath, TFunctionRef<bool(FXVDataTable& RowBatch)> OnRowBatch);
+
+    /** 分析CSV行内容，字段以指向InRow的视图返回，只有包含转义引号的字段才会写入UnescapedFields
+     * OutRow中的视图在InRow和UnescapedFields有效期间有效 */
+    void ParseCSVRow(FStringView InRow, const FString& InDelimiter, TArray<FStringView>& OutRow, TArray<FString>& UnescapedFields) const;
 
-    /** 自动检测分隔符 */
-    FString DetectDelimiter(const FString& Content);
-}; 
\ No newline at end of file
+    /** 自动检测分隔符，只检查内容的前几行 */
+    FString DetectDelimiter(FStringView Content) const;
+};
@@ -0,0 +1,98 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/EngineSubsystem.h"
+#include "Async/Future.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "DataProcessing/XVDataTable.h"
+#include "XVDataCacheSubsystem.generated.h"
+
+/**
+ * 进程级的数据表缓存 - 多个图表读取同一文件时只解析一次
+ * 缓存键由文件的完整路径、修改时间、文件大小和读取器选项组成，文件被修改后自动失效
+ * 数据表以只读的共享引用保存，超出内存上限时按最近最少使用的顺序淘汰；被淘汰的数据表在图表释放引用后才会销毁
+ * 所有方法都可以在后台线程调用
+ */
+UCLASS()
+class XRVIS_API UXVDataCacheSubsystem : public UEngineSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    using FTablePtr = TSharedPtr<const FXVDataTable, ESPMode::ThreadSafe>;
+
+    UXVDataCacheSubsystem();
+
+    /** 获取缓存子系统，引擎尚未初始化时返回nullptr */
+    static UXVDataCacheSubsystem* Get();
+
+    virtual void Deinitialize() override;
+
+    /** 查找文件对应的数据表，未命中时调用Load读取并加入缓存
+     * 同一个键同时只会读取一次，其他调用者等待并共享读取结果；Load返回空指针表示读取失败，失败的结果不会被缓存
+     * OptionsKey描述影响解析结果的读取器选项，见UXVDataReader::GetCacheOptionsKey
+     * 注意：此方法不暴露给蓝图 */
+    FTablePtr FindOrLoad(const FString& FilePath, const FString& OptionsKey, TFunctionRef<FTablePtr()> Load);
+
+    /** 清空缓存，已被图表引用的数据表不受影响 */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data|Cache")
+    void ClearCache();
+
+    /** 移除指定文件的所有缓存项 */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data|Cache")
+    void InvalidateFile(const FString& FilePath);
+
+    /** 当前缓存的数据表数量 */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data|Cache")
+    int32 GetNumCachedTables() const;
+
+    /** 当前缓存占用的字节数 */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data|Cache")
+    int64 GetCachedBytes() const;
+
+    /** 设置缓存的内存上限（字节），超出时立即淘汰 */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data|Cache")
+    void SetMaxCacheBytes(int64 InMaxCacheBytes);
+
+    /** 获取缓存的内存上限（字节） */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data|Cache")
+    int64 GetMaxCacheBytes() const;
+
+private:
+    struct FEntry
+    {
+        /** 规范化后的文件路径及读取时的修改时间和大小，用于移除同一文件的旧版本 */
+        FString FilePath;
+        FDateTime ModificationTime;
+        int64 FileSize = 0;
+
+        FTablePtr Table;
+
+        SIZE_T Bytes = 0;
+
+        /** 最近一次访问的序号，越小越久未被使用 */
+        uint64 LastAccess = 0;
+    };
+
+    /** 加入新读取的数据表并移除同一文件的旧版本，调用时必须持有锁 */
+    void AddEntryLocked(const FString& Key, const FString& NormalizedPath, const FFileStatData& StatData, const FTablePtr& Table);
+
+    /** 淘汰最久未使用的项直到不超过内存上限，至少保留最新的一项；调用时必须持有锁 */
+    void EvictLocked();
+
+    void RemoveEntryLocked(const FString& Key);
+
+    mutable FCriticalSection Lock;
+
+    TMap<FString, FEntry> Entries;
+
+    /** 正在读取的键，等待者共享同一个结果 */
+    TMap<FString, TSharedFuture<FTablePtr>> PendingLoads;
+
+    uint64 AccessCounter = 0;
+
+    int64 TotalBytes = 0;
+
+    /** 内存上限，默认512MB */
+    int64 MaxCacheBytes;
+};
@@ -3,6 +3,7 @@
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
 #include "DataProcessing/XVDataReader.h"
+#include "DataProcessing/XVChartData.h"
 #include "XVDataConverter.generated.h"
 
 /**
@@ -29,7 +30,44 @@ public:
     UFUNCTION(BlueprintCallable, Category = "XRVis|Data|Conversion")
     static TMap<FString, float> ConvertToPieChartFormat(const FXVDataTable& DataTable, const FString& LabelColumn, const FString& ValueColumn);
 
+    /** 将数据表格转换为柱状图的类型化数据，列值直接作为行列索引
+     * 失败时返回false，OutGrid被清空 */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data|Conversion")
+    static bool ConvertToBarChartGrid(const FXVDataTable& DataTable, const FString& XColumn, const FString& YColumn, const FString& ZColumn, FXVChartGridData& OutGrid);
+
+    /** 将数据表格转换为折线图的类型化数据 */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data|Conversion")
+    static bool ConvertToLineChartGrid(const FXVDataTable& DataTable, const FString& XColumn, const FString& YColumn, const FString& ZColumn, FXVChartGridData& OutGrid);
+
+    /** 将数据表格转换为饼图的类型化数据，相同类别的值会被累加 */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data|Conversion")
+    static bool ConvertToPieChartGrid(const FXVDataTable& DataTable, const FString& LabelColumn, const FString& ValueColumn, FXVChartGridData& OutGrid);
+
+    /** 将命名属性数据（JSON对象数组）转换为类型化数据
+     * X/Y属性的不同取值按数值或字符串排序后映射为索引，并写入轴标签
+     * TimeProperty不为空且数据中存在该属性时填充时间值 */
+    static bool ConvertNamedDataToGrid(const TArray<TSharedPtr<FJsonObject>>& NamedData, const FString& XProperty, const FString& YProperty,
+                                       const FString& ZProperty, const FString& TimeProperty, FXVChartGridData& OutGrid);
+
+    /** 将JSON文件读取得到的数据表转换为类型化数据，结果与UXVJsonDataReader::ReadChartGridFromFile一致
+     * 对象数组按列名（不区分大小写）取X/Y/Z/Time列，X/Y的不同取值排序后映射为索引；X/Y/Z为空的行被跳过
+     * 数组的数组（列名为Column0、Column1...）按 [Y, X, Z(, Time)] 的位置取值 */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data|Conversion")
+    static bool ConvertJsonTableToGrid(const FXVDataTable& DataTable, const FString& XProperty, const FString& YProperty,
+                                       const FString& ZProperty, const FString& TimeProperty, FXVChartGridData& OutGrid);
+
+    /** 按X/Y列分组聚合Z列，生成柱状图/折线图的类型化数据
+     * X/Y的不同取值排序后映射为索引并写入轴标签；X/Y为空的行被跳过，Count以外的方式还会跳过Z为空的行
+     * 数据按行分块并行扫描，每个线程使用自己的哈希表，最后合并；Percentile为0-100，只用于Percentile方式
+     * Aggregation为None或列不存在时返回false */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data|Conversion")
+    static bool AggregateToGrid(const FXVDataTable& DataTable, const FString& XColumn, const FString& YColumn, const FString& ZColumn,
+                                EXVAggregation Aggregation, float Percentile, FXVChartGridData& OutGrid);
+
 private:
+    /** 将类型化数据序列化为 [[Y, X, Z], ...] 格式的JSON字符串 */
+    static FString SerializeGrid(const FXVChartGridData& Grid);
+
     /** 查找列索引 */
     static int32 FindColumnIndex(const FXVDataTable& DataTable, const FString& ColumnName);
 }; 
\ No newline at end of file
@@ -5,6 +5,8 @@
 #include "DataProcessing/XVDataReader.h"
 #include "DataProcessing/XVJsonDataReader.h"
 #include "DataProcessing/XVCsvDataReader.h"
+#include "DataProcessing/XVBinaryDataReader.h"
+#include "DataProcessing/XVChartData.h"
 #include "XVDataManager.generated.h"
 
 /**
@@ -27,6 +29,19 @@ public:
     UFUNCTION(BlueprintCallable, Category = "XRVis|Data")
     bool LoadFromCsvFile(const FString& FilePath);
 
+    /** 从二进制数据集（.xvb）读取数据 */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data")
+    bool LoadFromBinaryFile(const FString& FilePath);
+
+    /** 按扩展名选择读取器，通过进程级的数据缓存读取文件（见UXVDataCacheSubsystem）
+     * 多个数据管理器以相同的读取器选项读取同一文件时只解析一次，共享同一份只读数据表 */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data")
+    bool LoadFromFileCached(const FString& FilePath);
+
+    /** 将当前加载的数据表保存为二进制数据集（.xvb） */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data")
+    bool SaveToBinaryFile(const FString& FilePath);
+
     /** 从JSON字符串读取数据 */
     UFUNCTION(BlueprintCallable, Category = "XRVis|Data")
     bool LoadFromJsonString(const FString& JsonString);
@@ -55,6 +70,27 @@ public:
     UFUNCTION(BlueprintCallable, Category = "XRVis|Data|Conversion")
     TMap<FString, float> ConvertToPieChartData(const FString& LabelColumn, const FString& ValueColumn);
 
+    /** 转换为柱状图的类型化数据，可直接传给图表的SetValueFromGrid */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data|Conversion")
+    bool ConvertToBarChartGrid(const FString& XColumn, const FString& YColumn, const FString& ZColumn, FXVChartGridData& OutGrid);
+
+    /** 转换为折线图的类型化数据 */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data|Conversion")
+    bool ConvertToLineChartGrid(const FString& XColumn, const FString& YColumn, const FString& ZColumn, FXVChartGridData& OutGrid);
+
+    /** 转换为饼图的类型化数据 */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data|Conversion")
+    bool ConvertToPieChartGrid(const FString& LabelColumn, const FString& ValueColumn, FXVChartGridData& OutGrid);
+
+    /** 按X/Y列分组聚合Z列，生成柱状图/折线图的类型化数据，见UXVDataConverter::AggregateToGrid */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data|Conversion")
+    bool AggregateToGrid(const FString& XColumn, const FString& YColumn, const FString& ZColumn, EXVAggregation Aggregation,
+                         float Percentile, FXVChartGridData& OutGrid);
+
+    /** 为所有读取器设置进度回调和取消标志，见UXVDataReader::SetReadMonitor
+     * 注意：此方法不暴露给蓝图 */
+    void SetReadMonitor(const TFunction<void(float)>& InOnProgress, const TSharedPtr<FThreadSafeBool, ESPMode::ThreadSafe>& InCancelFlag);
+
     /** 获取CSV数据读取器实例 */
     UFUNCTION(BlueprintCallable, Category = "XRVis|Data")
     UXVCsvDataReader* GetCsvReader() { return CsvReader; }
@@ -63,7 +99,20 @@ public:
     UFUNCTION(BlueprintCallable, Category = "XRVis|Data")
     UXVJsonDataReader* GetJsonReader() { return JsonReader; }
 
+    /** 获取二进制数据读取器实例 */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data")
+    UXVBinaryDataReader* GetBinaryReader() { return BinaryReader; }
+
 private:
+    /** 设置当前活动的读取器，同时释放从缓存获取的数据表 */
+    void SetActiveReader(UXVDataReader* Reader);
+
+    /** 按文件扩展名选择读取器，不支持的扩展名返回nullptr */
+    UXVDataReader* FindReaderForFile(const FString& FilePath) const;
+
+    /** 当前加载的数据表，未加载数据时返回nullptr */
+    const FXVDataTable* GetLoadedTable() const;
+
     /** JSON数据读取器 */
     UPROPERTY()
     UXVJsonDataReader* JsonReader;
@@ -72,10 +121,17 @@ private:
     UPROPERTY()
     UXVCsvDataReader* CsvReader;
 
+    /** 二进制数据读取器 */
+    UPROPERTY()
+    UXVBinaryDataReader* BinaryReader;
+
     /** 当前活动的数据读取器 */
     UPROPERTY()
     UXVDataReader* ActiveReader;
 
+    /** 从数据缓存获取的数据表，与其他数据管理器共享 */
+    TSharedPtr<const FXVDataTable, ESPMode::ThreadSafe> SharedTable;
+
     /** 最后一次错误信息 */
     FString LastError;
 }; 
\ No newline at end of file
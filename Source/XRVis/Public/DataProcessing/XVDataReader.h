@@ -2,51 +2,10 @@
 
 #include "CoreMinimal.h"
 #include "UObject/NoExportTypes.h"
+#include "HAL/ThreadSafeBool.h"
+#include "DataProcessing/XVDataTable.h"
 #include "XVDataReader.generated.h"
 
-/**
- * 表示数据表格中的一行
- */
-USTRUCT(BlueprintType)
-struct XRVIS_API FXVDataRow
-{
-    GENERATED_BODY()
-
-    /** 行中的单元格数据 */
-    UPROPERTY(BlueprintReadOnly, Category = "Data")
-    TArray<FString> Cells;
-};
-
-/**
- * 表示数据读取后的通用格式
- */
-USTRUCT(BlueprintType)
-struct XRVIS_API FXVDataTable
-{
-    GENERATED_BODY()
-
-    /** 数据表格的列名 */
-    UPROPERTY(BlueprintReadOnly, Category = "Data")
-    TArray<FString> ColumnNames;
-
-    /** 数据表格内容（行） */
-    UPROPERTY(BlueprintReadOnly, Category = "Data")
-    TArray<FXVDataRow> Rows;
-
-    /** 获取行数 */
-    int32 GetRowCount() const { return Rows.Num(); }
-
-    /** 获取列数 */
-    int32 GetColumnCount() const { return ColumnNames.Num(); }
-
-    /** 清空数据 */
-    void Clear()
-    {
-        ColumnNames.Empty();
-        Rows.Empty();
-    }
-};
-
 /**
  * 数据读取基类 - 提供从不同格式读取数据的通用接口
  */
@@ -74,7 +33,25 @@ public:
     UFUNCTION(BlueprintCallable, Category = "XRVis|Data")
     FString GetLastError() const { return LastError; }
 
+    /** 描述影响解析结果的读取器选项，作为数据缓存键的一部分；选项不同的读取结果不会共享缓存 */
+    virtual FString GetCacheOptionsKey() const;
+
+    /** 移出解析后的数据表，读取器中的数据表被清空
+     * 注意：此方法不暴露给蓝图 */
+    FXVDataTable ReleaseDataTable();
+
+    /** 设置读取过程中的进度回调（0~1）和取消标志，二者都可能在后台线程访问；传空值清除
+     * 取消标志被置位后读取会尽快停止并返回false
+     * 注意：此方法不暴露给蓝图 */
+    void SetReadMonitor(TFunction<void(float)> InOnProgress, TSharedPtr<FThreadSafeBool, ESPMode::ThreadSafe> InCancelFlag);
+
+    /** 取消标志是否已被置位 */
+    bool IsReadCancelled() const { return CancelFlag.IsValid() && *CancelFlag; }
+
 protected:
+    /** 报告读取进度，返回false表示读取已被取消，此时LastError被设置为取消信息 */
+    bool ReportProgress(float Progress);
+
     /** 解析后的数据表 */
     UPROPERTY(BlueprintReadOnly, Category = "Data")
     FXVDataTable DataTable;
@@ -82,4 +59,11 @@ protected:
     /** 最后一次错误信息 */
     UPROPERTY(BlueprintReadOnly, Category = "Data")
     FString LastError;
+
+private:
+    /** 读取进度回调 */
+    TFunction<void(float)> OnProgress;
+
+    /** 取消标志 */
+    TSharedPtr<FThreadSafeBool, ESPMode::ThreadSafe> CancelFlag;
 }; 
\ No newline at end of file
@@ -0,0 +1,242 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "DataProcessing/XVTimestampParser.h"
+#include "XVDataTable.generated.h"
+
+/**
+ * 数据列的存储类型，按照 Empty -> Int64 -> Double -> String 的顺序提升
+ * Timestamp 与数值类型混合时提升为 String
+ */
+UENUM(BlueprintType)
+enum class EXVColumnType : uint8
+{
+    /** 尚未出现有效值（只有空单元格） */
+    Empty,
+    /** 64位整数 */
+    Int64,
+    /** 双精度浮点数 */
+    Double,
+    /** 字典编码的字符串 */
+    String,
+    /** 时间戳，存储为FDateTime的Ticks */
+    Timestamp
+};
+
+/**
+ * 列式存储的数据列
+ * 每列只使用与其类型对应的连续数组，字符串列保存字典编码，空单元格由Validity标记
+ */
+struct XRVIS_API FXVDataColumn
+{
+public:
+    /** 获取列类型 */
+    EXVColumnType GetType() const { return Type; }
+
+    /** 获取行数 */
+    int32 Num() const { return Validity.Num(); }
+
+    /** 单元格是否有值 */
+    bool IsValid(int32 RowIndex) const { return Validity[RowIndex]; }
+
+    /** 以字符串形式追加一个单元格，会根据内容推断并在需要时提升列类型 */
+    void AppendString(FStringView Text);
+
+    /** 追加一个整数值 */
+    void AppendInt64(int64 Value);
+
+    /** 追加一个数值，整数值在整数列中保持为整数 */
+    void AppendNumber(double Value);
+
+    /** 追加空单元格 */
+    void AppendNull(int32 Count = 1);
+
+    /** 将另一列的数据追加到本列末尾，类型不一致时按提升规则合并，字符串字典会重新映射 */
+    void AppendColumn(const FXVDataColumn& Other);
+
+    /** 预分配空间 */
+    void Reserve(int32 NumRows);
+
+    /** 获取单元格的字符串形式，空单元格返回空字符串 */
+    FString GetString(int32 RowIndex) const;
+
+    /** 获取单元格的数值，字符串按Atof规则解析（每个字典项只解析一次），空单元格返回0 */
+    double GetNumber(int32 RowIndex) const
+    {
+        if (!Validity[RowIndex])
+        {
+            return 0.0;
+        }
+        switch (Type)
+        {
+        case EXVColumnType::Int64:
+            return static_cast<double>(Int64Values[RowIndex]);
+        case EXVColumnType::Double:
+            return DoubleValues[RowIndex];
+        case EXVColumnType::String:
+            return DictionaryNumbers[StringCodes[RowIndex]];
+        case EXVColumnType::Timestamp:
+            return TimestampToUnixSeconds(Int64Values[RowIndex]);
+        default:
+            return 0.0;
+        }
+    }
+
+    /** 整数列的值，时间戳列中为Ticks */
+    TConstArrayView<int64> GetInt64Values() const { return Int64Values; }
+
+    /** 浮点列的值 */
+    TConstArrayView<double> GetDoubleValues() const { return DoubleValues; }
+
+    /** 字符串列的字典编码，空单元格为INDEX_NONE */
+    TConstArrayView<int32> GetStringCodes() const { return StringCodes; }
+
+    /** 字符串列的字典（区分大小写） */
+    TConstArrayView<FString> GetDictionary() const { return Dictionary; }
+
+    /** 字典项按Atof解析后的数值 */
+    TConstArrayView<double> GetDictionaryNumbers() const { return DictionaryNumbers; }
+
+    /** 单元格有效性位图 */
+    const TBitArray<>& GetValidity() const { return Validity; }
+
+    /**
+     * 用连续的数据块整体替换列内容，用于从二进制数据集加载
+     * ValidityWords为NumRows位的有效性位图；Values只需提供与InType对应的一个数组，长度为NumRows
+     * 字符串列的字典数值直接使用InDictionaryNumbers，不再逐项解析
+     */
+    void AssignBlocks(EXVColumnType InType, int32 NumRows, const uint32* ValidityWords, TConstArrayView<int64> InInt64Values,
+                      TConstArrayView<double> InDoubleValues, TConstArrayView<int32> InStringCodes,
+                      TArray<FString>&& InDictionary, TConstArrayView<double> InDictionaryNumbers);
+
+    /** 估算占用的内存 */
+    SIZE_T GetAllocatedSize() const;
+
+    /** 将时间戳Ticks转换为Unix秒 */
+    static double TimestampToUnixSeconds(int64 Ticks);
+
+private:
+    /** 将列提升为指定类型，已有的值会被转换 */
+    void PromoteTo(EXVColumnType NewType);
+
+    /** 在字典中查找或添加字符串，返回编码 */
+    int32 InternString(FStringView Text);
+
+    /** 追加一个已经确定为字符串类型的值 */
+    void AppendStringValue(FStringView Text);
+
+    EXVColumnType Type = EXVColumnType::Empty;
+
+    /** 单元格是否有值 */
+    TBitArray<> Validity;
+
+    /** Int64 / Timestamp 列的值 */
+    TArray<int64> Int64Values;
+
+    /** Double 列的值 */
+    TArray<double> DoubleValues;
+
+    /** String 列的字典编码 */
+    TArray<int32> StringCodes;
+
+    /** 字符串字典 */
+    TArray<FString> Dictionary;
+
+    /** 字典项的数值缓存 */
+    TArray<double> DictionaryNumbers;
+
+    /** 字典查找用的哈希链表头（哈希 -> 编码）以及链表的后继 */
+    TMap<uint32, int32> DictionaryHashHeads;
+    TArray<int32> DictionaryNext;
+
+    /** 时间戳解析器，按本列第一个时间戳检测格式 */
+    FXVTimestampParser TimestampParser;
+};
+
+/**
+ * 表示数据读取后的通用格式（列式存储）
+ */
+USTRUCT(BlueprintType)
+struct XRVIS_API FXVDataTable
+{
+    GENERATED_BODY()
+
+    /** 数据表格的列名 */
+    UPROPERTY(BlueprintReadOnly, Category = "Data")
+    TArray<FString> ColumnNames;
+
+    /** 数据表格内容（列），与ColumnNames一一对应 */
+    TArray<FXVDataColumn> Columns;
+
+    /** 获取行数 */
+    int32 GetRowCount() const { return RowCount; }
+
+    /** 获取列数 */
+    int32 GetColumnCount() const { return ColumnNames.Num(); }
+
+    /** 清空数据 */
+    void Clear()
+    {
+        ColumnNames.Empty();
+        ResetRows();
+    }
+
+    /** 清空所有行，保留列名 */
+    void ResetRows()
+    {
+        Columns.Empty();
+        RowCount = 0;
+    }
+
+    /** 添加一行，单元格数少于列数时补空，多余的单元格被忽略 */
+    void AddRow(TConstArrayView<FString> Cells);
+    void AddRow(TConstArrayView<FStringView> Cells);
+
+    /** 获取可写的列，用于逐列追加类型化的值
+     * 每一列追加恰好一个值后调用CommitRow完成一行 */
+    FXVDataColumn& GetMutableColumn(int32 ColumnIndex)
+    {
+        EnsureColumns();
+        return Columns[ColumnIndex];
+    }
+
+    /** 完成通过GetMutableColumn逐列追加的一行 */
+    void CommitRow();
+
+    /** 用已经填充好的列整体替换表内容，各列行数必须一致 */
+    void AssignColumns(TArray<FString>&& InColumnNames, TArray<FXVDataColumn>&& InColumns);
+
+    /** 将另一张列名相同的表的行追加到本表末尾 */
+    void AppendTable(FXVDataTable&& Other);
+
+    /** 按顺序追加多张列名相同的表，各列并行合并，合并后Others中的表被清空 */
+    void AppendTables(TArrayView<FXVDataTable> Others);
+
+    /** 预分配行空间 */
+    void Reserve(int32 NumRows);
+
+    /** 获取列，索引无效时返回nullptr */
+    const FXVDataColumn* GetColumn(int32 ColumnIndex) const
+    {
+        return Columns.IsValidIndex(ColumnIndex) ? &Columns[ColumnIndex] : nullptr;
+    }
+
+    /** 获取单元格的字符串形式 */
+    FString GetCellAsString(int32 RowIndex, int32 ColumnIndex) const;
+
+    /** 获取单元格的数值 */
+    double GetNumber(int32 RowIndex, int32 ColumnIndex) const;
+
+    /** 估算占用的内存 */
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    /** 确保列数组与列名数量一致 */
+    void EnsureColumns();
+
+    template <typename CellType>
+    void AddRowInternal(TConstArrayView<CellType> Cells);
+
+    /** 行数 */
+    int32 RowCount = 0;
+};
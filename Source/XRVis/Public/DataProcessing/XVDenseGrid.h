@@ -0,0 +1,115 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "DataProcessing/XVChartData.h"
+
+/**
+ * 柱状图/折线图使用的稠密网格，按行优先顺序连续保存每个 (Y, X) 单元格的值
+ * 缺失的单元格由有效位标记，值为0；同时维护有效值的数量、最小值和最大值
+ * 遍历时按内存顺序线性访问，不再需要逐个单元格查找哈希表
+ */
+struct XRVIS_API FXVDenseGrid
+{
+public:
+    /** 按类型化数据重建网格，行数和列数为最大索引+1，负索引的数据点被忽略
+     * 同一单元格出现多次时保留最后的值；bTruncateValues为true时值按整数保存 */
+    void Build(const FXVChartGridData& GridData, bool bTruncateValues = false);
+
+    /** 清空网格 */
+    void Reset();
+
+    /** 行数 */
+    int32 GetNumRows() const { return NumRows; }
+
+    /** 列数 */
+    int32 GetNumCols() const { return NumCols; }
+
+    /** 有效单元格的数量 */
+    int32 Num() const { return NumValid; }
+
+    bool IsEmpty() const { return NumValid == 0; }
+
+    /** 修改范围内单元格的值，缺失的单元格会变为有效
+     * 最小值和最大值只会扩大，需要精确值时调用RecomputeRange */
+    void SetValue(int32 Row, int32 Col, float Value);
+
+    /** 按当前的有效值重新统计最小值和最大值 */
+    void RecomputeRange();
+
+    /** 将有效单元格导出为类型化数据，不含标签和时间 */
+    void ToGridData(FXVChartGridData& OutGridData) const;
+
+    /** 单元格是否在网格范围内 */
+    bool Contains(int32 Row, int32 Col) const { return Row >= 0 && Row < NumRows && Col >= 0 && Col < NumCols; }
+
+    /** 单元格在Values中的下标 */
+    int32 GetCellIndex(int32 Row, int32 Col) const { return Row * NumCols + Col; }
+
+    /** 单元格是否有值 */
+    bool IsValid(int32 Row, int32 Col) const { return Validity[GetCellIndex(Row, Col)]; }
+
+    /** 单元格的值，缺失时为0 */
+    float Get(int32 Row, int32 Col) const { return Values[GetCellIndex(Row, Col)]; }
+
+    /** 行中最后一个有效单元格之后的列号，行中没有数据时为0 */
+    int32 GetRowLength(int32 Row) const { return RowLengths[Row]; }
+
+    /** 一行的值 */
+    TConstArrayView<float> GetRow(int32 Row) const { return MakeArrayView(Values.GetData() + Row * NumCols, NumCols); }
+
+    /** 所有单元格的值，按行优先顺序排列 */
+    TConstArrayView<float> GetValues() const { return Values; }
+
+    /** 所有单元格的有效位，与GetValues一一对应 */
+    const TBitArray<>& GetValidity() const { return Validity; }
+
+    /** 有效值中的最小值，网格为空时为0 */
+    float GetMinValue() const { return MinValue; }
+
+    /** 有效值中的最大值，网格为空时为0 */
+    float GetMaxValue() const { return MaxValue; }
+
+    /** 按行优先顺序遍历有效单元格，Func的参数为 (Row, Col, Value) */
+    template <typename FuncType>
+    void ForEachValid(FuncType&& Func) const
+    {
+        for (int32 Row = 0; Row < NumRows; ++Row)
+        {
+            ForEachValidInRow(Row, Func);
+        }
+    }
+
+    /** 按列顺序遍历一行中的有效单元格，Func的参数为 (Row, Col, Value) */
+    template <typename FuncType>
+    void ForEachValidInRow(int32 Row, FuncType&& Func) const
+    {
+        const int32 RowStart = Row * NumCols;
+        for (int32 Col = 0; Col < RowLengths[Row]; ++Col)
+        {
+            if (Validity[RowStart + Col])
+            {
+                Func(Row, Col, Values[RowStart + Col]);
+            }
+        }
+    }
+
+    /** 按行优先顺序收集所有有效值 */
+    void GetValidValues(TArray<float>& OutValues) const;
+
+private:
+    int32 NumRows = 0;
+    int32 NumCols = 0;
+    int32 NumValid = 0;
+
+    float MinValue = 0.0f;
+    float MaxValue = 0.0f;
+
+    /** 行优先的单元格值 */
+    TArray<float> Values;
+
+    /** 单元格是否有值 */
+    TBitArray<> Validity;
+
+    /** 每行最后一个有效单元格之后的列号 */
+    TArray<int32> RowLengths;
+};
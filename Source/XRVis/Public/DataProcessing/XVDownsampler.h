@@ -0,0 +1,29 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 保持形状的折线降采样
+ * 输入为按X递增排列的点，输出为保留的点在输入中的下标（递增，总是包含首尾两点）
+ * 与按固定步长抽取不同，两种方法都会保留峰值和尖刺
+ */
+struct XRVIS_API FXVDownsampler
+{
+    /**
+     * 最大三角形三桶法（Largest-Triangle-Three-Buckets）
+     * 把中间的点分为Threshold-2个桶，每个桶保留与前一个保留点、下一个桶的平均点构成三角形面积最大的点
+     * 点数不超过Threshold或Threshold小于3时保留所有点
+     */
+    static void LargestTriangleThreeBuckets(TConstArrayView<float> Xs, TConstArrayView<float> Ys, int32 Threshold, TArray<int32>& OutIndices);
+
+    /**
+     * 分桶最小/最大值法
+     * 把中间的点分为约Threshold/2个桶，每个桶按原顺序保留最小值和最大值两个点，极值一定不会丢失
+     * 点数不超过Threshold时保留所有点
+     */
+    static void MinMaxBuckets(TConstArrayView<float> Ys, int32 Threshold, TArray<int32>& OutIndices);
+
+private:
+    /** 保留所有点 */
+    static void KeepAll(int32 NumPoints, TArray<int32>& OutIndices);
+};
@@ -0,0 +1,70 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "DataProcessing/XVDenseGrid.h"
+
+/**
+ * 稠密网格的区域查询结构，每份数据只建立一次，修改单元格后只更新受影响的表项
+ * 值和有效单元格数量的求和面积表按TileSize x TileSize分块建立，边长不超过TileSize的矩形最多覆盖4块，和、有效数量和平均值都是O(1)查询；
+ * 最大值使用二维稀疏表，边长不超过MaxBlockSize的矩形用4次查表得到
+ */
+struct XRVIS_API FXVGridPyramid
+{
+public:
+    /** 求和面积表分块的边长，修改一个单元格只重建其所在的块 */
+    static constexpr int32 TileSize = 32;
+
+    /** 由网格建立求和面积表，并为边长不超过MaxBlockSize的矩形建立最大值稀疏表 */
+    void Build(const FXVDenseGrid& Grid, int32 InMaxBlockSize);
+
+    /** 按网格中修改过的单元格更新各表，DirtyCells与网格的单元格一一对应
+     * 只重建修改单元格所在的求和面积表分块，以及稀疏表中覆盖这些单元格的项；网格尺寸改变时完整重建 */
+    void UpdateCells(const FXVDenseGrid& Grid, const TBitArray<>& DirtyCells);
+
+    /** 清空所有表 */
+    void Reset();
+
+    bool IsEmpty() const { return NumRows == 0 || NumCols == 0; }
+
+    /** 矩形 [Row, Row + Height) x [Col, Col + Width) 内有效值的和，超出网格的部分被裁剪 */
+    double GetSum(int32 Row, int32 Col, int32 Height, int32 Width) const;
+
+    /** 矩形内有效单元格的数量 */
+    int32 GetValidCount(int32 Row, int32 Col, int32 Height, int32 Width) const;
+
+    /** 矩形内有效值的最大值，没有有效单元格时返回TNumericLimits<float>::Lowest()
+     * Height和Width超过建立时的MaxBlockSize时退化为逐个单元格比较 */
+    float GetMax(int32 Row, int32 Col, int32 Height, int32 Width) const;
+
+private:
+    /** 将矩形裁剪到网格范围内，裁剪后为空时返回false */
+    bool ClipRect(int32& Row, int32& Col, int32& Height, int32& Width) const;
+
+    /** 重建从 (TileRow, TileCol) 开始的求和面积表分块 */
+    void BuildSumTile(const FXVDenseGrid& Grid, int32 TileRow, int32 TileCol);
+
+    /** 按分块累加已裁剪矩形的和 */
+    template <typename ValueType>
+    ValueType SumTiles(const TArray<ValueType>& Table, int32 Row, int32 Col, int32 Height, int32 Width) const;
+
+    /** 由低一级的表计算稀疏表 (LevelY, LevelX) 级在 (Row, Col) 处的最大值 */
+    float ComputeLevelMax(int32 LevelY, int32 LevelX, int32 Row, int32 Col) const;
+
+    int32 NumRows = 0;
+    int32 NumCols = 0;
+
+    /** 建立时的最大矩形边长 */
+    int32 MaxBlockSize = 0;
+
+    /** 稀疏表在每个方向上的级数，第K级覆盖2^K个单元格 */
+    int32 NumLevels = 0;
+
+    /** 值的分块求和面积表，每个单元格为从所在分块左上角到该单元格（含）的和，缺失的单元格按0计 */
+    TArray<double> SumTable;
+
+    /** 有效单元格数量的分块求和面积表 */
+    TArray<int32> CountTable;
+
+    /** MaxLevels[LevelY * NumLevels + LevelX] 中每个单元格为从该单元格开始的 2^LevelY x 2^LevelX 矩形的最大值 */
+    TArray<TArray<float>> MaxLevels;
+};
@@ -2,9 +2,12 @@
 
 #include "CoreMinimal.h"
 #include "DataProcessing/XVDataReader.h"
+#include "DataProcessing/XVChartData.h"
 #include "Dom/JsonObject.h"
 #include "XVJsonDataReader.generated.h"
 
+class FXVJsonPullParser;
+
 /**
  * 用于读取Json格式数据的读取器
  */
@@ -16,9 +19,26 @@ class XRVIS_API UXVJsonDataReader : public UXVDataReader
 public:
     UXVJsonDataReader();
 
-    /** 从字符串读取JSON数据 */
+    /** 从文件读取JSON数据 - 顶层为数组时按块流式解析，不会将整个文件加载为字符串或构建DOM */
+    virtual bool ReadFromFile(const FString& FilePath) override;
+
+    /** 从字符串读取JSON数据 - 顶层为数组时直接从文本解析到数据表，不构建DOM */
     virtual bool ReadFromString(const FString& Content) override;
 
+    virtual FString GetCacheOptionsKey() const override;
+
+    /** 从文件直接读取图表数据，支持 [[y,x,z(,time)], ...] 和命名对象数组两种格式
+     * 命名对象按X/Y/Z/Time属性取值，X/Y的不同取值排序后作为轴标签
+     * 文件按块流式解析，不经过数据表和DOM；格式不符或没有数据点时返回false */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data|Json")
+    bool ReadChartGridFromFile(const FString& FilePath, const FString& XProperty, const FString& YProperty, const FString& ZProperty,
+                               const FString& TimeProperty, FXVChartGridData& OutGrid);
+
+    /** 从字符串直接读取图表数据，格式同ReadChartGridFromFile */
+    UFUNCTION(BlueprintCallable, Category = "XRVis|Data|Json")
+    bool ReadChartGridFromString(const FString& Content, const FString& XProperty, const FString& YProperty, const FString& ZProperty,
+                                 const FString& TimeProperty, FXVChartGridData& OutGrid);
+
     /** 从数组型JSON读取 - 注意：此方法不暴露给蓝图 */
     bool ReadFromJsonArray(const TArray<TSharedPtr<FJsonValue>>& JsonArray, bool bHasHeaderRow = false);
 
@@ -33,7 +53,21 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "XRVis|Data|Json")
     FString KeySeparator;
 
+    /** 流式读取时每次从文件读取的字节数 */
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "XRVis|Data|Json", meta = (ClampMin = "4096"))
+    int32 StreamChunkSize;
+
 private:
+    /** 以DOM方式解析整段JSON，用于顶层为对象的情况 */
+    bool ReadFromStringDom(const FString& Content);
+
+    /** 从解析器读取顶层数组的各行到DataTable，调用前顶层的ArrayStart已被读取 */
+    bool ReadArrayFromParser(FXVJsonPullParser& Parser);
+
+    /** 从解析器读取图表数据，调用前顶层的ArrayStart已被读取 */
+    bool ReadGridFromParser(FXVJsonPullParser& Parser, const FString& XProperty, const FString& YProperty, const FString& ZProperty,
+                            const FString& TimeProperty, FXVChartGridData& OutGrid);
+
     /** 处理嵌套JSON对象，生成扁平化键 */
     void ProcessJsonObject(const TSharedPtr<FJsonObject>& JsonObject, const FString& KeyPrefix, TMap<FString, FString>& OutValues);
 }; 
\ No newline at end of file
@@ -0,0 +1,181 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Containers/Queue.h"
+#include <atomic>
+
+class FRunnableThread;
+class FSocket;
+class IFileHandle;
+
+/**
+ * 实时数据源推送的一条更新
+ * 不带时间时表示将单元格(Row, Col)的值设为Value；带时间时表示向序列Row追加一个采样点，Col被忽略
+ */
+struct FXVLiveSample
+{
+    int32 Row = 0;
+    int32 Col = 0;
+    float Value = 0.f;
+    double Time = 0.0;
+    bool bHasTime = false;
+};
+
+/**
+ * 实时数据源接口
+ * 数据源在自己的工作线程上读取数据，通过无锁队列交给游戏线程；游戏线程每帧调用Dequeue取出所有更新
+ */
+class XRVIS_API IXVLiveDataSource
+{
+public:
+    virtual ~IXVLiveDataSource() = default;
+
+    /** 启动工作线程，已在运行时返回true */
+    virtual bool Start() = 0;
+
+    /** 停止工作线程并等待其退出 */
+    virtual void Stop() = 0;
+
+    virtual bool IsRunning() const = 0;
+
+    /** 取出一条更新，只能在一个线程上调用；队列为空时返回false */
+    virtual bool Dequeue(FXVLiveSample& OutSample) = 0;
+
+    /** 用于日志的描述 */
+    virtual FString GetDescription() const = 0;
+};
+
+/**
+ * 按行读取文本数据的实时数据源基类
+ * 每行格式为 Row,Col,Value 或 Row,Col,Value,Time，分别对应单元格更新和序列采样；
+ * 任何字段不是完整的数字（例如表头行）或Row、Col、Value为空的行被忽略。
+ * 连接断开或打开失败时每隔RetryInterval秒重试，子类只需实现打开、读取和关闭。
+ */
+class XRVIS_API FXVLineLiveDataSource : public IXVLiveDataSource, public FRunnable
+{
+public:
+    virtual ~FXVLineLiveDataSource() override;
+
+    virtual bool Start() override;
+    virtual void Stop() override;
+    virtual bool IsRunning() const override { return Thread != nullptr; }
+    virtual bool Dequeue(FXVLiveSample& OutSample) override { return Queue.Dequeue(OutSample); }
+
+    /** 没有新数据时工作线程的轮询间隔（秒） */
+    float PollInterval = 0.002f;
+
+    /** 打开失败或连接断开后的重试间隔（秒） */
+    float RetryInterval = 1.f;
+
+    /** 一行的最大字节数，超过时丢弃该行直到下一个换行符，避免对端不发送换行符时缓冲区无限增长 */
+    int32 MaxLineLength = 4096;
+
+protected:
+    //~ Begin FRunnable Interface
+    virtual uint32 Run() override;
+    //~ End FRunnable Interface
+
+    /** 在工作线程上打开数据源，失败时返回false */
+    virtual bool Open() = 0;
+
+    /** 在工作线程上读取可用的数据，不应长时间阻塞；没有新数据时返回0，数据源已断开时返回-1 */
+    virtual int32 Read(uint8* Buffer, int32 BufferSize) = 0;
+
+    /** 在工作线程上关闭数据源 */
+    virtual void Close() = 0;
+
+private:
+    /** 解析Pending中的完整行并放入队列 */
+    void ParseLines();
+
+    TQueue<FXVLiveSample, EQueueMode::Spsc> Queue;
+
+    /** 尚未遇到换行符的数据 */
+    TArray<ANSICHAR> Pending;
+
+    /** 正在丢弃超长的行，遇到下一个换行符后恢复解析 */
+    bool bDiscardingLine = false;
+
+    /** 超长行的警告只输出一次 */
+    bool bWarnedLongLine = false;
+
+    FRunnableThread* Thread = nullptr;
+    std::atomic<bool> bStopRequested{false};
+};
+
+/**
+ * 跟踪只追加写入的文本文件，读取新写入的行
+ * 文件变短时视为被重写，从头开始读取
+ */
+class XRVIS_API FXVFileTailLiveDataSource : public FXVLineLiveDataSource
+{
+public:
+    /** @param bInStartAtEnd - 为true时忽略文件中已有的内容 */
+    explicit FXVFileTailLiveDataSource(const FString& InFilePath, bool bInStartAtEnd = true);
+    virtual ~FXVFileTailLiveDataSource() override;
+
+    virtual FString GetDescription() const override;
+
+protected:
+    virtual bool Open() override;
+    virtual int32 Read(uint8* Buffer, int32 BufferSize) override;
+    virtual void Close() override;
+
+private:
+    FString FilePath;
+
+    /** 只对第一次打开生效，重新打开时从头读取 */
+    bool bStartAtEnd;
+    TUniquePtr<IFileHandle> FileHandle;
+    int64 ReadPosition = 0;
+};
+
+/**
+ * 从本地命名管道读取数据
+ * Windows上PipeName为管道名（\\.\pipe\之后的部分）；其他平台上为FIFO或Unix域套接字的路径
+ */
+class XRVIS_API FXVNamedPipeLiveDataSource : public FXVLineLiveDataSource
+{
+public:
+    explicit FXVNamedPipeLiveDataSource(const FString& InPipeName);
+    virtual ~FXVNamedPipeLiveDataSource() override;
+
+    virtual FString GetDescription() const override;
+
+protected:
+    virtual bool Open() override;
+    virtual int32 Read(uint8* Buffer, int32 BufferSize) override;
+    virtual void Close() override;
+
+private:
+    FString PipeName;
+
+    /** Windows上的管道句柄 */
+    void* PipeHandle = nullptr;
+
+    /** 其他平台上的文件描述符，以及它是否为Unix域套接字 */
+    int32 PipeDescriptor = -1;
+    bool bIsSocket = false;
+};
+
+/**
+ * 连接本机回环地址上的TCP服务，读取其发送的数据
+ */
+class XRVIS_API FXVTcpLiveDataSource : public FXVLineLiveDataSource
+{
+public:
+    explicit FXVTcpLiveDataSource(int32 InPort);
+    virtual ~FXVTcpLiveDataSource() override;
+
+    virtual FString GetDescription() const override;
+
+protected:
+    virtual bool Open() override;
+    virtual int32 Read(uint8* Buffer, int32 BufferSize) override;
+    virtual void Close() override;
+
+private:
+    int32 Port;
+    FSocket* Socket = nullptr;
+};
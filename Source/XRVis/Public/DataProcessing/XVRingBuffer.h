@@ -0,0 +1,88 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 固定容量的环形缓冲区
+ * 写满后新元素覆盖最旧的元素，追加和按序访问都是O(1)；元素的存储位置（Slot）在被覆盖前保持不变，
+ * 调用方可以用它关联与元素一一对应的外部资源（例如网格段）。
+ */
+template <typename ElementType>
+class TXVRingBuffer
+{
+public:
+    TXVRingBuffer() = default;
+
+    explicit TXVRingBuffer(int32 InCapacity)
+    {
+        SetCapacity(InCapacity);
+    }
+
+    /** 重新设置容量，已有元素会被清空 */
+    void SetCapacity(int32 InCapacity)
+    {
+        check(InCapacity >= 0);
+        Storage.Reset();
+        Storage.SetNum(InCapacity);
+        Head = 0;
+        Count = 0;
+    }
+
+    /** 清空元素，保留容量 */
+    void Reset()
+    {
+        Head = 0;
+        Count = 0;
+    }
+
+    int32 Capacity() const { return Storage.Num(); }
+    int32 Num() const { return Count; }
+    bool IsEmpty() const { return Count == 0; }
+    bool IsFull() const { return Count == Storage.Num(); }
+
+    /** 追加元素，返回写入的存储位置；缓冲区已满时覆盖最旧的元素 */
+    int32 Push(const ElementType& Element)
+    {
+        check(Storage.Num() > 0);
+        const int32 Slot = GetSlot(Count == Storage.Num() ? 0 : Count);
+        Storage[Slot] = Element;
+        if (Count < Storage.Num())
+        {
+            ++Count;
+        }
+        else
+        {
+            Head = (Head + 1) % Storage.Num();
+        }
+        return Slot;
+    }
+
+    /** 按时间顺序的第Index个元素的存储位置，0为最旧的元素 */
+    int32 GetSlot(int32 Index) const
+    {
+        return (Head + Index) % Storage.Num();
+    }
+
+    /** 按时间顺序访问，0为最旧的元素 */
+    const ElementType& operator[](int32 Index) const
+    {
+        checkSlow(Index >= 0 && Index < Count);
+        return Storage[GetSlot(Index)];
+    }
+
+    /** 按存储位置访问 */
+    const ElementType& GetBySlot(int32 Slot) const
+    {
+        return Storage[Slot];
+    }
+
+    const ElementType& First() const { return (*this)[0]; }
+    const ElementType& Last() const { return (*this)[Count - 1]; }
+
+private:
+    TArray<ElementType> Storage;
+
+    /** 最旧元素的存储位置 */
+    int32 Head = 0;
+    int32 Count = 0;
+};
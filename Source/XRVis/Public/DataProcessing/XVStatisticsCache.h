@@ -0,0 +1,82 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 图表数据的统计缓存，读取数量、总和、平均值、最小值、最大值和中位数都是O(1)
+ * Build一次遍历建立缓存，中位数用nth_element划分；之后单个值的增删改为O(log n)：
+ * 中位数由一对大顶堆/小顶堆维护，被删除的值延迟到堆顶时才真正移除；最小值和最大值记录出现次数，
+ * 只有最后一个最小值（最大值）被删除时才重新扫描。
+ */
+struct XRVIS_API FXVStatisticsCache
+{
+public:
+    /** 按一组值重建缓存 */
+    void Build(TConstArrayView<float> Values);
+
+    /** 清空缓存 */
+    void Reset();
+
+    /** 加入一个值 */
+    void Add(float Value);
+
+    /** 移除一个值，调用方需保证该值存在 */
+    void Remove(float Value);
+
+    /** 将一个已存在的值替换为新值 */
+    void Replace(float OldValue, float NewValue);
+
+    int32 Num() const { return Count; }
+
+    bool IsEmpty() const { return Count == 0; }
+
+    double GetSum() const { return Sum; }
+
+    /** 平均值，没有数据时为0 */
+    float GetMean() const { return Count > 0 ? static_cast<float>(Sum / Count) : 0.f; }
+
+    /** 中位数，偶数个值时取中间两个值的平均，没有数据时为0 */
+    float GetMedian() const;
+
+    /** 最小值，没有数据时为0 */
+    float GetMin() const { return Count > 0 ? MinValue : 0.f; }
+
+    /** 最大值，没有数据时为0 */
+    float GetMax() const { return Count > 0 ? MaxValue : 0.f; }
+
+private:
+    /** 弹出堆顶已被删除的值 */
+    template <typename PredicateType>
+    void PruneHeap(TArray<float>& Heap, const PredicateType& Predicate);
+
+    /** 使较小一半的数量等于较大一半或多一个 */
+    void Rebalance();
+
+    /** 按堆中仍然有效的值重新统计最小值和最大值 */
+    void RecomputeRange();
+
+    /** 延迟删除的值过多时按有效值重建两个堆 */
+    void CompactIfNeeded();
+
+    /** 较小的一半，大顶堆 */
+    TArray<float> LowerHeap;
+
+    /** 较大的一半，小顶堆 */
+    TArray<float> UpperHeap;
+
+    /** 已删除但仍留在堆中的值及其个数 */
+    TMap<float, int32> PendingRemovals;
+    int32 NumPendingRemovals = 0;
+
+    /** 两个堆中有效值的数量 */
+    int32 LowerCount = 0;
+    int32 UpperCount = 0;
+
+    int32 Count = 0;
+    double Sum = 0.0;
+
+    float MinValue = 0.f;
+    float MaxValue = 0.f;
+    int32 MinCount = 0;
+    int32 MaxCount = 0;
+};
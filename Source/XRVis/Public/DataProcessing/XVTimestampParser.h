@@ -0,0 +1,55 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 时间戳文本解析器，结果为FDateTime的Ticks（UTC）
+ * 支持 YYYY-MM-DD、YYYY/MM/DD、YYYY.MM.DD，可选的 [空格|T]HH:MM[:SS[.fffffff]]，以及可选的 Z 或 ±HH[:]MM 时区
+ * 第一次解析的值作为样本检测格式，之后同一列的值先按检测到的定长格式直接读取各字段，
+ * 格式不一致时再按通用规则解析；整个过程不分配内存
+ */
+class XRVIS_API FXVTimestampParser
+{
+public:
+    /** 解析一个值，尚未检测格式时以该值作为样本 */
+    bool Parse(FStringView Text, int64& OutTicks);
+
+    /** 清除检测到的格式 */
+    void Reset();
+
+    /** 不使用格式缓存的通用解析 */
+    static bool TryParse(FStringView Text, int64& OutTicks);
+
+private:
+    /** 从样本检测到的定长格式 */
+    struct FFormat
+    {
+        /** 文本长度，0表示样本不是定长格式（月、日或小时不足两位） */
+        int32 Length = 0;
+
+        /** 年月日之间的分隔符 */
+        TCHAR DateSeparator = 0;
+
+        /** 日期与时间之间的分隔符，0表示只有日期 */
+        TCHAR TimeSeparator = 0;
+
+        bool bHasSeconds = false;
+
+        /** 小数秒的位数，0表示没有小数部分 */
+        int32 FractionDigits = 0;
+
+        /** 时区后缀的长度：0、1（Z）、5（±HHMM）或6（±HH:MM） */
+        int32 ZoneLength = 0;
+    };
+
+    /** 通用解析，同时输出文本的格式 */
+    static bool ParseGeneric(FStringView Text, int64& OutTicks, FFormat& OutFormat);
+
+    /** 按检测到的定长格式解析，长度或分隔符不符时返回false */
+    bool ParseFixed(FStringView Text, int64& OutTicks) const;
+
+    FFormat Format;
+
+    /** 是否已经用样本检测过格式 */
+    bool bDetected = false;
+};
@@ -59,7 +59,8 @@ public class XRVis : ModuleRules
 				"UMG",
                 "Slate",
                 "SlateCore",
-                "DesktopPlatform", "DatasmithCore"
+                "DesktopPlatform", "DatasmithCore",
+                "Sockets"
                 // ... add private dependencies that you statically link with here ...	
 			}
 			);
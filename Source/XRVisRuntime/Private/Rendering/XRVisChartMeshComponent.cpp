@@ -0,0 +1,590 @@
+﻿#include "Rendering/XRVisChartMeshComponent.h"
+
+#include "DynamicMeshBuilder.h"
+#include "LocalVertexFactory.h"
+#include "MaterialShared.h"
+#include "PrimitiveSceneProxy.h"
+#include "RenderingThread.h"
+#include "SceneInterface.h"
+#include "SceneManagement.h"
+#include "StaticMeshResources.h"
+#include "Engine/Engine.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialRenderProxy.h"
+#include "PhysicsEngine/BodySetup.h"
+
+/**
+ * 一个网格段的渲染资源：顶点缓冲区不保留CPU端数据，索引上传后也会释放
+ * 在游戏线程上创建并写入，初始化后只在渲染线程上访问和销毁
+ */
+class FXRVisChartMeshSectionResources
+{
+public:
+	FXRVisChartMeshSectionResources(int32 InNumVertices, int32 InNumIndices, int32 NumTexCoords)
+		: NumVertices(InNumVertices)
+		, NumIndices(InNumIndices)
+	{
+		VertexBuffers.PositionVertexBuffer.Init(NumVertices, false);
+		VertexBuffers.StaticMeshVertexBuffer.Init(NumVertices, NumTexCoords, false);
+		VertexBuffers.ColorVertexBuffer.Init(NumVertices, false);
+		IndexBuffer.Indices.SetNumUninitialized(NumIndices);
+	}
+
+	~FXRVisChartMeshSectionResources()
+	{
+		if (VertexFactory.IsValid())
+		{
+			VertexFactory->ReleaseResource();
+			VertexBuffers.PositionVertexBuffer.ReleaseResource();
+			VertexBuffers.StaticMeshVertexBuffer.ReleaseResource();
+			VertexBuffers.ColorVertexBuffer.ReleaseResource();
+			IndexBuffer.ReleaseResource();
+		}
+	}
+
+	void InitResources(FRHICommandListBase& RHICmdList, ERHIFeatureLevel::Type FeatureLevel)
+	{
+		VertexBuffers.PositionVertexBuffer.InitResource(RHICmdList);
+		VertexBuffers.StaticMeshVertexBuffer.InitResource(RHICmdList);
+		VertexBuffers.ColorVertexBuffer.InitResource(RHICmdList);
+		IndexBuffer.InitResource(RHICmdList);
+		// 索引已上传到GPU，释放CPU端的副本
+		IndexBuffer.Indices.Empty();
+
+		VertexFactory = MakeUnique<FLocalVertexFactory>(FeatureLevel, "FXRVisChartMeshSection");
+		FLocalVertexFactory::FDataType Data;
+		VertexBuffers.PositionVertexBuffer.BindPositionVertexBuffer(VertexFactory.Get(), Data);
+		VertexBuffers.StaticMeshVertexBuffer.BindTangentVertexBuffer(VertexFactory.Get(), Data);
+		VertexBuffers.StaticMeshVertexBuffer.BindPackedTexCoordVertexBuffer(VertexFactory.Get(), Data);
+		VertexBuffers.StaticMeshVertexBuffer.BindLightMapVertexBuffer(VertexFactory.Get(), Data, 0);
+		VertexBuffers.ColorVertexBuffer.BindColorVertexBuffer(VertexFactory.Get(), Data);
+		VertexFactory->SetData(RHICmdList, Data);
+		VertexFactory->InitResource(RHICmdList);
+	}
+
+	/* 只锁定修改的顶点范围，逐个缓冲区写入 */
+	void UpdateVertices(FRHICommandListImmediate& RHICmdList, const FXRVisChartMeshVertexUpdate& Update)
+	{
+		check(!VertexBuffers.StaticMeshVertexBuffer.GetUseHighPrecisionTangentBasis());
+		const int32 NumUpdated = Update.Num();
+		auto WriteRange = [&RHICmdList, &Update, NumUpdated](FRHIBuffer* Buffer, const void* Source, uint32 Stride)
+		{
+			void* Dest = RHICmdList.LockBuffer(Buffer, Update.FirstVertex * Stride, NumUpdated * Stride, RLM_WriteOnly);
+			FMemory::Memcpy(Dest, Source, NumUpdated * Stride);
+			RHICmdList.UnlockBuffer(Buffer);
+		};
+		WriteRange(VertexBuffers.PositionVertexBuffer.VertexBufferRHI, Update.Positions.GetData(), sizeof(FVector3f));
+		WriteRange(VertexBuffers.StaticMeshVertexBuffer.TangentsVertexBuffer.VertexBufferRHI, Update.TangentBasis.GetData(), 2 * sizeof(FPackedNormal));
+		WriteRange(VertexBuffers.ColorVertexBuffer.VertexBufferRHI, Update.Colors.GetData(), sizeof(FColor));
+	}
+
+	FStaticMeshVertexBuffers VertexBuffers;
+	FDynamicMeshIndexBuffer32 IndexBuffer;
+	TUniquePtr<FLocalVertexFactory> VertexFactory;
+	int32 NumVertices;
+	int32 NumIndices;
+	bool bVisible = true;
+};
+
+/**
+ * 组件的所有网格段资源，Sections只在渲染线程上修改和读取
+ */
+class FXRVisChartMeshRenderData
+{
+public:
+	TArray<TUniquePtr<FXRVisChartMeshSectionResources>> Sections;
+
+	FXRVisChartMeshSectionResources* GetSection(int32 SectionIndex) const
+	{
+		return Sections.IsValidIndex(SectionIndex) ? Sections[SectionIndex].Get() : nullptr;
+	}
+};
+
+/**
+ * 图表网格组件的场景代理，只引用组件的网格段资源，自身不持有顶点数据
+ */
+class FXRVisChartMeshSceneProxy final : public FPrimitiveSceneProxy
+{
+public:
+	FXRVisChartMeshSceneProxy(UXRVisChartMeshComponent* Component)
+		: FPrimitiveSceneProxy(Component)
+		, RenderData(Component->RenderData)
+		, MaterialRelevance(Component->GetMaterialRelevance(GetScene().GetFeatureLevel()))
+	{
+		Materials.SetNum(Component->Sections.Num());
+		for (int32 SectionIndex = 0; SectionIndex < Materials.Num(); ++SectionIndex)
+		{
+			UMaterialInterface* Material = Component->GetMaterial(SectionIndex);
+			Materials[SectionIndex] = Material ? Material : UMaterial::GetDefaultMaterial(MD_Surface);
+		}
+	}
+
+	virtual SIZE_T GetTypeHash() const override
+	{
+		static size_t UniquePointer;
+		return reinterpret_cast<size_t>(&UniquePointer);
+	}
+
+	virtual void GetDynamicMeshElements(const TArray<const FSceneView*>& Views, const FSceneViewFamily& ViewFamily, uint32 VisibilityMap,
+	                                    FMeshElementCollector& Collector) const override
+	{
+		const bool bWireframe = AllowDebugViewmodes() && ViewFamily.EngineShowFlags.Wireframe;
+		FColoredMaterialRenderProxy* WireframeMaterialInstance = nullptr;
+		if (bWireframe)
+		{
+			WireframeMaterialInstance = new FColoredMaterialRenderProxy(
+				GEngine->WireframeMaterial ? GEngine->WireframeMaterial->GetRenderProxy() : nullptr, FLinearColor(0, 0.5f, 1.f));
+			Collector.RegisterOneFrameMaterialProxy(WireframeMaterialInstance);
+		}
+
+		// 所有网格段共用一个图元uniform buffer
+		bool bHasPrecomputedVolumetricLightmap;
+		FMatrix PreviousLocalToWorld;
+		int32 SingleCaptureIndex;
+		bool bOutputVelocity;
+		GetScene().GetPrimitiveUniformShaderParameters_RenderThread(GetPrimitiveSceneInfo(), bHasPrecomputedVolumetricLightmap, PreviousLocalToWorld,
+		                                                           SingleCaptureIndex, bOutputVelocity);
+		bOutputVelocity |= AlwaysHasVelocity();
+		FDynamicPrimitiveUniformBuffer& DynamicPrimitiveUniformBuffer = Collector.AllocateOneFrameResource<FDynamicPrimitiveUniformBuffer>();
+		DynamicPrimitiveUniformBuffer.Set(Collector.GetRHICommandList(), GetLocalToWorld(), PreviousLocalToWorld, GetBounds(), GetLocalBounds(),
+		                                  GetLocalBounds(), true, bHasPrecomputedVolumetricLightmap, bOutputVelocity, GetCustomPrimitiveData());
+
+		// 代理创建之后新增的网格段在代理重建前没有材质，暂不绘制
+		const int32 NumSections = FMath::Min(Materials.Num(), RenderData->Sections.Num());
+		for (int32 SectionIndex = 0; SectionIndex < NumSections; ++SectionIndex)
+		{
+			const FXRVisChartMeshSectionResources* Section = RenderData->GetSection(SectionIndex);
+			if (!Section || !Section->bVisible)
+			{
+				continue;
+			}
+
+			FMaterialRenderProxy* MaterialProxy = bWireframe ? WireframeMaterialInstance : Materials[SectionIndex]->GetRenderProxy();
+			for (int32 ViewIndex = 0; ViewIndex < Views.Num(); ++ViewIndex)
+			{
+				if (!(VisibilityMap & (1 << ViewIndex)))
+				{
+					continue;
+				}
+
+				FMeshBatch& Mesh = Collector.AllocateMesh();
+				FMeshBatchElement& BatchElement = Mesh.Elements[0];
+				BatchElement.IndexBuffer = &Section->IndexBuffer;
+				BatchElement.PrimitiveUniformBufferResource = &DynamicPrimitiveUniformBuffer.UniformBuffer;
+				BatchElement.FirstIndex = 0;
+				BatchElement.NumPrimitives = Section->NumIndices / 3;
+				BatchElement.MinVertexIndex = 0;
+				BatchElement.MaxVertexIndex = Section->NumVertices - 1;
+				Mesh.bWireframe = bWireframe;
+				Mesh.VertexFactory = Section->VertexFactory.Get();
+				Mesh.MaterialRenderProxy = MaterialProxy;
+				Mesh.ReverseCulling = IsLocalToWorldDeterminantNegative();
+				Mesh.Type = PT_TriangleList;
+				Mesh.DepthPriorityGroup = SDPG_World;
+				Mesh.bCanApplyViewModeOverrides = false;
+				Collector.AddMesh(ViewIndex, Mesh);
+			}
+		}
+	}
+
+	virtual FPrimitiveViewRelevance GetViewRelevance(const FSceneView* View) const override
+	{
+		FPrimitiveViewRelevance Result;
+		Result.bDrawRelevance = IsShown(View);
+		Result.bShadowRelevance = IsShadowCast(View);
+		Result.bDynamicRelevance = true;
+		Result.bRenderInMainPass = ShouldRenderInMainPass();
+		Result.bUsesLightingChannels = GetLightingChannelMask() != GetDefaultLightingChannelMask();
+		Result.bRenderCustomDepth = ShouldRenderCustomDepth();
+		Result.bTranslucentSelfShadow = bCastVolumetricTranslucentShadow;
+		MaterialRelevance.SetPrimitiveViewRelevance(Result);
+		Result.bVelocityRelevance = DrawsVelocity() && Result.bOpaque && Result.bRenderInMainPass;
+		return Result;
+	}
+
+	virtual bool CanBeOccluded() const override
+	{
+		return !MaterialRelevance.bDisableDepthTest;
+	}
+
+	virtual uint32 GetMemoryFootprint() const override
+	{
+		return sizeof(*this) + GetAllocatedSize();
+	}
+
+	uint32 GetAllocatedSize() const
+	{
+		return FPrimitiveSceneProxy::GetAllocatedSize() + Materials.GetAllocatedSize();
+	}
+
+private:
+	TSharedPtr<FXRVisChartMeshRenderData, ESPMode::ThreadSafe> RenderData;
+	TArray<UMaterialInterface*> Materials;
+	FMaterialRelevance MaterialRelevance;
+};
+
+FXRVisChartMeshSectionData::FXRVisChartMeshSectionData(int32 InNumVertices, int32 InNumIndices, int32 InNumTexCoords)
+	: Resources(MakeUnique<FXRVisChartMeshSectionResources>(InNumVertices, InNumIndices, InNumTexCoords))
+	, NumVertices(InNumVertices)
+	, NumIndices(InNumIndices)
+	, LocalBox(ForceInit)
+{
+}
+
+FXRVisChartMeshSectionData::~FXRVisChartMeshSectionData()
+{
+}
+
+void FXRVisChartMeshSectionData::SetVertex(int32 VertexIndex, const FVector3f& Position, const FVector3f& Normal, const FVector3f& Tangent,
+                                           const FColor& Color)
+{
+	FStaticMeshVertexBuffers& VertexBuffers = Resources->VertexBuffers;
+	VertexBuffers.PositionVertexBuffer.VertexPosition(VertexIndex) = Position;
+	VertexBuffers.StaticMeshVertexBuffer.SetVertexTangents(VertexIndex, Tangent, Normal ^ Tangent, Normal);
+	VertexBuffers.ColorVertexBuffer.VertexColor(VertexIndex) = Color;
+	LocalBox += Position;
+}
+
+void FXRVisChartMeshSectionData::SetTexCoord(int32 VertexIndex, int32 TexCoordIndex, const FVector2f& UV)
+{
+	Resources->VertexBuffers.StaticMeshVertexBuffer.SetVertexUV(VertexIndex, TexCoordIndex, UV);
+}
+
+uint32* FXRVisChartMeshSectionData::GetIndexData()
+{
+	return Resources->IndexBuffer.Indices.GetData();
+}
+
+void FXRVisChartMeshVertexUpdate::Init(int32 InFirstVertex, int32 NumVertices)
+{
+	FirstVertex = InFirstVertex;
+	Positions.SetNumUninitialized(NumVertices);
+	TangentBasis.SetNumUninitialized(NumVertices * 2);
+	Colors.SetNumUninitialized(NumVertices);
+}
+
+void FXRVisChartMeshVertexUpdate::SetVertex(int32 Index, const FVector3f& Position, const FVector3f& Normal, const FVector3f& Tangent,
+                                            const FColor& Color)
+{
+	Positions[Index] = Position;
+	// 法线的W分量为副切线的符号，与SetVertexTangents的结果一致
+	TangentBasis[Index * 2] = FPackedNormal(Tangent);
+	TangentBasis[Index * 2 + 1] = FPackedNormal(FVector4f(Normal, GetBasisDeterminantSign(FVector(Tangent), FVector(Normal ^ Tangent), FVector(Normal))));
+	Colors[Index] = Color;
+}
+
+UXRVisChartMeshComponent::UXRVisChartMeshComponent(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer)
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	RenderData = MakeShared<FXRVisChartMeshRenderData, ESPMode::ThreadSafe>();
+}
+
+void UXRVisChartMeshComponent::CreateSection(int32 SectionIndex, TUniquePtr<FXRVisChartMeshSectionData> Data, bool bCreateCollision)
+{
+	check(SectionIndex >= 0 && Data.IsValid());
+	if (Data->GetNumVertices() == 0 || Data->GetNumIndices() == 0)
+	{
+		ClearSection(SectionIndex);
+		return;
+	}
+
+	if (SectionIndex >= Sections.Num())
+	{
+		Sections.SetNum(SectionIndex + 1);
+	}
+	FSectionInfo& Section = Sections[SectionIndex];
+	const bool bHadCollision = Section.bValid && Section.bCreateCollision;
+	Section.LocalBox = Data->GetLocalBox();
+	Section.bValid = true;
+	Section.bCreateCollision = bCreateCollision;
+
+	// 资源交给渲染线程前复制位置和碰撞需要的索引，上传后渲染资源不再保留CPU数据
+	const FPositionVertexBuffer& PositionBuffer = Data->Resources->VertexBuffers.PositionVertexBuffer;
+	Section.Positions.SetNumUninitialized(Data->GetNumVertices());
+	for (int32 VertexIndex = 0; VertexIndex < Section.Positions.Num(); ++VertexIndex)
+	{
+		Section.Positions[VertexIndex] = PositionBuffer.VertexPosition(VertexIndex);
+	}
+	if (bCreateCollision)
+	{
+		Section.Indices = Data->Resources->IndexBuffer.Indices;
+	}
+	else
+	{
+		Section.Indices.Empty();
+	}
+
+	// 资源的所有权交给渲染线程，替换下来的旧资源在渲染线程上释放
+	UWorld* World = GetWorld();
+	const ERHIFeatureLevel::Type FeatureLevel = World ? World->GetFeatureLevel() : GMaxRHIFeatureLevel;
+	FXRVisChartMeshSectionResources* Resources = Data->Resources.Release();
+	ENQUEUE_RENDER_COMMAND(XRVisChartMeshCreateSection)(
+		[RenderData = RenderData, SectionIndex, Resources, FeatureLevel](FRHICommandListImmediate& RHICmdList)
+		{
+			Resources->InitResources(RHICmdList, FeatureLevel);
+			if (SectionIndex >= RenderData->Sections.Num())
+			{
+				RenderData->Sections.SetNum(SectionIndex + 1);
+			}
+			RenderData->Sections[SectionIndex].Reset(Resources);
+		});
+
+	if (bCreateCollision || bHadCollision)
+	{
+		MarkCollisionDirty();
+	}
+	UpdateLocalBounds();
+	if (SectionIndex >= NumProxySections)
+	{
+		MarkRenderStateDirty();
+	}
+}
+
+void UXRVisChartMeshComponent::UpdateSectionVertices(int32 SectionIndex, FXRVisChartMeshVertexUpdate&& Update)
+{
+	if (!Sections.IsValidIndex(SectionIndex) || !Sections[SectionIndex].bValid || Update.Num() == 0)
+	{
+		return;
+	}
+
+	FSectionInfo& Section = Sections[SectionIndex];
+	if (Update.FirstVertex < 0 || Update.FirstVertex + Update.Num() > Section.NumVertices())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("UXRVisChartMeshComponent: 更新的顶点范围[%d, %d)超出网格段%d的%d个顶点"),
+		       Update.FirstVertex, Update.FirstVertex + Update.Num(), SectionIndex, Section.NumVertices());
+		return;
+	}
+
+	// 更新范围原来贴着包围盒某一面而更新后离开该面时，包围盒需要按所有顶点重新计算，否则只需扩大
+	FBox3f OldRangeBox(ForceInit);
+	FBox3f NewRangeBox(ForceInit);
+	for (int32 Index = 0; Index < Update.Num(); ++Index)
+	{
+		FVector3f& Position = Section.Positions[Update.FirstVertex + Index];
+		OldRangeBox += Position;
+		NewRangeBox += Update.Positions[Index];
+		Position = Update.Positions[Index];
+	}
+	bool bShrunk = false;
+	for (int32 Axis = 0; Axis < 3 && !bShrunk; ++Axis)
+	{
+		bShrunk = (OldRangeBox.Min[Axis] <= Section.LocalBox.Min[Axis] && NewRangeBox.Min[Axis] > Section.LocalBox.Min[Axis]) ||
+			(OldRangeBox.Max[Axis] >= Section.LocalBox.Max[Axis] && NewRangeBox.Max[Axis] < Section.LocalBox.Max[Axis]);
+	}
+	if (bShrunk)
+	{
+		Section.LocalBox = FBox3f(Section.Positions);
+	}
+	else
+	{
+		Section.LocalBox += NewRangeBox;
+	}
+
+	ENQUEUE_RENDER_COMMAND(XRVisChartMeshUpdateSection)(
+		[RenderData = RenderData, SectionIndex, Update = MoveTemp(Update)](FRHICommandListImmediate& RHICmdList)
+		{
+			if (FXRVisChartMeshSectionResources* Resources = RenderData->GetSection(SectionIndex))
+			{
+				Resources->UpdateVertices(RHICmdList, Update);
+			}
+		});
+
+	if (Section.bCreateCollision)
+	{
+		MarkCollisionDirty();
+	}
+	UpdateLocalBounds();
+}
+
+void UXRVisChartMeshComponent::ClearSection(int32 SectionIndex)
+{
+	if (!Sections.IsValidIndex(SectionIndex) || !Sections[SectionIndex].bValid)
+	{
+		return;
+	}
+
+	if (Sections[SectionIndex].bCreateCollision)
+	{
+		MarkCollisionDirty();
+	}
+	Sections[SectionIndex] = FSectionInfo();
+
+	ENQUEUE_RENDER_COMMAND(XRVisChartMeshClearSection)(
+		[RenderData = RenderData, SectionIndex](FRHICommandListImmediate& RHICmdList)
+		{
+			if (RenderData->Sections.IsValidIndex(SectionIndex))
+			{
+				RenderData->Sections[SectionIndex].Reset();
+			}
+		});
+	UpdateLocalBounds();
+}
+
+void UXRVisChartMeshComponent::ClearAllSections()
+{
+	if (Sections.Num() == 0)
+	{
+		return;
+	}
+
+	Sections.Empty();
+	ENQUEUE_RENDER_COMMAND(XRVisChartMeshClearAllSections)(
+		[RenderData = RenderData](FRHICommandListImmediate& RHICmdList)
+		{
+			RenderData->Sections.Empty();
+		});
+	MarkCollisionDirty();
+	UpdateLocalBounds();
+}
+
+void UXRVisChartMeshComponent::SetSectionVisible(int32 SectionIndex, bool bNewVisibility)
+{
+	if (!Sections.IsValidIndex(SectionIndex) || !Sections[SectionIndex].bValid)
+	{
+		return;
+	}
+
+	ENQUEUE_RENDER_COMMAND(XRVisChartMeshSetSectionVisible)(
+		[RenderData = RenderData, SectionIndex, bNewVisibility](FRHICommandListImmediate& RHICmdList)
+		{
+			if (FXRVisChartMeshSectionResources* Resources = RenderData->GetSection(SectionIndex))
+			{
+				Resources->bVisible = bNewVisibility;
+			}
+		});
+}
+
+FPrimitiveSceneProxy* UXRVisChartMeshComponent::CreateSceneProxy()
+{
+	NumProxySections = Sections.Num();
+	return new FXRVisChartMeshSceneProxy(this);
+}
+
+UBodySetup* UXRVisChartMeshComponent::GetBodySetup()
+{
+	return BodySetup;
+}
+
+int32 UXRVisChartMeshComponent::GetNumMaterials() const
+{
+	return FMath::Max(Sections.Num(), OverrideMaterials.Num());
+}
+
+FBoxSphereBounds UXRVisChartMeshComponent::CalcBounds(const FTransform& LocalToWorld) const
+{
+	if (!LocalBounds.IsValid)
+	{
+		return FBoxSphereBounds(LocalToWorld.GetLocation(), FVector::ZeroVector, 0);
+	}
+	return FBoxSphereBounds(FBox(LocalBounds)).TransformBy(LocalToWorld);
+}
+
+void UXRVisChartMeshComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (bCollisionDirty)
+	{
+		UpdateCollision();
+	}
+	SetComponentTickEnabled(false);
+}
+
+void UXRVisChartMeshComponent::BeginDestroy()
+{
+	Super::BeginDestroy();
+
+	// 网格段资源只能在渲染线程上释放，组件的引用交给渲染命令释放
+	if (RenderData.IsValid())
+	{
+		ENQUEUE_RENDER_COMMAND(XRVisChartMeshReleaseRenderData)(
+			[RenderData = MoveTemp(RenderData)](FRHICommandListImmediate& RHICmdList) mutable
+			{
+				RenderData.Reset();
+			});
+	}
+}
+
+void UXRVisChartMeshComponent::UpdateLocalBounds()
+{
+	LocalBounds = FBox3f(ForceInit);
+	for (const FSectionInfo& Section : Sections)
+	{
+		if (Section.bValid)
+		{
+			LocalBounds += Section.LocalBox;
+		}
+	}
+	UpdateBounds();
+	MarkRenderTransformDirty();
+}
+
+void UXRVisChartMeshComponent::MarkCollisionDirty()
+{
+	bCollisionDirty = true;
+	SetComponentTickEnabled(true);
+}
+
+void UXRVisChartMeshComponent::UpdateCollision()
+{
+	bCollisionDirty = false;
+	if (!BodySetup)
+	{
+		BodySetup = NewObject<UBodySetup>(this, NAME_None, RF_Transient);
+		BodySetup->bGenerateMirroredCollision = false;
+		BodySetup->bDoubleSidedGeometry = true;
+		BodySetup->CollisionTraceFlag = CTF_UseComplexAsSimple;
+	}
+
+	// 三角形数据在烘焙时通过GetPhysicsTriMeshData读取
+	BodySetup->BodySetupGuid = FGuid::NewGuid();
+	BodySetup->bHasCookedCollisionData = true;
+	BodySetup->InvalidatePhysicsData();
+	BodySetup->CreatePhysicsMeshes();
+	RecreatePhysicsState();
+}
+
+bool UXRVisChartMeshComponent::GetPhysicsTriMeshData(FTriMeshCollisionData* CollisionData, bool InUseAllTriData)
+{
+	bool bHasData = false;
+	for (int32 SectionIndex = 0; SectionIndex < Sections.Num(); ++SectionIndex)
+	{
+		const FSectionInfo& Section = Sections[SectionIndex];
+		if (!Section.bValid || !Section.bCreateCollision)
+		{
+			continue;
+		}
+
+		const int32 VertexBase = CollisionData->Vertices.Num();
+		CollisionData->Vertices.Append(Section.Positions);
+		for (int32 Index = 0; Index + 2 < Section.Indices.Num(); Index += 3)
+		{
+			FTriIndices& Triangle = CollisionData->Indices.AddDefaulted_GetRef();
+			Triangle.v0 = VertexBase + Section.Indices[Index];
+			Triangle.v1 = VertexBase + Section.Indices[Index + 1];
+			Triangle.v2 = VertexBase + Section.Indices[Index + 2];
+			CollisionData->MaterialIndices.Add(SectionIndex);
+		}
+		bHasData = true;
+	}
+
+	// 与程序化网格组件相同，图表的三角形按其绕序需要翻转法线
+	CollisionData->bFlipNormals = true;
+	CollisionData->bDeformableMesh = true;
+	CollisionData->bFastCook = true;
+	return bHasData;
+}
+
+bool UXRVisChartMeshComponent::ContainsPhysicsTriMeshData(bool InUseAllTriData) const
+{
+	for (const FSectionInfo& Section : Sections)
+	{
+		if (Section.bValid && Section.bCreateCollision && Section.Indices.Num() >= 3)
+		{
+			return true;
+		}
+	}
+	return false;
+}
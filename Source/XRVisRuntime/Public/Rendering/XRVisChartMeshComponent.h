@@ -0,0 +1,163 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "PackedNormal.h"
+#include "Components/MeshComponent.h"
+#include "Interfaces/Interface_CollisionDataProvider.h"
+#include "XRVisChartMeshComponent.generated.h"
+
+class FXRVisChartMeshRenderData;
+class FXRVisChartMeshSectionResources;
+class UBodySetup;
+
+/**
+ * 一个网格段的顶点和索引数据，按确定的顶点数和索引数分配后由调用方直接写入
+ * 顶点以紧凑格式存储：单精度位置、压缩的法线和切线、半精度UV、8位颜色
+ * 数据直接写入渲染资源，提交给UXRVisChartMeshComponent后上传到GPU，CPU端的副本随即释放；组件只保留位置和有碰撞网格段的索引
+ */
+class XRVISRUNTIME_API FXRVisChartMeshSectionData
+{
+public:
+	FXRVisChartMeshSectionData(int32 InNumVertices, int32 InNumIndices, int32 InNumTexCoords = 1);
+	~FXRVisChartMeshSectionData();
+
+	/* 写入一个顶点的位置、法线、切线和颜色 */
+	void SetVertex(int32 VertexIndex, const FVector3f& Position, const FVector3f& Normal, const FVector3f& Tangent, const FColor& Color);
+
+	/* 写入一个顶点的第TexCoordIndex套UV */
+	void SetTexCoord(int32 VertexIndex, int32 TexCoordIndex, const FVector2f& UV);
+
+	/* 索引数组的起始地址，共GetNumIndices个 */
+	uint32* GetIndexData();
+
+	int32 GetNumVertices() const { return NumVertices; }
+	int32 GetNumIndices() const { return NumIndices; }
+
+	/* 已写入顶点的包围盒 */
+	const FBox3f& GetLocalBox() const { return LocalBox; }
+
+private:
+	friend class UXRVisChartMeshComponent;
+
+	TUniquePtr<FXRVisChartMeshSectionResources> Resources;
+	int32 NumVertices;
+	int32 NumIndices;
+	FBox3f LocalBox;
+};
+
+/**
+ * 网格段中一段连续顶点的更新数据，只包含位置、法线、切线和颜色，UV在网格段创建后不变
+ */
+struct XRVISRUNTIME_API FXRVisChartMeshVertexUpdate
+{
+	/* 第一个更新的顶点在网格段中的序号 */
+	int32 FirstVertex = 0;
+
+	TArray<FVector3f> Positions;
+
+	/* 每个顶点依次为切线和法线，与顶点缓冲区的布局一致 */
+	TArray<FPackedNormal> TangentBasis;
+
+	TArray<FColor> Colors;
+
+	void Init(int32 InFirstVertex, int32 NumVertices);
+
+	/* 写入第Index个更新的顶点，Index从0开始 */
+	void SetVertex(int32 Index, const FVector3f& Position, const FVector3f& Normal, const FVector3f& Tangent, const FColor& Color);
+
+	int32 Num() const { return Positions.Num(); }
+};
+
+/**
+ * 图表专用的网格组件，代替UProceduralMeshComponent渲染图表的网格段
+ * 网格段的渲染资源独立于场景代理保存，修改材质等操作重建代理时不会重新上传顶点
+ * 创建网格段只把资源交给渲染线程，不重建渲染状态；更新时只锁定并写入修改的顶点范围
+ * 碰撞由有碰撞网格段的三角形构建（复杂碰撞作为简单碰撞），射线命中的是图元表面，每帧最多重建一次
+ */
+UCLASS(ClassGroup = Rendering, meta = (BlueprintSpawnableComponent))
+class XRVISRUNTIME_API UXRVisChartMeshComponent : public UMeshComponent, public IInterface_CollisionDataProvider
+{
+	GENERATED_BODY()
+
+public:
+	UXRVisChartMeshComponent(const FObjectInitializer& ObjectInitializer);
+
+	/** 创建或替换网格段，数据的所有权转移给组件 - 注意：此方法不暴露给蓝图 */
+	void CreateSection(int32 SectionIndex, TUniquePtr<FXRVisChartMeshSectionData> Data, bool bCreateCollision);
+
+	/** 更新网格段中一段连续顶点，顶点数量必须在网格段范围内 - 注意：此方法不暴露给蓝图 */
+	void UpdateSectionVertices(int32 SectionIndex, FXRVisChartMeshVertexUpdate&& Update);
+
+	/** 清除网格段 */
+	UFUNCTION(BlueprintCallable, Category = "Components|XRVisChartMesh")
+	void ClearSection(int32 SectionIndex);
+
+	/** 清除所有网格段 */
+	UFUNCTION(BlueprintCallable, Category = "Components|XRVisChartMesh")
+	void ClearAllSections();
+
+	/** 显示或隐藏网格段，隐藏的网格段保留碰撞 */
+	UFUNCTION(BlueprintCallable, Category = "Components|XRVisChartMesh")
+	void SetSectionVisible(int32 SectionIndex, bool bNewVisibility);
+
+	/** 网格段数量，包括已清除的网格段 */
+	UFUNCTION(BlueprintCallable, Category = "Components|XRVisChartMesh")
+	int32 GetNumSections() const { return Sections.Num(); }
+
+	virtual FPrimitiveSceneProxy* CreateSceneProxy() override;
+	virtual UBodySetup* GetBodySetup() override;
+	virtual int32 GetNumMaterials() const override;
+	virtual FBoxSphereBounds CalcBounds(const FTransform& LocalToWorld) const override;
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void BeginDestroy() override;
+
+	//~ Begin Interface_CollisionDataProvider Interface
+	virtual bool GetPhysicsTriMeshData(struct FTriMeshCollisionData* CollisionData, bool InUseAllTriData) override;
+	virtual bool ContainsPhysicsTriMeshData(bool InUseAllTriData) const override;
+	virtual bool WantsNegXTriMesh() override { return false; }
+	//~ End Interface_CollisionDataProvider Interface
+
+private:
+	friend class FXRVisChartMeshSceneProxy;
+
+	/* 游戏线程上保存的网格段信息，法线、UV和颜色只存在于渲染资源中 */
+	struct FSectionInfo
+	{
+		FBox3f LocalBox = FBox3f(ForceInit);
+
+		/* 顶点位置，用于更新后重新计算包围盒和构建碰撞 */
+		TArray<FVector3f> Positions;
+
+		/* 三角形索引，只有创建碰撞的网格段保留 */
+		TArray<uint32> Indices;
+
+		bool bValid = false;
+		bool bCreateCollision = false;
+
+		int32 NumVertices() const { return Positions.Num(); }
+	};
+
+	/* 重新计算所有网格段的包围盒并通知渲染线程 */
+	void UpdateLocalBounds();
+
+	/* 标记碰撞需要重建，在下一次Tick中处理 */
+	void MarkCollisionDirty();
+
+	/* 用有碰撞的网格段的三角形重建碰撞 */
+	void UpdateCollision();
+
+	TArray<FSectionInfo> Sections;
+
+	FBox3f LocalBounds = FBox3f(ForceInit);
+
+	/* 渲染线程使用的网格段资源，场景代理和组件共同持有，最后一个引用在渲染线程上释放 */
+	TSharedPtr<FXRVisChartMeshRenderData, ESPMode::ThreadSafe> RenderData;
+
+	/* 当前场景代理创建时的网格段数量，新增网格段后需要重建代理以获取材质 */
+	int32 NumProxySections = 0;
+
+	bool bCollisionDirty = false;
+
+	UPROPERTY(Transient)
+	UBodySetup* BodySetup = nullptr;
+};
@@ -32,6 +32,7 @@ public class XRVisRuntime : ModuleRules
                 "RHI",
                 "Projects", 
                 "ProceduralMeshComponent",
+                "PhysicsCore",
             }
         );
 